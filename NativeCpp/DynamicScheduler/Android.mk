@@ -16,14 +16,30 @@ endif
 
 SNPE_INCLUDE_DIR := $(SNPE_ROOT)/include/SNPE
 
+include $(CLEAR_VARS)
+LOCAL_MODULE := libdsched
+LOCAL_SRC_FILES := Scheduler.cpp LoadContainer.cpp LoadInputTensor.cpp SetBuilderOptions.cpp Util.cpp CreateUserBuffer.cpp PreprocessInput.cpp YuvPreprocess.cpp UserBufferArena.cpp
+LOCAL_CFLAGS := -DENABLE_GL_BUFFER
+LOCAL_EXPORT_C_INCLUDES := $(LOCAL_PATH)
+LOCAL_SHARED_LIBRARIES := libSNPE
+include $(BUILD_STATIC_LIBRARY)
+
 include $(CLEAR_VARS)
 LOCAL_MODULE := snpe-sample
-LOCAL_SRC_FILES := main.cpp CheckRuntime.cpp LoadContainer.cpp LoadUDOPackage.cpp LoadInputTensor.cpp SetBuilderOptions.cpp Util.cpp NV21Load.cpp CreateUserBuffer.cpp PreprocessInput.cpp SaveOutputTensor.cpp CreateGLBuffer.cpp CreateGLContext.cpp
+LOCAL_SRC_FILES := main.cpp CheckRuntime.cpp LoadUDOPackage.cpp NV21Load.cpp SaveOutputTensor.cpp CreateGLBuffer.cpp CreateGLContext.cpp StaticAssign.cpp Topology.cpp RealTime.cpp Arrivals.cpp Daemon.cpp
 LOCAL_CFLAGS := -DENABLE_GL_BUFFER
+LOCAL_STATIC_LIBRARIES := libdsched
 LOCAL_SHARED_LIBRARIES := libSNPE
 LOCAL_LDLIBS     := -lGLESv2 -lEGL
 include $(BUILD_EXECUTABLE)
 
+# load-test client of the daemon (-D); socket only, no SNPE
+include $(CLEAR_VARS)
+LOCAL_MODULE := dsched-loadtest
+LOCAL_SRC_FILES := loadtest/LoadTest.cpp DaemonClient.cpp Arrivals.cpp
+LOCAL_C_INCLUDES := $(LOCAL_PATH)
+include $(BUILD_EXECUTABLE)
+
 include $(CLEAR_VARS)
 LOCAL_MODULE := libSNPE
 LOCAL_SRC_FILES := $(SNPE_LIB_DIR)/libSNPE.so
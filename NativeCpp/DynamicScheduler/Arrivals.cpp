@@ -0,0 +1,127 @@
+// Arrivals.cpp – arrival processes and trace files for the scheduler load generator
+#include "Arrivals.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+bool parseArrivalModel(const std::string& spec, ArrivalModel& out)
+{
+    std::vector<std::string> f;
+    std::stringstream ss(spec);
+    for(std::string s; std::getline(ss, s, ':'); ) f.push_back(s);
+    if(f.empty()) return false;
+
+    ArrivalModel m;
+    char* end = nullptr;
+    auto num = [&](const std::string& s, double& v){ v = std::strtod(s.c_str(), &end);
+                                                     return !s.empty() && *end == '\0'; };
+    if(f[0] == "periodic" && f.size() == 1)      m.kind = ArrivalKind::PERIODIC;
+    else if(f[0] == "poisson" && f.size() == 1)  m.kind = ArrivalKind::POISSON;
+    else if(f[0] == "jitter" && f.size() <= 2){
+        m.kind = ArrivalKind::JITTER;
+        if(f.size() == 2 && (!num(f[1], m.jitter) || m.jitter < 0.0 || m.jitter > 1.0)) return false;
+    }
+    else if(f[0] == "bursty" && (f.size() == 1 || f.size() == 3)){
+        m.kind = ArrivalKind::BURSTY;
+        if(f.size() == 3 && (!num(f[1], m.onMs) || !num(f[2], m.offMs) || m.onMs <= 0.0 || m.offMs < 0.0))
+            return false;
+    }
+    else return false;
+    out = m;
+    return true;
+}
+
+std::string arrivalModelName(const ArrivalModel& m)
+{
+    std::ostringstream o;
+    switch(m.kind){
+        case ArrivalKind::PERIODIC: o<<"periodic";                          break;
+        case ArrivalKind::JITTER:   o<<"jitter:"<<m.jitter;                 break;
+        case ArrivalKind::POISSON:  o<<"poisson";                           break;
+        case ArrivalKind::BURSTY:   o<<"bursty:"<<m.onMs<<':'<<m.offMs;     break;
+    }
+    return o.str();
+}
+
+static void arrivalsOf(const ArrivalSource& s, int idx, const ArrivalModel& m, double durS,
+                       std::mt19937_64& g, std::vector<Arrival>& out)
+{
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+    auto emit = [&](double t){ if(t >= 0.0 && t < durS) out.push_back({t, idx, float(U(g))}); };
+    if(s.rateHz <= 0.0) return;
+    const double per = 1.0/s.rateHz;
+
+    switch(m.kind){
+        case ArrivalKind::PERIODIC:
+        case ArrivalKind::JITTER:
+            for(double k = 0; k*per < durS; ++k){
+                double off = m.kind == ArrivalKind::JITTER ? (2.0*U(g)-1.0)*m.jitter*per : 0.0;
+                if(U(g) < s.prob) emit(std::max(0.0, k*per + off));   // an early first tick is clamped, not lost
+            }
+            break;
+        case ArrivalKind::POISSON:{
+            if(s.prob <= 0.0) break;
+            std::exponential_distribution<double> gap(s.rateHz*s.prob);
+            for(double t = gap(g); t < durS; t += gap(g)) emit(t);
+        } break;
+        case ArrivalKind::BURSTY:{
+            if(s.prob <= 0.0) break;
+            const double on = m.onMs/1e3, off = m.offMs/1e3;
+            std::exponential_distribution<double> gap(s.rateHz*s.prob*(on+off)/on);
+            std::exponential_distribution<double> onLen(1.0/on);
+            std::exponential_distribution<double> offLen(off > 0.0 ? 1.0/off : 1.0);
+            bool isOn = U(g) < on/(on+off);              // stationary start state
+            for(double t = 0.0; t < durS; isOn = !isOn){
+                double until = t + (isOn ? onLen(g) : (off > 0.0 ? offLen(g) : 0.0));
+                if(isOn) for(double a = t + gap(g); a < until; a += gap(g)) emit(a);
+                t = until;
+            }
+        } break;
+    }
+}
+
+std::vector<Arrival> makeArrivals(const std::vector<ArrivalSource>& src, const ArrivalModel& m,
+                                  double durS, uint64_t seed)
+{
+    std::vector<Arrival> out;
+    for(size_t i = 0; i < src.size(); ++i){
+        std::seed_seq sq{ uint32_t(seed), uint32_t(seed>>32), uint32_t(i) };
+        std::mt19937_64 g(sq);
+        arrivalsOf(src[i], int(i), m, durS, g, out);
+    }
+    std::stable_sort(out.begin(), out.end(), [](const Arrival& a, const Arrival& b){ return a.t < b.t; });
+    return out;
+}
+
+void writeTrace(std::ostream& out, const std::string& key, const std::vector<Arrival>& a)
+{
+    auto prec = out.precision(9);
+    for(const auto& x : a) out<<key<<','<<x.t<<','<<x.model<<','<<x.u<<'\n';
+    out.precision(prec);
+}
+
+bool readTraces(const std::string& path, std::map<std::string, std::vector<Arrival>>& out)
+{
+    std::ifstream in(path);
+    if(!in) return false;
+    std::string line;
+    for(size_t n = 1; std::getline(in, line); ++n){
+        if(line.empty() || line[0] == '#' || line.compare(0, 4, "key,") == 0) continue;
+        std::stringstream ss(line);
+        std::string key, t, mi, u;
+        if(!std::getline(ss, key, ',') || !std::getline(ss, t, ',') ||
+           !std::getline(ss, mi, ',')  || !std::getline(ss, u)){
+            std::cerr<<path<<':'<<n<<": expected key,t_s,model,u\n";
+            return false;
+        }
+        out[key].push_back({ std::atof(t.c_str()), std::atoi(mi.c_str()), float(std::atof(u.c_str())) });
+    }
+    for(auto& kv : out)
+        std::stable_sort(kv.second.begin(), kv.second.end(),
+                         [](const Arrival& a, const Arrival& b){ return a.t < b.t; });
+    return true;
+}
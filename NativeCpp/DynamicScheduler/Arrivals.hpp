@@ -0,0 +1,42 @@
+// Arrivals.hpp – arrival processes and trace files for the scheduler load generator
+#ifndef ARRIVALS_H
+#define ARRIVALS_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+enum class ArrivalKind { PERIODIC, JITTER, POISSON, BURSTY };
+
+struct ArrivalModel {
+    ArrivalKind kind   = ArrivalKind::PERIODIC;
+    double      jitter = 0.1;      // JITTER: uniform offset of ± jitter·period around each tick, clamped at 0
+    double      onMs   = 500.0;    // BURSTY: mean ON / OFF durations (exponential); the mean
+    double      offMs  = 500.0;    //         rate is kept, so ON runs at rate·(on+off)/on
+};
+
+struct ArrivalSource { double rateHz; double prob; };   // nominal rate, kept fraction
+
+struct Arrival {
+    double t;        // seconds since the start of the run
+    int    model;    // index into the scenario
+    float  u;        // uniform [0,1) draw: released while u < the model's current rate
+};
+
+// "periodic" | "jitter[:FRAC]" | "poisson" | "bursty[:ON_MS:OFF_MS]"
+bool        parseArrivalModel(const std::string& spec, ArrivalModel& out);
+std::string arrivalModelName(const ArrivalModel& m);
+
+// Arrivals of all sources in [0, durS), sorted by time. Every source draws from its own
+// generator seeded by (seed, index), so the sequence depends only on these arguments.
+// PERIODIC and JITTER thin their ticks by prob, POISSON and BURSTY scale the rate by it.
+std::vector<Arrival> makeArrivals(const std::vector<ArrivalSource>& src, const ArrivalModel& m,
+                                  double durS, uint64_t seed);
+
+// Trace files hold "key,t_s,model,u" lines; key names the sweep point (scenario@scale).
+void writeTrace(std::ostream& out, const std::string& key, const std::vector<Arrival>& a);
+bool readTraces(const std::string& path, std::map<std::string, std::vector<Arrival>>& out);
+
+#endif // ARRIVALS_H
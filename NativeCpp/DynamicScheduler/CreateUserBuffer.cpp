@@ -25,13 +25,14 @@
 #include "DlSystem/UserBufferMap.hpp"
 
 void createUserBuffer(zdl::DlSystem::UserBufferMap& userBufferMap,
-                      std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                      std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                       std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
                       std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                       const char * name,
                       const bool isTfNBuffer,
                       bool staticQuantization,
-                      int bitWidth)
+                      int bitWidth,
+                      UserBufferArena* arena)
 {
    // get attributes of buffer by name
    auto bufferAttributesOpt = snpe->getInputOutputBufferAttributes(name);
@@ -83,7 +84,10 @@ void createUserBuffer(zdl::DlSystem::UserBufferMap& userBufferMap,
    }
 
    // create user-backed storage to load input data onto it
-   applicationBuffers.emplace(name, std::vector<uint8_t>(bufSize));
+   ApplicationBuffer storage{ArenaAllocator<uint8_t>(arena)};
+   storage.resize(bufSize);
+   if (arena) arena->record(name, storage.data(), bufSize);
+   applicationBuffers.emplace(name, std::move(storage));
 
    // create SNPE user buffer from the user-backed buffer
    zdl::DlSystem::IUserBufferFactory& ubFactory = zdl::SNPE::SNPEFactory::getUserBufferFactory();
@@ -100,12 +104,13 @@ void createUserBuffer(zdl::DlSystem::UserBufferMap& userBufferMap,
 }
 
 void createInputBufferMap(zdl::DlSystem::UserBufferMap& inputMap,
-                          std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                          std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                           std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
                           std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                           bool isTfNBuffer,
                           bool staticQuantization,
-                          int bitWidth)
+                          int bitWidth,
+                          UserBufferArena* arena)
 {
    // get input tensor names of the network that need to be populated
    const auto& inputNamesOpt = snpe->getInputTensorNames();
@@ -115,16 +120,17 @@ void createInputBufferMap(zdl::DlSystem::UserBufferMap& inputMap,
 
    // create SNPE user buffers for each application storage buffer
    for (const char *name : inputNames) {
-      createUserBuffer(inputMap, applicationBuffers, snpeUserBackedBuffers, snpe, name, isTfNBuffer, staticQuantization, bitWidth);
+      createUserBuffer(inputMap, applicationBuffers, snpeUserBackedBuffers, snpe, name, isTfNBuffer, staticQuantization, bitWidth, arena);
    }
 }
 
 void createOutputBufferMap(zdl::DlSystem::UserBufferMap& outputMap,
-                           std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                           std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                            std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
                            std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                            bool isTfNBuffer,
-                           int bitWidth)
+                           int bitWidth,
+                           UserBufferArena* arena)
 {
    // get input tensor names of the network that need to be populated
    const auto& outputNamesOpt = snpe->getOutputTensorNames();
@@ -133,10 +139,35 @@ void createOutputBufferMap(zdl::DlSystem::UserBufferMap& outputMap,
 
    // create SNPE user buffers for each application storage buffer
    for (const char *name : outputNames) {
-      createUserBuffer(outputMap, applicationBuffers, snpeUserBackedBuffers, snpe, name, isTfNBuffer, false, bitWidth);
+      createUserBuffer(outputMap, applicationBuffers, snpeUserBackedBuffers, snpe, name, isTfNBuffer, false, bitWidth, arena);
    }
 }
 
+size_t userBufferArenaBytes(std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                            bool isTfNBuffer,
+                            int bitWidth,
+                            size_t sets)
+{
+   const auto& inputNamesOpt = snpe->getInputTensorNames();
+   const auto& outputNamesOpt = snpe->getOutputTensorNames();
+   if (!inputNamesOpt || !outputNamesOpt) throw std::runtime_error("Error obtaining tensor names");
+
+   // the sizes createUserBuffer allocates, in the order the buffer maps allocate them
+   const size_t elementSize = isTfNBuffer ? bitWidth / 8 : sizeof(float);
+   std::vector<size_t> sizes;
+   for (size_t set = 0; set < sets; set++) {
+      for (const zdl::DlSystem::StringList* names : {&*inputNamesOpt, &*outputNamesOpt}) {
+         for (const char *name : *names) {
+            auto bufferAttributesOpt = snpe->getInputOutputBufferAttributes(name);
+            if (!bufferAttributesOpt) throw std::runtime_error(std::string("Error obtaining attributes for tensor ") + name);
+            const zdl::DlSystem::TensorShape& bufferShape = (*bufferAttributesOpt)->getDims();
+            sizes.push_back(calcSizeFromDims(bufferShape.getDimensions(), bufferShape.rank(), elementSize));
+         }
+      }
+   }
+   return UserBufferArena::bytesFor(sizes);
+}
+
 void createUserBuffer(zdl::DlSystem::UserBufferMap& userBufferMap,
                       std::unordered_map<std::string, GLuint>& applicationBuffers,
                       std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
@@ -0,0 +1,317 @@
+// Daemon.cpp – serve the scheduler to local processes over a UNIX domain socket
+#include "Daemon.hpp"
+#include "DaemonProtocol.hpp"
+#include "Scheduler.hpp"
+#include "ShmRing.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <thread>
+
+#include <linux/memfd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using dsched::Clock;
+
+namespace {
+
+// Replies go through a queue drained by a writer thread per client, so a client that
+// reads slowly never blocks the runtime worker that completes its request.
+struct Out  { MsgType type; std::vector<char> fix; std::vector<float> data; int fd; };   // fd: passed, then closed
+struct Conn {
+    int fd; unsigned id;
+    std::mutex m; std::condition_variable cv;
+    std::deque<Out> out; bool closing = false;               // under m
+    std::atomic<bool> gone{false};                           // reader and writer finished
+    std::atomic<uint64_t> reqs{0}, late{0}, failed{0};
+    Conn(int f, unsigned i) : fd(f), id(i) {}
+    ~Conn(){ ::close(fd); }
+    template<class T> void post(MsgType t, const T& fix, std::vector<float> data = std::vector<float>(), int pass = -1){
+        const char* p = reinterpret_cast<const char*>(&fix);
+        { std::lock_guard<std::mutex> lk(m);
+          if(closing){ if(pass >= 0) ::close(pass); return; }
+          out.push_back({ t, std::vector<char>(p, p+sizeof fix), std::move(data), pass }); }
+        cv.notify_one();
+    }
+};
+
+inline int64_t nsOf(Clock::time_point t){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count(); }
+inline Clock::time_point tpOf(int64_t ns){
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns))); }
+
+bool readAll(int fd, void* p, size_t n)
+{
+    char* c = static_cast<char*>(p);
+    while(n){
+        ssize_t r = ::read(fd, c, n);
+        if(r < 0 && errno == EINTR) continue;
+        if(r <= 0) return false;
+        c += r; n -= size_t(r);
+    }
+    return true;
+}
+
+// header + fixed part + float payload in as few syscalls as the socket allows
+bool sendMsg(int fd, const Out& o)
+{
+    const size_t dataLen = o.data.size()*sizeof(float);
+    MsgHeader h{ kDaemonMagic, kDaemonVersion, uint16_t(o.type), uint32_t(o.fix.size() + dataLen) };
+    iovec v[3] = { { &h, sizeof h }, { const_cast<char*>(o.fix.data()), o.fix.size() },
+                   { const_cast<float*>(o.data.data()), dataLen } };
+    int cnt = dataLen ? 3 : 2, i = 0;
+    union { cmsghdr h; char b[CMSG_SPACE(sizeof(int))]; } ctl;
+    while(i < cnt){
+        msghdr m{}; m.msg_iov = v + i; m.msg_iovlen = size_t(cnt - i);
+        if(o.fd >= 0 && i == 0 && v[0].iov_len == sizeof h){     // with the first byte only
+            std::memset(&ctl, 0, sizeof ctl);
+            m.msg_control = ctl.b; m.msg_controllen = sizeof ctl.b;
+            cmsghdr* c = CMSG_FIRSTHDR(&m);
+            c->cmsg_level = SOL_SOCKET; c->cmsg_type = SCM_RIGHTS; c->cmsg_len = CMSG_LEN(sizeof(int));
+            std::memcpy(CMSG_DATA(c), &o.fd, sizeof(int));
+        }
+        ssize_t w = ::sendmsg(fd, &m, MSG_NOSIGNAL);
+        if(w < 0 && errno == EINTR) continue;
+        if(w <= 0) return false;
+        size_t left = size_t(w);
+        while(i < cnt && left >= v[i].iov_len){ left -= v[i].iov_len; ++i; }
+        if(i < cnt){ v[i].iov_base = static_cast<char*>(v[i].iov_base) + left; v[i].iov_len -= left; }
+    }
+    return true;
+}
+
+void writer(std::shared_ptr<Conn> c)
+{
+    for(bool ok = true;;){
+        Out o;
+        { std::unique_lock<std::mutex> lk(c->m);
+          c->cv.wait(lk, [&]{ return c->closing || !c->out.empty(); });
+          if(c->out.empty()) return;
+          o = std::move(c->out.front()); c->out.pop_front(); }
+        ok = ok && sendMsg(c->fd, o);                        // after an error just drain
+        if(o.fd >= 0) ::close(o.fd);
+    }
+}
+
+void reply(Conn& c, const InferReq& rq, dsched::Result& r)
+{
+    InferRep rep{ rq.id, int32_t(r.status == dsched::Status::OK ? DaemonStatus::OK :
+                                 r.status == dsched::Status::CANCELLED ? DaemonStatus::CANCELLED : DaemonStatus::FAILED),
+                  int32_t(r.runtime), r.top1, 0, nsOf(r.started), nsOf(r.finished), nsOf(r.completed) };
+    c.reqs++;
+    if(r.status != dsched::Status::OK) c.failed++;
+    else if(r.late()) c.late++;
+    if(!rq.wantOutput || r.status != dsched::Status::OK){ c.post(MsgType::RESULT, rep); return; }
+    rep.count = uint32_t(r.output.size());
+    c.post(MsgType::RESULT, rep, std::move(r.output));
+}
+void reject(Conn& c, const InferReq& rq)
+{
+    InferRep rep{ rq.id, int32_t(DaemonStatus::BAD_REQUEST), -1, -1, 0, 0, 0, nsOf(Clock::now()) };
+    c.reqs++; c.failed++;
+    c.post(MsgType::RESULT, rep);
+}
+
+/* shared‑memory ring of one ATTACH ------------------------------------------------ */
+// The region stays mapped and its slots bound until the last completion has been
+// posted; completions of all runtimes are serialised by comM (single producer ring).
+struct Ring {
+    RingLayout* L = nullptr; size_t bytes = 0; int model = -1;
+    // the geometry as made here: the header is in the client's mapping too, so the
+    // daemon never derives an address from it
+    uint32_t slots = 0, frameFloats = 0; size_t frameBytes = 0, framesOffset = 0;
+    std::vector<float*> frame;                      // [slot]
+    std::vector<const float*> bound;
+    std::mutex comM;
+    std::atomic<bool> stop{false};
+    std::atomic<int>  pending{0};
+    ~Ring(){
+        for(const float* p : bound) dsched::unbindInput(model, p);
+        if(L) ::munmap(L, bytes);
+    }
+};
+
+// memfd of `slots` frames for model, mapped here; returns the fd to pass, or -1
+int makeRing(Ring& r, int model, uint32_t slots)
+{
+    const size_t n = dsched::inputSize(model);
+    r.bytes = ringBytes(slots, n);
+    int fd = int(::syscall(SYS_memfd_create, "dsched-ring", MFD_CLOEXEC));
+    if(fd < 0) return -1;
+    void* p = MAP_FAILED;
+    if(::ftruncate(fd, off_t(r.bytes)) == 0)
+        p = ::mmap(nullptr, r.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(p == MAP_FAILED){ ::close(fd); return -1; }
+    r.L = new (p) RingLayout();
+    r.slots = slots; r.frameFloats = uint32_t(n);
+    r.frameBytes = ringPageAlign(n*sizeof(float)); r.framesOffset = ringPageAlign(sizeof(RingLayout));
+    r.L->magic = kRingMagic; r.L->slots = r.slots; r.L->frameFloats = r.frameFloats;
+    r.L->frameBytes = r.frameBytes; r.L->framesOffset = r.framesOffset;
+    r.model = model;
+    for(uint32_t k = 0; k < slots; ++k)
+        r.frame.push_back(reinterpret_cast<float*>(static_cast<char*>(p) + r.framesOffset + k*r.frameBytes));
+    for(float* f : r.frame)                         // serial mode: frames are copied from the slots
+        if(dsched::bindInput(model, f, n)) r.bound.push_back(f);
+    return fd;
+}
+
+void ringComplete(Ring& r, Conn& c, const RingSub& e, const dsched::Result& res)
+{
+    RingCom ce{ e.seq, e.slot, int32_t(res.status == dsched::Status::OK ? DaemonStatus::OK :
+                                       res.status == dsched::Status::CANCELLED ? DaemonStatus::CANCELLED : DaemonStatus::FAILED),
+                int32_t(res.runtime), res.top1, uint64_t(res.stagedBytes),
+                nsOf(res.started), nsOf(res.finished), nsOf(res.completed) };
+    c.reqs++;
+    if(res.status != dsched::Status::OK) c.failed++;
+    else if(res.late()) c.late++;
+    { std::lock_guard<std::mutex> lk(r.comM); ringPush(r.L->com, r.L->comq, ce); }
+    r.pending--;
+}
+
+// drains the submission ring until the connection ends
+void ringLoop(std::shared_ptr<Ring> r, std::shared_ptr<Conn> c)
+{
+    for(RingSub e; !r->stop; ){
+        if(!ringPop(r->L->sub, r->L->subq, e, 100)) continue;
+        if(e.slot >= r->slots){
+            RingCom ce{ e.seq, e.slot, int32_t(DaemonStatus::BAD_REQUEST), -1, -1, 0, 0, 0, nsOf(Clock::now()) };
+            c->reqs++; c->failed++;
+            std::lock_guard<std::mutex> lk(r->comM); ringPush(r->L->com, r->L->comq, ce);
+            continue;
+        }
+        dsched::InputView v;
+        v.data = r->frame[e.slot]; v.count = r->frameFloats;
+        r->pending++;
+        dsched::submit(r->model, v, tpOf(e.deadlineNs),
+                       [r, c, e](dsched::Result&& res){ ringComplete(*r, *c, e, res); },
+                       tpOf(e.releasedNs), e.priority);
+    }
+}
+
+/* one client: read requests until EOF or a malformed message ---------------------- */
+void serve(std::shared_ptr<Conn> c, const std::vector<DaemonModel>& models, const std::set<int>& ids)
+{
+    std::thread w(writer, c);
+    std::vector<std::pair<std::shared_ptr<Ring>, std::thread>> rings;
+    for(MsgHeader h; readAll(c->fd, &h, sizeof h); ){
+        if(h.magic != kDaemonMagic || h.version != kDaemonVersion || h.length > kMaxPayload) break;
+        if(MsgType(h.type) == MsgType::OPEN){
+            OpenReq rq;
+            if(h.length < sizeof rq || !readAll(c->fd, &rq, sizeof rq)) break;
+            std::string name(h.length - sizeof rq, '\0');
+            if(!readAll(c->fd, &name[0], name.size())) break;
+            auto it = std::find_if(models.begin(), models.end(), [&](const DaemonModel& m){ return m.name == name; });
+            OpenRep rep{ rq.id, it == models.end() ? -1 : it->id,
+                         it == models.end() ? 0u : uint32_t(dsched::inputSize(it->id)) };
+            c->post(MsgType::OPENED, rep);
+        }
+        else if(MsgType(h.type) == MsgType::INFER){
+            InferReq rq;
+            if(h.length < sizeof rq || !readAll(c->fd, &rq, sizeof rq)) break;
+            if(h.length != sizeof rq + size_t(rq.count)*sizeof(float)) break;
+            auto in = std::make_shared<std::vector<float>>(rq.count);   // lives until the completion
+            if(rq.count && !readAll(c->fd, in->data(), rq.count*sizeof(float))) break;
+            if(!ids.count(rq.model) || (rq.count && rq.count != dsched::inputSize(rq.model))){
+                reject(*c, rq); continue; }
+            dsched::InputView v;
+            if(rq.count){ v.data = in->data(); v.count = in->size(); }
+            dsched::submit(rq.model, v, tpOf(rq.deadlineNs),
+                           [c, in, rq](dsched::Result&& r){ reply(*c, rq, r); },
+                           tpOf(rq.releasedNs), rq.priority);
+        }
+        else if(MsgType(h.type) == MsgType::ATTACH){
+            AttachReq rq;
+            if(h.length != sizeof rq || !readAll(c->fd, &rq, sizeof rq)) break;
+            AttachRep rep{ rq.id, int32_t(DaemonStatus::BAD_REQUEST), 0, 0 };
+            int fd = -1;
+            if(ids.count(rq.model) && dsched::inputSize(rq.model)){
+                auto r = std::make_shared<Ring>();
+                const uint32_t slots = std::max(1u, std::min(rq.slots, kMaxRingSlots));
+                fd = makeRing(*r, rq.model, slots);
+                if(fd >= 0){
+                    rep.status = int32_t(DaemonStatus::OK); rep.slots = slots; rep.bytes = r->bytes;
+                    std::cout<<"client "<<c->id<<" attached a ring of "<<slots<<" slots, "
+                             <<(r->bound.size() == slots ? "zero‑copy" : "copied")<<"\n";
+                    rings.emplace_back(r, std::thread(ringLoop, r, c));
+                }
+                else rep.status = int32_t(DaemonStatus::FAILED);
+            }
+            c->post(MsgType::ATTACHED, rep, std::vector<float>(), fd);
+        }
+        else break;
+    }
+    for(auto& r : rings){ r.first->stop = true; r.second.join(); }
+    for(auto& r : rings)                                    // slots stay mapped until then
+        while(r.first->pending > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    rings.clear();
+    { std::lock_guard<std::mutex> lk(c->m); c->closing = true; }   // later completions are dropped
+    c->cv.notify_one();
+    w.join();
+    c->gone = true;
+}
+
+} // namespace
+
+bool runDaemon(const std::string& path, const std::vector<DaemonModel>& models, const std::atomic<bool>& stop)
+{
+    sockaddr_un addr{}; addr.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof addr.sun_path){ std::cerr<<"socket path too long: "<<path<<"\n"; return false; }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof addr.sun_path - 1);
+
+    int lfd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(lfd < 0){ std::cerr<<"socket: "<<std::strerror(errno)<<"\n"; return false; }
+    ::unlink(path.c_str());
+    if(::bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0 || ::chmod(path.c_str(), 0660) < 0 ||
+       ::listen(lfd, 16) < 0){
+        std::cerr<<path<<": "<<std::strerror(errno)<<"\n"; ::close(lfd); return false; }
+
+    std::set<int> ids;
+    std::cout<<"Serving";
+    for(const auto& m : models) if(m.id >= 0){ ids.insert(m.id); std::cout<<' '<<m.name; }
+    std::cout<<" on "<<path<<"\n";
+
+    struct Client { std::thread t; std::shared_ptr<Conn> c; };
+    std::list<Client> clients;
+    unsigned next = 0;
+    auto reap = [&](bool all){
+        for(auto it = clients.begin(); it != clients.end(); ){
+            if(all) ::shutdown(it->c->fd, SHUT_RDWR);
+            if(!all && !it->c->gone){ ++it; continue; }
+            it->t.join();
+            std::cout<<"client "<<it->c->id<<" gone: "<<it->c->reqs<<" requests, "<<it->c->late<<" late, "
+                     <<it->c->failed<<" failed\n";
+            it = clients.erase(it);
+        }
+    };
+    while(!stop){
+        pollfd p{ lfd, POLLIN, 0 };
+        if(::poll(&p, 1, 200) > 0 && (p.revents & POLLIN)){
+            int fd = ::accept4(lfd, nullptr, nullptr, SOCK_CLOEXEC);
+            if(fd >= 0){
+                auto c = std::make_shared<Conn>(fd, next++);
+                std::cout<<"client "<<c->id<<" connected\n";
+                clients.push_back({ std::thread(serve, c, std::cref(models), std::cref(ids)), c });
+            }
+        }
+        reap(false);
+    }
+    ::close(lfd);
+    ::unlink(path.c_str());
+    reap(true);
+    return true;
+}
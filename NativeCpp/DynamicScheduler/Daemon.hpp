@@ -0,0 +1,21 @@
+// Daemon.hpp – serve the scheduler to local processes over a UNIX domain socket
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+struct DaemonModel { std::string name; int id; };   // name clients open → dsched model id
+
+// Listens on path (mode 0660, replacing a stale socket) until stop is set. Every client
+// gets a reader thread: OPEN is answered from models, INFER goes to dsched::submit with
+// the client's deadline and priority, so requests of all clients share the runtime
+// queues, and the result is written back from the completion callback. ATTACH maps a
+// shared‑memory frame ring (ShmRing.hpp) whose slots are bound as model inputs and
+// drained by a thread of its own. The service must be started. Returns false if the
+// socket cannot be set up.
+bool runDaemon(const std::string& path, const std::vector<DaemonModel>& models,
+               const std::atomic<bool>& stop);
+
+#endif // DAEMON_H
@@ -0,0 +1,246 @@
+// DaemonClient.cpp – client side of the scheduler daemon (-D)
+#include "DaemonClient.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+inline int64_t nsOf(std::chrono::steady_clock::time_point t){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count(); }
+
+} // namespace
+
+/* FrameRing ------------------------------------------------------------------------ */
+FrameRing::FrameRing(RingLayout* L, size_t bytes) : m_L(L), m_bytes(bytes), m_sent(L->slots)
+{
+    for(uint32_t k = 0; k < L->slots; ++k) m_free.push_back(k);
+}
+FrameRing::~FrameRing(){ ::munmap(m_L, m_bytes); }
+
+int FrameRing::acquire()
+{
+    std::lock_guard<std::mutex> lk(m_m);
+    if(m_free.empty()) return -1;
+    const uint32_t k = m_free.front(); m_free.pop_front();
+    return int(k);
+}
+
+void FrameRing::submit(uint32_t slot, std::chrono::microseconds deadline, int priority)
+{
+    const auto now = Clock::now();
+    RingSub e;
+    { std::lock_guard<std::mutex> lk(m_m);
+      e = RingSub{ ++m_seq, slot, priority, nsOf(now), nsOf(now + deadline) };
+      m_sent[slot] = e; }
+    ringPush(m_L->sub, m_L->subq, e);
+}
+
+bool FrameRing::next(DaemonReply& r, size_t* stagedBytes, std::chrono::milliseconds timeout)
+{
+    RingCom ce;
+    if(!ringPop(m_L->com, m_L->comq, ce, int(timeout.count()))) return false;
+    const int64_t now = nsOf(Clock::now());
+    r = DaemonReply();
+    r.status = DaemonStatus(ce.status); r.runtime = ce.runtime; r.top1 = ce.top1;
+    if(stagedBytes) *stagedBytes = size_t(ce.stagedBytes);
+    if(ce.slot >= m_L->slots) return true;
+    std::lock_guard<std::mutex> lk(m_m);
+    const RingSub& e = m_sent[ce.slot];
+    if(r.status == DaemonStatus::OK){
+        r.queueMs = (ce.startedNs  - e.releasedNs)*1e-6;
+        r.execMs  = (ce.finishedNs - ce.startedNs)*1e-6;
+    }
+    r.respMs = (now - e.releasedNs)*1e-6;
+    r.late   = now > e.deadlineNs;
+    m_free.push_back(ce.slot);
+    return true;
+}
+
+/* DaemonClient --------------------------------------------------------------------- */
+bool DaemonClient::connect(const std::string& path)
+{
+    close();
+    sockaddr_un addr{}; addr.sun_family = AF_UNIX;
+    if(path.empty() || path.size() >= sizeof addr.sun_path) return false;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof addr.sun_path - 1);
+    m_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(m_fd < 0) return false;
+    if(::connect(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0){ ::close(m_fd); m_fd = -1; return false; }
+    { std::lock_guard<std::mutex> lk(m_pending); m_closed = false; }
+    m_reader = std::thread(&DaemonClient::readLoop, this);
+    return true;
+}
+
+void DaemonClient::close()
+{
+    if(m_fd < 0) return;
+    ::shutdown(m_fd, SHUT_RDWR);
+    if(m_reader.joinable()) m_reader.join();
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+bool DaemonClient::send(MsgType t, const void* fix, size_t fixLen, const void* data, size_t dataLen)
+{
+    MsgHeader h{ kDaemonMagic, kDaemonVersion, uint16_t(t), uint32_t(fixLen + dataLen) };
+    iovec v[3] = { { &h, sizeof h }, { const_cast<void*>(fix), fixLen }, { const_cast<void*>(data), dataLen } };
+    int cnt = dataLen ? 3 : 2, i = 0;
+    std::lock_guard<std::mutex> lk(m_write);
+    while(i < cnt){
+        msghdr m{}; m.msg_iov = v + i; m.msg_iovlen = size_t(cnt - i);
+        ssize_t w = ::sendmsg(m_fd, &m, MSG_NOSIGNAL);
+        if(w < 0 && errno == EINTR) continue;
+        if(w <= 0) return false;
+        size_t left = size_t(w);
+        while(i < cnt && left >= v[i].iov_len){ left -= v[i].iov_len; ++i; }
+        if(i < cnt){ v[i].iov_base = static_cast<char*>(v[i].iov_base) + left; v[i].iov_len -= left; }
+    }
+    return true;
+}
+
+int DaemonClient::open(const std::string& name, uint32_t* inputCount)
+{
+    OpenReq rq{ m_nextId++ };
+    std::future<OpenRep> f;
+    { std::lock_guard<std::mutex> lk(m_pending);
+      if(m_closed) return -1;
+      f = m_open[rq.id].get_future(); }
+    if(!send(MsgType::OPEN, &rq, sizeof rq, name.data(), name.size())){
+        std::lock_guard<std::mutex> lk(m_pending);
+        auto it = m_open.find(rq.id);
+        if(it != m_open.end()){ it->second.set_value(OpenRep{ rq.id, -1, 0 }); m_open.erase(it); }
+    }
+    OpenRep rep = f.get();
+    if(inputCount) *inputCount = rep.inputCount;
+    return rep.model;
+}
+
+std::unique_ptr<FrameRing> DaemonClient::attach(int model, uint32_t slots)
+{
+    AttachReq rq{ m_nextId++, model, slots };
+    std::future<std::pair<AttachRep,int>> f;
+    { std::lock_guard<std::mutex> lk(m_pending);
+      if(m_closed) return nullptr;
+      f = m_attach[rq.id].get_future(); }
+    if(!send(MsgType::ATTACH, &rq, sizeof rq, nullptr, 0)){
+        std::lock_guard<std::mutex> lk(m_pending);
+        auto it = m_attach.find(rq.id);
+        if(it != m_attach.end()){ it->second.set_value({ AttachRep{ rq.id, int32_t(DaemonStatus::FAILED), 0, 0 }, -1 });
+                                  m_attach.erase(it); }
+    }
+    const auto rep = f.get();
+    if(rep.second < 0) return nullptr;
+    void* p = MAP_FAILED;
+    if(rep.first.status == int32_t(DaemonStatus::OK))
+        p = ::mmap(nullptr, rep.first.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, rep.second, 0);
+    ::close(rep.second);                                     // the mapping keeps the region
+    if(p == MAP_FAILED) return nullptr;
+    RingLayout* L = static_cast<RingLayout*>(p);
+    if(L->magic != kRingMagic || L->slots != rep.first.slots){ ::munmap(p, rep.first.bytes); return nullptr; }
+    return std::unique_ptr<FrameRing>(new FrameRing(L, rep.first.bytes));
+}
+
+std::future<DaemonReply> DaemonClient::submit(int model, const float* data, uint32_t count,
+                                              std::chrono::microseconds deadline, int priority, bool wantOutput)
+{
+    const auto now = Clock::now();
+    InferReq rq{ m_nextId++, model, priority, nsOf(now), nsOf(now + deadline), wantOutput ? 1u : 0u, count };
+    std::promise<DaemonReply> p;
+    std::future<DaemonReply> f = p.get_future();
+    { std::lock_guard<std::mutex> lk(m_pending);
+      if(m_closed){ p.set_value(DaemonReply()); return f; }
+      m_infer.emplace(rq.id, std::move(p)); m_sent[rq.id] = rq; }
+    if(!send(MsgType::INFER, &rq, sizeof rq, data, size_t(count)*sizeof(float))){
+        std::lock_guard<std::mutex> lk(m_pending);
+        auto it = m_infer.find(rq.id);                       // unless the reader failed it already
+        if(it != m_infer.end()){ it->second.set_value(DaemonReply()); m_infer.erase(it); }
+        m_sent.erase(rq.id);
+    }
+    return f;
+}
+
+// recvmsg instead of read: a descriptor passed with ATTACHED would be dropped otherwise
+bool DaemonClient::recvAll(void* p, size_t n)
+{
+    char* c = static_cast<char*>(p);
+    while(n){
+        iovec v{ c, n };
+        union { cmsghdr h; char b[CMSG_SPACE(sizeof(int))]; } ctl;
+        msghdr m{}; m.msg_iov = &v; m.msg_iovlen = 1; m.msg_control = ctl.b; m.msg_controllen = sizeof ctl.b;
+        ssize_t r = ::recvmsg(m_fd, &m, MSG_CMSG_CLOEXEC);
+        if(r < 0 && errno == EINTR) continue;
+        if(r <= 0) return false;
+        for(cmsghdr* h = CMSG_FIRSTHDR(&m); h; h = CMSG_NXTHDR(&m, h))
+            if(h->cmsg_level == SOL_SOCKET && h->cmsg_type == SCM_RIGHTS){
+                if(m_passed >= 0) ::close(m_passed);
+                std::memcpy(&m_passed, CMSG_DATA(h), sizeof(int));
+            }
+        c += r; n -= size_t(r);
+    }
+    return true;
+}
+
+void DaemonClient::readLoop()
+{
+    for(MsgHeader h; recvAll(&h, sizeof h); ){
+        if(h.magic != kDaemonMagic || h.version != kDaemonVersion) break;
+        if(MsgType(h.type) == MsgType::OPENED && h.length == sizeof(OpenRep)){
+            OpenRep rep;
+            if(!recvAll(&rep, sizeof rep)) break;
+            std::lock_guard<std::mutex> lk(m_pending);
+            auto it = m_open.find(rep.id);
+            if(it != m_open.end()){ it->second.set_value(rep); m_open.erase(it); }
+        }
+        else if(MsgType(h.type) == MsgType::RESULT && h.length >= sizeof(InferRep)){
+            InferRep rep;
+            if(!recvAll(&rep, sizeof rep) || h.length != sizeof rep + size_t(rep.count)*sizeof(float)) break;
+            DaemonReply r;
+            r.output.resize(rep.count);
+            if(rep.count && !recvAll(r.output.data(), rep.count*sizeof(float))) break;
+            const int64_t now = nsOf(Clock::now());
+            r.status = DaemonStatus(rep.status); r.runtime = rep.runtime; r.top1 = rep.top1;
+            std::lock_guard<std::mutex> lk(m_pending);
+            auto s = m_sent.find(rep.id);
+            if(s != m_sent.end()){
+                if(r.status == DaemonStatus::OK){
+                    r.queueMs = (rep.startedNs  - s->second.releasedNs)*1e-6;
+                    r.execMs  = (rep.finishedNs - rep.startedNs)*1e-6;
+                }
+                r.respMs = (now - s->second.releasedNs)*1e-6;
+                r.late   = now > s->second.deadlineNs;
+                m_sent.erase(s);
+            }
+            auto it = m_infer.find(rep.id);
+            if(it != m_infer.end()){ it->second.set_value(std::move(r)); m_infer.erase(it); }
+        }
+        else if(MsgType(h.type) == MsgType::ATTACHED && h.length == sizeof(AttachRep)){
+            AttachRep rep;
+            if(!recvAll(&rep, sizeof rep)) break;
+            const int fd = m_passed; m_passed = -1;
+            std::lock_guard<std::mutex> lk(m_pending);
+            auto it = m_attach.find(rep.id);
+            if(it != m_attach.end()){ it->second.set_value({ rep, fd }); m_attach.erase(it); }
+            else if(fd >= 0) ::close(fd);
+        }
+        else break;
+    }
+    if(m_passed >= 0){ ::close(m_passed); m_passed = -1; }
+    failAll();
+}
+
+void DaemonClient::failAll()
+{
+    std::lock_guard<std::mutex> lk(m_pending);
+    m_closed = true;
+    for(auto& kv : m_infer) kv.second.set_value(DaemonReply());
+    for(auto& kv : m_open)  kv.second.set_value(OpenRep{ kv.first, -1, 0 });
+    for(auto& kv : m_attach) kv.second.set_value({ AttachRep{ kv.first, int32_t(DaemonStatus::FAILED), 0, 0 }, -1 });
+    m_infer.clear(); m_open.clear(); m_attach.clear(); m_sent.clear();
+}
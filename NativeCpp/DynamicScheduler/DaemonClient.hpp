@@ -0,0 +1,103 @@
+// DaemonClient.hpp – client side of the scheduler daemon (-D); needs neither SNPE nor
+//                    the scheduler, only the socket
+#ifndef DAEMONCLIENT_H
+#define DAEMONCLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "DaemonProtocol.hpp"
+#include "ShmRing.hpp"
+
+struct DaemonReply {
+    DaemonStatus status = DaemonStatus::FAILED;   // FAILED also when the connection is lost
+    int    runtime = -1;                          // 0=CPU 1=GPU 2=DSP
+    int    top1    = -1;
+    double queueMs = 0.0, execMs = 0.0, respMs = 0.0;   // release → execute(), execute(), release → reply
+    bool   late    = false;                       // reply received after the deadline
+    std::vector<float> output;                    // with wantOutput
+};
+
+// Frames of one model through shared memory (ATTACH): write the frame into the slot
+// acquire() returns, submit() it, and next() reports the result and frees the slot.
+// One thread may acquire/submit while another calls next(). Valid while its
+// DaemonClient is connected.
+class FrameRing {
+public:
+    using Clock = std::chrono::steady_clock;
+    ~FrameRing();
+    uint32_t slots() const { return m_L->slots; }
+    uint32_t frameFloats() const { return m_L->frameFloats; }
+    float*   frame(uint32_t slot) { return m_L->frame(slot); }
+
+    int  acquire();                                // free slot, or -1 if all are in flight
+    void submit(uint32_t slot, std::chrono::microseconds deadline, int priority = 0);
+    // Waits up to timeout for a completion; stagedBytes is what the daemon still copied.
+    bool next(DaemonReply& r, size_t* stagedBytes = nullptr,
+              std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+private:
+    friend class DaemonClient;
+    FrameRing(RingLayout* L, size_t bytes);
+    RingLayout* m_L; size_t m_bytes;
+    std::mutex m_m;                                // free slots and the release times
+    std::deque<uint32_t> m_free;
+    std::vector<RingSub> m_sent;                   // by slot
+    uint64_t m_seq = 0;
+};
+
+// One connection; submit() may be called from any thread. Replies are matched to their
+// requests by a reader thread, so several requests can be outstanding at once.
+class DaemonClient {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    DaemonClient() = default;
+    DaemonClient(const DaemonClient&) = delete;
+    DaemonClient& operator=(const DaemonClient&) = delete;
+    ~DaemonClient() { close(); }
+
+    bool connect(const std::string& path);
+    void close();                                  // outstanding requests complete as FAILED
+
+    // Model id for a name the daemon serves (file name of the dlc without extension), or
+    // -1. inputCount receives the number of floats a frame of that model holds.
+    int open(const std::string& name, uint32_t* inputCount = nullptr);
+
+    // count == 0 runs the model's default frame. The deadline is relative to now.
+    std::future<DaemonReply> submit(int model, const float* data, uint32_t count,
+                                    std::chrono::microseconds deadline, int priority = 0,
+                                    bool wantOutput = false);
+
+    // Shared‑memory ring of `slots` frames for model, or null if the daemon refused it.
+    std::unique_ptr<FrameRing> attach(int model, uint32_t slots);
+
+private:
+    bool send(MsgType t, const void* fix, size_t fixLen, const void* data, size_t dataLen);
+    bool recvAll(void* p, size_t n);               // keeps an fd passed along in m_passed
+    void readLoop();
+    void failAll();
+
+    int m_fd = -1;
+    std::mutex m_write;                            // one message at a time on the socket
+    std::mutex m_pending;                          // guards the maps and m_closed
+    bool m_closed = true;                          // no reader: requests fail at once
+    std::unordered_map<uint64_t, std::promise<DaemonReply>> m_infer;
+    std::unordered_map<uint64_t, std::promise<OpenRep>>     m_open;
+    std::unordered_map<uint64_t, std::promise<std::pair<AttachRep,int>>> m_attach;   // reply, fd
+    int m_passed = -1;                             // reader thread only
+    std::unordered_map<uint64_t, InferReq>                  m_sent;   // for the reply's timings
+    std::atomic<uint64_t> m_nextId{1};
+    std::thread m_reader;
+};
+
+#endif // DAEMONCLIENT_H
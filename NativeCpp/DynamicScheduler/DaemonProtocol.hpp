@@ -0,0 +1,44 @@
+// DaemonProtocol.hpp – wire format between the scheduler daemon (-D) and its clients
+#ifndef DAEMONPROTOCOL_H
+#define DAEMONPROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Local stream socket only, so everything travels in host byte order. Every message is
+// a MsgHeader followed by `length` payload bytes. Times are CLOCK_MONOTONIC nanoseconds
+// (std::chrono::steady_clock), which both sides of a local socket share.
+constexpr uint32_t kDaemonMagic   = 0x44534348;   // "DSCH"
+constexpr uint16_t kDaemonVersion = 2;
+constexpr uint32_t kMaxPayload    = 64u << 20;    // larger messages close the connection
+
+enum class MsgType : uint16_t {
+    OPEN   = 1,   // client → daemon: OpenReq + model name (no terminator)
+    OPENED = 2,   // daemon → client: OpenRep
+    INFER  = 3,   // client → daemon: InferReq + count floats
+    RESULT = 4,   // daemon → client: InferRep + count floats
+    ATTACH   = 5, // client → daemon: AttachReq
+    ATTACHED = 6, // daemon → client: AttachRep, with the ring's memfd as SCM_RIGHTS
+};
+
+struct MsgHeader { uint32_t magic; uint16_t version; uint16_t type; uint32_t length; };
+
+struct OpenReq  { uint64_t id; };
+struct OpenRep  { uint64_t id; int32_t model; uint32_t inputCount; };   // model < 0: unknown name
+
+// count == 0 runs the model's default frame, otherwise count must equal inputCount.
+// Higher priorities are served first on every runtime; deadline and released are absolute.
+struct InferReq { uint64_t id; int32_t model; int32_t priority; int64_t releasedNs, deadlineNs;
+                  uint32_t wantOutput; uint32_t count; };
+
+enum class DaemonStatus : int32_t { OK = 0, CANCELLED = 1, FAILED = 2, BAD_REQUEST = 3 };
+
+struct InferRep { uint64_t id; int32_t status; int32_t runtime; int32_t top1; uint32_t count;
+                  int64_t startedNs, finishedNs, completedNs; };   // execute() and completion times
+
+// Frames of one model through a shared‑memory ring (ShmRing.hpp) instead of INFER. The
+// ring lives as long as the connection; slots is clamped to [1, kMaxRingSlots].
+struct AttachReq { uint64_t id; int32_t model; uint32_t slots; };
+struct AttachRep { uint64_t id; int32_t status; uint32_t slots; uint64_t bytes; };   // DaemonStatus
+
+#endif // DAEMONPROTOCOL_H
@@ -16,6 +16,8 @@
 #include "SNPE/SNPE.hpp"
 #include "DlSystem/ITensorFactory.hpp"
 #include "DlSystem/TensorMap.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+#include "Util.hpp"
 
 typedef unsigned int GLuint;
 std::unique_ptr<zdl::DlSystem::ITensor> loadInputTensor (std::unique_ptr<zdl::SNPE::SNPE>& snpe,
@@ -27,11 +29,11 @@ std::tuple<zdl::DlSystem::TensorMap, bool> loadMultipleInput (std::unique_ptr<zd
                                                                 const zdl::DlSystem::StringList& inputTensorNames,
                                                                 std::vector<std::unique_ptr<zdl::DlSystem::ITensor>>& inputs);
 
-bool loadInputUserBufferFloat(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+bool loadInputUserBufferFloat(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                                 std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                                 std::vector<std::string>& fileLines);
 
-bool loadInputUserBufferTfN(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+bool loadInputUserBufferTfN(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                          std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                          std::vector<std::string>& fileLines,
                          zdl::DlSystem::UserBufferMap& inputMap,
@@ -39,6 +41,16 @@ bool loadInputUserBufferTfN(std::unordered_map<std::string, std::vector<uint8_t>
                          int bitWidth,
                          bool useNativeInputFiles=false);
 
+// Zero-copy alternative to loadInputUserBufferFloat for a batch of one file line: maps
+// every input file and points the input's user buffer at the mapping instead of copying
+// into application storage. The mappings are kept in mappedFiles, replacing the previous
+// batch's, so the buffers stay valid until the next call; call it only once the previous
+// execute() has returned. Fails if a file's size is not the buffer's.
+bool bindInputUserBufferMapped(std::vector<MappedFile>& mappedFiles,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                               std::vector<std::string>& fileLines);
+
 void loadInputUserBuffer(std::unordered_map<std::string, GLuint>& applicationBuffers,
                                 std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                                 const GLuint inputglbuffer);
@@ -0,0 +1,125 @@
+// RealTime.cpp – opt‑in real‑time execution for the scheduler
+#include "RealTime.hpp"
+
+#include <alloca.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static constexpr size_t kPage = 4096;
+
+bool RtConfig::on() const
+{
+    if(dispatcher.policy != SCHED_OTHER || host.policy != SCHED_OTHER) return true;
+    for(const auto& w : worker) if(w.policy != SCHED_OTHER) return true;
+    return false;
+}
+
+// "fifo/80" → SCHED_FIFO, 80
+static bool parsePrio(const std::string& s, RtPrio& p)
+{
+    const auto sl = s.find('/');
+    const std::string pol = s.substr(0, sl);
+    if     (pol == "fifo")  p.policy = SCHED_FIFO;
+    else if(pol == "rr")    p.policy = SCHED_RR;
+    else if(pol == "other"){ p.policy = SCHED_OTHER; p.prio = 0; return sl == std::string::npos; }
+    else return false;
+    if(sl == std::string::npos) return false;
+    char* end = nullptr;
+    p.prio = int(std::strtol(s.c_str()+sl+1, &end, 10));
+    return *end == '\0' && p.prio >= sched_get_priority_min(p.policy) && p.prio <= sched_get_priority_max(p.policy);
+}
+
+bool makeRtConfig(const std::string& spec, RtConfig& c)
+{
+    c = RtConfig(); c.name = spec;
+    if(spec == "fifo" || spec == "rr"){
+        const int pol = spec == "fifo" ? SCHED_FIFO : SCHED_RR;
+        c.dispatcher = { pol, 80 };
+        c.worker[1] = c.worker[2] = { pol, 70 };
+        c.worker[0] = { pol, 60 };
+        c.host = { pol, 50 };
+        return true;
+    }
+    std::stringstream ss(spec); std::string role;
+    while(std::getline(ss, role, ':')){
+        auto eq = role.find('=');
+        if(eq == std::string::npos) return false;
+        std::string k = role.substr(0,eq);
+        RtPrio p;
+        if(!parsePrio(role.substr(eq+1), p)) return false;
+        if     (k=="cpu")  c.worker[0]  = p;
+        else if(k=="gpu")  c.worker[1]  = p;
+        else if(k=="dsp")  c.worker[2]  = p;
+        else if(k=="host") c.host       = p;
+        else if(k=="disp") c.dispatcher = p;
+        else return false;
+    }
+    return c.on();
+}
+
+std::string rtPrioStr(const RtPrio& p)
+{
+    if(p.policy == SCHED_FIFO) return "FIFO/"+std::to_string(p.prio);
+    if(p.policy == SCHED_RR)   return "RR/"+std::to_string(p.prio);
+    return p.policy == SCHED_OTHER ? "OTHER" : "policy "+std::to_string(p.policy);
+}
+
+pid_t currentTid(){ return static_cast<pid_t>(syscall(SYS_gettid)); }
+
+bool setThreadRt(pid_t tid, const RtPrio& p)
+{
+    sched_param sp{}; sp.sched_priority = p.prio;
+    return sched_setscheduler(tid, p.policy, &sp) == 0;
+}
+
+RtPrio threadRt(pid_t tid)
+{
+    RtPrio p;
+    sched_param sp{};
+    p.policy = sched_getscheduler(tid) & ~SCHED_RESET_ON_FORK;
+    if(sched_getparam(tid, &sp) == 0) p.prio = sp.sched_priority;
+    return p;
+}
+
+bool lockMemory(std::string& err)
+{
+    if(mlockall(MCL_CURRENT | MCL_FUTURE) == 0) return true;
+    err = std::strerror(errno);
+    rlimit rl{};
+    if(getrlimit(RLIMIT_MEMLOCK, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY)
+        err += " (RLIMIT_MEMLOCK " + std::to_string(rl.rlim_cur/1024) + " KiB, see ulimit -l)";
+    return false;
+}
+
+void prefaultStack(size_t bytes)
+{
+    volatile char* p = static_cast<volatile char*>(alloca(bytes));
+    for(size_t i = 0; i < bytes; i += kPage) p[i] = 0;
+}
+
+void CpuHog::start(int n, const std::vector<CpuInfo>& cpus)
+{
+    stop();
+    m_stop = false;
+    for(int i = 0; i < n; ++i)
+        m_threads.emplace_back([this, cpus]{
+            setThreadRt(0, RtPrio());                      // not the creator's real‑time policy
+            pinThread(0, {}, cpus);                        // nor its CPU set
+            volatile uint64_t x = 0;
+            while(!m_stop.load(std::memory_order_relaxed)) x = x + 1;
+        });
+}
+
+void CpuHog::stop()
+{
+    m_stop = true;
+    for(auto& t : m_threads) t.join();
+    m_threads.clear();
+}
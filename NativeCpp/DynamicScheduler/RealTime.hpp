@@ -0,0 +1,63 @@
+// RealTime.hpp – opt‑in real‑time execution: SCHED_FIFO / SCHED_RR per thread role, locked
+//                and prefaulted memory, and the CPU‑hog background load it is measured against
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+#include <sys/types.h>
+
+#include "Topology.hpp"
+
+struct RtPrio {                                  // SCHED_OTHER: left to CFS
+    int policy, prio;
+    RtPrio(int policy = SCHED_OTHER, int prio = 0) : policy(policy), prio(prio) {}
+};
+
+// Scheduling policy per thread role, as Placement has CPU sets per role.
+struct RtConfig {
+    std::string name = "off";
+    std::array<RtPrio,3> worker;     // 0=CPU 1=GPU 2=DSP runtime worker
+    RtPrio host;                     // stager and poster of a pipelined runtime
+    RtPrio dispatcher;               // releases the arrivals, or serves the daemon's clients
+    bool on() const;
+};
+
+// fifo | rr : every role with that policy at the default priorities: dispatcher 80,
+//             GPU/DSP workers 70 (they submit and wait), CPU worker 60 (it computes for
+//             tens of ms and must not hold up the others), stager / poster 50
+// spec      : explicit "disp=fifo/80:cpu=rr/60:gpu=fifo/70:dsp=fifo/70:host=rr/50",
+//             omitted roles stay under CFS
+bool makeRtConfig(const std::string& spec, RtConfig& out);
+std::string rtPrioStr(const RtPrio& p);          // "FIFO/80", "OTHER"
+
+pid_t currentTid();
+// sched_setscheduler on a thread id (0 = calling thread)
+bool setThreadRt(pid_t tid, const RtPrio& p);
+// what the kernel actually runs the thread with
+RtPrio threadRt(pid_t tid);
+
+// mlockall(MCL_CURRENT | MCL_FUTURE): every page resident now and every later mapping
+// populated when it is made. Needs CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK.
+bool lockMemory(std::string& err);
+// Touches bytes of the calling thread's stack so a deep call never page‑faults.
+void prefaultStack(size_t bytes);
+
+// n busy‑looping threads under CFS on every online CPU, whatever their creator runs with.
+class CpuHog {
+public:
+    ~CpuHog(){ stop(); }
+    void start(int n, const std::vector<CpuInfo>& cpus);
+    void stop();
+private:
+    std::atomic<bool> m_stop{false};
+    std::vector<std::thread> m_threads;
+};
+
+#endif
@@ -80,7 +80,7 @@ bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
 
 // Execute the network on an input user buffer map and print results to raw files
 bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
-                 std::unordered_map<std::string,std::vector<uint8_t>>& applicationOutputBuffers,
+                 std::unordered_map<std::string, ApplicationBuffer>& applicationOutputBuffers,
                  const std::string& outputDir,
                  int num,
                  size_t batchSize,
@@ -112,7 +112,7 @@ bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
            }
            if (isTfNBuffer)
            {
-              std::vector<uint8_t> output;
+              ApplicationBuffer output;
               zdl::DlSystem::UserBufferEncodingTfN ubetfN = dynamic_cast<zdl::DlSystem::UserBufferEncodingTfN &>(outputMap.getUserBuffer(name)->getEncoding());
               output.resize(applicationOutputBuffers.at(name).size() * sizeof(float) / elementSize);
               TfNToFloat(reinterpret_cast<float *>(&output[0]),applicationOutputBuffers.at(name).data(),
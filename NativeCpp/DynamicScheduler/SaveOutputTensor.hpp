@@ -16,6 +16,7 @@
 #include "SNPE/SNPE.hpp"
 #include "DlSystem/ITensor.hpp"
 #include "DlSystem/UserBufferMap.hpp"
+#include "UserBufferArena.hpp"
 
 // Save output implementation of ITensor
 bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
@@ -25,7 +26,7 @@ bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
 
 // Save output USERBUFFER
 bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
-                 std::unordered_map<std::string,std::vector<uint8_t>>& applicationOutputBuffers,
+                 std::unordered_map<std::string, ApplicationBuffer>& applicationOutputBuffers,
                  const std::string& outputDir,
                  int num,
                  size_t batchSize,
@@ -0,0 +1,948 @@
+// Scheduler.cpp – in‑process inference service: preloaded models, per‑runtime worker
+//                 threads and the runtime selection policies of the benchmark
+#include "Scheduler.hpp"
+
+#include <SNPE/SNPE.hpp>
+#include <SNPE/SNPEFactory.hpp>
+
+#include "DlContainer/IDlContainer.hpp"
+#include "DlSystem/IUserBuffer.hpp"
+#include "DlSystem/IUserBufferFactory.hpp"
+#include "DlSystem/SNPEPerfProfile.h"
+#include "DlSystem/TensorShape.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+#include "CreateUserBuffer.hpp"
+#include "LoadContainer.hpp"
+#include "LoadInputTensor.hpp"
+#include "PreprocessInput.hpp"
+#include "SetBuilderOptions.hpp"
+#include "UserBufferArena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace dsched {
+
+static const char* kPolName[] = { "CPU_ONLY","GPU_ONLY","DSP_ONLY","RANDOM","JSQ","DYNAMIC","STATIC_OPT","BANDIT" };
+const char* policyName(Policy p){ return kPolName[int(p)]; }
+const char* runtimeName(Runtime_t r){ return r==Runtime_t::CPU?"CPU":r==Runtime_t::GPU?"GPU":"DSP"; }
+
+/* ───────────────────────────────── service state ───────────────────────────────── */
+static ServiceConfig     gCfg;
+static std::atomic<bool> gStop{false};
+static std::atomic<int > gInFlight{0};
+static std::atomic<int > gPolicy{int(Policy::DYNAMIC)};
+static std::mutex        gRngM;
+static std::mt19937      gRng;                               // RANDOM
+static std::vector<std::thread> gThreads;
+
+// One user‑buffer set: application storage per tensor name and the SNPE map on top.
+struct IoSet  { std::unordered_map<std::string, ApplicationBuffer> buf;
+                std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> ub;
+                zdl::DlSystem::UserBufferMap map; };
+// Staged request holding each input and output set (Staged::id, 0 = free), under gPipe[rt].m:
+// a context's own sets, or the runtime's once planIo() laid every context's over one arena.
+struct IoSlots { std::array<uint64_t,2> in{{0,0}}, out{{0,0}}; };
+struct RtCtx  { std::unique_ptr<zdl::SNPE::SNPE> snpe;
+                std::unique_ptr<zdl::DlSystem::ITensor> input;      // serial mode
+                std::vector<float> frame;                           // default frame
+                size_t imageW = 0, imageH = 0;                      // single H×W×3 input: camera frames
+                std::array<IoSet,2> inSet, outSet;                  // pipelined mode
+                IoSlots own; IoSlots* shared = nullptr;             // see slots()
+                std::unordered_map<const float*, std::unique_ptr<IoSet>> bound; };   // bindInput, under gBindM
+inline IoSlots& slots(RtCtx& c){ return c.shared ? *c.shared : c.own; }
+
+/* latency tracker for DYNAMIC */
+struct LatRec { double avg = 1.0; void upd(double v){ avg = 0.9*avg + 0.1*v; } };
+
+// Everything that belongs to one container; shared by the models registered with it.
+struct ModelCtx { std::array<RtCtx,3> rt;                            // 0=CPU 1=GPU 2=DSP
+                  std::vector<Runtime_t> avail;
+                  std::array<double,3> prof{{-1.0,-1.0,-1.0}};       // offline profile [ms] for STATIC_OPT
+                  std::array<LatRec,3> lat; };
+// Result cache of a registered model: keys of recent frames and what they computed.
+struct CacheKey    { bool valid = false; uint64_t hash = 0; std::vector<float> cells; };
+struct CacheEntry  { CacheKey key; Runtime_t rt; int top1; std::vector<float> output; };
+struct ResultCache { std::mutex m; std::deque<CacheEntry> lru;          // most recent first
+                     double execMs = 0.0; bool seen = false;   // EWMA of executed requests
+                     CacheStats st{}; };
+struct Model    { ModelConfig cfg; ModelCtx* ctx; std::atomic<int> fixed{-1};   // fixed: STATIC_OPT runtime
+                  ResultCache cache; };
+
+// The arena the contexts of a runtime share after planIo(); outlives them.
+struct IoShare { std::unique_ptr<UserBufferArena> arena; IoSlots slots; };
+static IoShare                                                     gShare[3];
+static IoPlan                                                      gPlan;
+static std::atomic<uint64_t>                                       gLiveFaults{0};
+
+static std::unordered_map<std::string, std::unique_ptr<ModelCtx>> gCtx;   // by container
+static std::vector<std::unique_ptr<Model>>                         gModels;
+static std::mutex                                                  gBindM;
+
+/* ───────────────────────────────── queues per runtime ───────────────────────────── */
+struct Request { int model; Runtime_t rt; Clock::time_point dl, rel;
+                 int ctx, prio;                              // queue‑depth context, priority
+                 double cost; double vs;                     // est. service [ms], WFQ start tag
+                 InputView in; Completion done;
+                 CacheKey key; };                            // set when the model caches results
+
+inline void enter(Runtime_t rt);
+
+// FIFO by default. With wfq set the queue does start‑time fair queuing: a request is
+// tagged S = max(V, F_prev(model)), F = S + cost/weight, the smallest S is served
+// next and V follows the tag in service, so every backlogged model gets runtime
+// time in proportion to its weight no matter how often it is released. Either order
+// only applies among the requests of the highest queued priority.
+// A popped request counts as in flight before the lock is released, so queued plus
+// in flight never reads zero while a request is being handed to a worker.
+struct TSQueue {
+    std::deque<Request> q; std::mutex m; std::condition_variable cv;
+    bool wfq = false; double vtime = 0.0; std::array<double,kMaxModels> lastFin{};
+    void push(Request r){
+        { std::lock_guard<std::mutex> lk(m);
+          if(wfq){ r.vs = std::max(vtime, lastFin[r.model]);
+                   lastFin[r.model] = r.vs + r.cost/std::max(1e-3, gModels[r.model]->cfg.weight); }
+          q.push_back(std::move(r)); }
+        cv.notify_one();
+    }
+    bool pop(Request& r){
+        std::unique_lock<std::mutex> lk(m);
+        cv.wait(lk,[&]{ return !q.empty() || gStop.load(); });
+        if(q.empty()) return false;
+        auto it = std::min_element(q.begin(),q.end(),[&](const Request& a,const Request& b){
+                      return a.prio != b.prio ? a.prio > b.prio : wfq && a.vs < b.vs; });
+        r = std::move(*it); q.erase(it);
+        if(wfq) vtime = std::max(vtime, r.vs);
+        enter(r.rt);
+        return true;
+    }
+    void reset(bool fair){ std::lock_guard<std::mutex> lk(m); wfq = fair; vtime = 0.0; lastFin.fill(0.0); }
+    size_t size(){ std::lock_guard<std::mutex> lk(m); return q.size(); }
+};
+static TSQueue queues[3];
+
+/* ───────────────────────────────── pipelined runtime workers ───────────────────── */
+// Three threads per runtime: while the accelerator thread executes request N from one
+// input/output set, the stager copies N+1's frame into the other input set and the
+// poster consumes N‑1's outputs from the other output set. The stager keeps at most
+// one request staged ahead so the queue discipline still decides what runs next.
+// in < 0: the request's frame is bound memory, inMap wraps it and no input set is held.
+// Before using a set each stage checks that the request still holds it (IoSlots).
+struct Staged { Request rq; RtCtx* c; int in, out; const zdl::DlSystem::UserBufferMap* inMap;
+                double hostMs; size_t bytes; Clock::time_point t0, t1; bool ok; PreprocessTimes prep;
+                uint64_t id; };
+struct Pipe   { std::mutex m; std::condition_variable cv; std::deque<Staged> ready, done;
+                uint64_t lastId = 0; };
+static Pipe gPipe[3];
+static std::atomic<pid_t> gWorkerTid[3];
+static std::atomic<pid_t> gHelperTid[3][2];                // stager / poster
+
+/* ───────────────────────────────── runtime gauges ──────────────────────────────── */
+// Updated by the workers with relaxed atomics only; execSince is the start of the
+// execute() in progress (0 = idle) so a sample also sees a partly finished execution.
+struct RtGauge { std::atomic<int64_t> busyNs{0}, execSince{0};
+                 std::atomic<uint64_t> done{0}; std::atomic<int> inFlight{0}; };
+static RtGauge gGauge[3];
+inline int64_t ticks(Clock::time_point t){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count(); }
+inline void enter(Runtime_t rt){ gInFlight++; gGauge[int(rt)].inFlight++; }
+inline void leave(Runtime_t rt){ gGauge[int(rt)].inFlight--; gInFlight--; }
+inline void execBegin(Runtime_t rt, Clock::time_point t0){ gGauge[int(rt)].execSince = ticks(t0); }
+inline void execEnd(Runtime_t rt, Clock::time_point t0, Clock::time_point t1){
+    gGauge[int(rt)].execSince = 0; gGauge[int(rt)].busyNs += ticks(t1)-ticks(t0); }
+
+/* ───────────────────────────────── contextual bandit for BANDIT ────────────────── */
+// One arm per (model, runtime, depth bucket of that runtime's queue); the cost of a
+// pull is the response time from release to completion. The arms are seeded with one
+// pseudo‑pull from the offline profile and learn across runs; every policy feeds them.
+// `run` holds the completions of the current run only, whose regret is measured
+// against the best learned arm of the same (model, context).
+static constexpr int    kCtx  = 4;       // queue depth 0 | 1 | 2‑3 | 4+
+static constexpr double kUcbC = 0.5;     // exploration bonus, in units of the slack
+static constexpr double kCtxDepth[kCtx] = { 0, 1, 2, 4 };   // representative depth, for the seed
+inline int depthCtx(size_t q){ return q==0 ? 0 : q==1 ? 1 : q<4 ? 2 : 3; }
+
+struct Arm { uint64_t n = 0; double sum = 0; double mean() const { return n ? sum/n : 0.0; } };
+struct Bandit {
+    using Table = std::array<std::array<std::array<Arm,kCtx>,3>,kMaxModels>;   // [model][runtime][context]
+    std::mutex m;
+    Table arm, run;
+    std::array<uint64_t,kMaxModels> pulls{};
+    void reset(){ std::lock_guard<std::mutex> lk(m);
+                  for(auto& a:arm) for(auto& b:a) b.fill(Arm{});
+                  pulls.fill(0); }
+    void resetRun(){ std::lock_guard<std::mutex> lk(m); for(auto& a:run) for(auto& b:a) b.fill(Arm{}); }
+    void seed(int mi,const std::array<double,3>& prof){ std::lock_guard<std::mutex> lk(m);
+                  for(int r=0;r<3;++r) for(int c=0;c<kCtx;++c){
+                      Arm& a = arm[mi][r][c]; a = Arm{};
+                      if(prof[r] > 0.0){ a.n = 1; a.sum = prof[r]*(1.0+kCtxDepth[c]); } } }
+    void upd(int mi,Runtime_t rt,int ctx,double ms){ std::lock_guard<std::mutex> lk(m);
+                  Arm& a = arm[mi][int(rt)][ctx]; a.n++; a.sum += ms;
+                  Arm& b = run[mi][int(rt)][ctx]; b.n++; b.sum += ms; }
+};
+static Bandit gBandit;
+
+static constexpr int kProfRuns = 5;      // timed executions of the offline profile
+
+/* ───────────────────────────────── helpers ─────────────────────────────────────── */
+inline pid_t gettid_(){ return static_cast<pid_t>(syscall(SYS_gettid)); }
+inline bool exists(const std::string& p){ return access(p.c_str(),F_OK)==0; }
+inline double msBetween(Clock::time_point a, Clock::time_point b){
+    return std::chrono::duration<double,std::milli>(b-a).count(); }
+inline bool validId(int m){ return m >= 0 && size_t(m) < gModels.size(); }
+
+/* prepare one ITensor (robust) ---------------------------------------------------- */
+static std::unique_ptr<zdl::DlSystem::ITensor>
+prepInput(std::unique_ptr<zdl::SNPE::SNPE>& snpe, const std::string& list)
+{
+    auto batches = preprocessInput(list.c_str(),1);
+    if(batches.empty()) throw std::runtime_error("empty input list "+list);
+
+    const auto& namesOpt = snpe->getInputTensorNames();
+    if(!namesOpt) throw std::runtime_error("null input‑name ptr");
+    const auto& names = *namesOpt;
+    if(names.size()!=1)
+        throw std::runtime_error("model declares "+std::to_string(names.size())+" inputs");
+
+    return loadInputTensor(snpe, batches[0], names);
+}
+
+/* host work around execute(): stage the input in, reduce the outputs to a top‑1 ---- */
+static size_t stageInput(RtCtx& c, int set, InputView in,
+                         const PixelNormalization& norm = PixelNormalization(), PreprocessTimes* prep = nullptr)
+{
+    if(in.camera.data){                                     // submit() checked the input shape
+        float* dst = gCfg.pipeline ? reinterpret_cast<float*>(c.inSet[set].buf.begin()->second.data())
+                                   : &*c.input->begin();
+        PreprocessYuvFrame(in.camera, c.imageW, c.imageH, norm, dst, prep);
+        return c.frame.size()*sizeof(float);
+    }
+    const float* src = in.data ? in.data : c.frame.data();
+    const size_t n   = in.data ? in.count : c.frame.size();
+    if(!gCfg.pipeline){
+        const size_t k = std::min(n, c.frame.size());
+        std::copy(src, src + k, c.input->begin());
+        return k*sizeof(float);
+    }
+    size_t bytes = 0;
+    for(auto& kv : c.inSet[set].buf){
+        const size_t k = std::min(kv.second.size(), n*sizeof(float));
+        std::memcpy(kv.second.data(), src, k);
+        bytes += k;
+    }
+    return bytes;
+}
+static const zdl::DlSystem::UserBufferMap* boundInput(RtCtx& c, InputView in)
+{
+    if(!in.data) return nullptr;
+    std::lock_guard<std::mutex> lk(gBindM);
+    auto it = c.bound.find(in.data);
+    return it == c.bound.end() ? nullptr : &it->second->map;
+}
+static int postOutput(const zdl::DlSystem::TensorMap& om, std::vector<float>* keep)
+{
+    int best = -1, i = 0; float bv = -std::numeric_limits<float>::infinity();
+    for(auto& name : om.getTensorNames()){
+        const zdl::DlSystem::ITensor* t = om.getTensor(name);
+        if(keep) keep->insert(keep->end(), t->cbegin(), t->cend());
+        for(auto it = t->cbegin(); it != t->cend(); ++it, ++i) if(*it > bv){ bv = *it; best = i; }
+    }
+    return best;
+}
+static int postOutput(const RtCtx& c, const IoSet& out, std::vector<float>* keep)
+{
+    int best = -1, i = 0; float bv = -std::numeric_limits<float>::infinity();
+    const auto names = c.snpe->getOutputTensorNames();
+    if(!names) return best;
+    for(const char* name : *names){                         // network order, as in the TensorMap
+        auto b = out.buf.find(name);
+        if(b == out.buf.end()) continue;
+        const float* p = reinterpret_cast<const float*>(b->second.data());
+        const size_t n = b->second.size()/sizeof(float);
+        if(keep) keep->insert(keep->end(), p, p+n);
+        for(size_t k = 0; k < n; ++k, ++i) if(p[k] > bv){ bv = p[k]; best = i; }
+    }
+    return best;
+}
+
+/* mean latency of kProfRuns executions after one untimed warm‑up ------------------- */
+static void execOnce(const RtCtx& ctx)
+{
+    if(gCfg.pipeline){ ctx.snpe->execute(ctx.inSet[0].map, ctx.outSet[0].map); return; }
+    zdl::DlSystem::TensorMap om; ctx.snpe->execute(ctx.input.get(), om);
+}
+static double profileLat(const RtCtx& ctx)
+{
+    execOnce(ctx);
+    auto t0 = Clock::now();
+    for(int i=0;i<kProfRuns;++i) execOnce(ctx);
+    return msBetween(t0, Clock::now())/kProfRuns;
+}
+
+/* load a DLC once per runtime (with Init‑Caching) --------------------------------- */
+static std::unique_ptr<ModelCtx> loadModel(const std::string& dlc, const std::string& list)
+{
+    std::unique_ptr<ModelCtx> mc(new ModelCtx);
+    for(Runtime_t rt:{Runtime_t::CPU,Runtime_t::GPU,Runtime_t::DSP}){
+        if(!zdl::SNPE::SNPEFactory::isRuntimeAvailable(rt)) continue;
+
+        RtCtx& ctx = mc->rt[int(rt)];                       // user buffers point into it: build in place
+        if(auto cont = loadContainerFromFile(dlc)){
+            zdl::DlSystem::PlatformConfig pc;
+            ctx.snpe = setBuilderOptions(cont, rt, {}, gCfg.pipeline, pc,
+                                         /*InitCache*/true,false,
+                                         zdl::DlSystem::PerformanceProfile_t::HIGH_PERFORMANCE);
+            if(ctx.snpe){
+                cont->save(dlc.c_str());                   // create / update cache
+                try{
+                    ctx.input = prepInput(ctx.snpe, list);
+                    ctx.frame.assign(ctx.input->cbegin(), ctx.input->cend());
+                    const zdl::DlSystem::TensorShape shape = ctx.snpe->getInputDimensions();
+                    const size_t rank = shape.rank();
+                    if(ctx.snpe->getInputTensorNames()->size() == 1 && rank >= 3 && shape[rank-1] == 3
+                       && shape[rank-3]*shape[rank-2]*3 == ctx.frame.size()){
+                        ctx.imageH = shape[rank-3]; ctx.imageW = shape[rank-2];
+                    }
+                    if(gCfg.pipeline){
+                        ctx.input.reset();
+                        for(int k=0;k<2;++k){
+                            createInputBufferMap (ctx.inSet[k].map,  ctx.inSet[k].buf,  ctx.inSet[k].ub,
+                                                  ctx.snpe, false, false, 32);
+                            createOutputBufferMap(ctx.outSet[k].map, ctx.outSet[k].buf, ctx.outSet[k].ub,
+                                                  ctx.snpe, false, 32);
+                        }
+                        stageInput(ctx, 0, InputView());
+                    }
+                }
+                catch(...){ ctx = RtCtx(); }
+            }
+        }
+        if(ctx.snpe){
+            mc->prof[int(rt)] = profileLat(ctx);
+            mc->avail.push_back(rt);
+        }
+    }
+    return mc;
+}
+
+int registerModel(const ModelConfig& cfg)
+{
+    if(gModels.size() >= size_t(kMaxModels) || !exists(cfg.dlc)) return -1;
+    auto it = gCtx.find(cfg.dlc);
+    if(it == gCtx.end()) it = gCtx.emplace(cfg.dlc, loadModel(cfg.dlc, cfg.inputList)).first;
+    if(it->second->avail.empty()) return -1;
+    std::unique_ptr<Model> m(new Model);
+    m->cfg = cfg; m->ctx = it->second.get();
+    gModels.push_back(std::move(m));
+    gBandit.seed(int(gModels.size())-1, it->second->prof);
+    return int(gModels.size())-1;
+}
+
+const std::vector<Runtime_t>& availableRuntimes(int model)
+{
+    static const std::vector<Runtime_t> none;
+    return validId(model) ? gModels[model]->ctx->avail : none;
+}
+std::array<double,3> profiledLatency(int model)
+{
+    return validId(model) ? gModels[model]->ctx->prof : std::array<double,3>{{-1.0,-1.0,-1.0}};
+}
+size_t inputSize(int model)
+{
+    if(!validId(model) || gModels[model]->ctx->avail.empty()) return 0;
+    return gModels[model]->ctx->rt[int(gModels[model]->ctx->avail[0])].frame.size();
+}
+bool cameraInput(int model)
+{
+    if(!validId(model) || gModels[model]->ctx->avail.empty()) return false;
+    return gModels[model]->ctx->rt[int(gModels[model]->ctx->avail[0])].imageW != 0;
+}
+
+static size_t touch(void* p, size_t n)
+{
+    volatile uint8_t* b = static_cast<volatile uint8_t*>(p);
+    for(size_t i = 0; i < n; i += 4096) b[i] = b[i];
+    if(n) b[n-1] = b[n-1];
+    return n;
+}
+size_t prefault()
+{
+    size_t n = 0;
+    for(auto& kv : gCtx)
+        for(RtCtx& c : kv.second->rt){
+            n += touch(c.frame.data(), c.frame.size()*sizeof(float));
+            if(c.input) n += touch(&*c.input->begin(), c.input->getSize()*sizeof(float));
+            if(c.shared) continue;                          // in the runtime's arena
+            for(auto* sets : { &c.inSet, &c.outSet })
+                for(IoSet& s : *sets) for(auto& b : s.buf) n += touch(b.second.data(), b.second.size());
+        }
+    for(IoShare& sh : gShare) if(sh.arena) n += touch(sh.arena->data(), sh.arena->capacity());
+    return n;
+}
+
+/* one IO arena per runtime for the user‑buffer sets of all its contexts ------------- */
+static size_t residentBytes()
+{
+    size_t pages = 0, resident = 0;
+    std::ifstream("/proc/self/statm")>>pages>>resident;
+    return resident*size_t(sysconf(_SC_PAGESIZE));
+}
+static size_t setBytes(const IoSet& s)
+{
+    std::vector<size_t> sizes;
+    for(auto& b : s.buf) sizes.push_back(b.second.size());
+    return UserBufferArena::bytesFor(sizes);
+}
+
+// Arena layout: input set 0 | input set 1 | output set 0 | output set 1, each as large as
+// the runtime's largest; a context's set k starts at its region whatever its own size.
+IoPlan planIo(bool hugePages)
+{
+    if(gPlan.applied || !gCfg.pipeline) return gPlan;
+    gPlan.residentBefore = residentBytes();
+    for(int r=0;r<3;++r){
+        IoFootprint& f = gPlan.rt[r];
+        std::vector<RtCtx*> ctxs;
+        size_t inMax = 0, outMax = 0;
+        for(auto& kv : gCtx){
+            RtCtx& c = kv.second->rt[r];
+            if(!c.snpe) continue;
+            const size_t in = setBytes(c.inSet[0]), out = setBytes(c.outSet[0]);
+            f.ownBytes += 2*(in + out);
+            inMax = std::max(inMax, in); outMax = std::max(outMax, out);
+            ctxs.push_back(&c);
+        }
+        f.models = int(ctxs.size());
+        f.sharedBytes = f.ownBytes;
+        if(ctxs.size() < 2) continue;
+
+        std::unique_ptr<UserBufferArena> arena(new UserBufferArena(2*(inMax + outMax), hugePages));
+        if(!arena->valid()) continue;
+        std::vector<std::array<IoSet,4>> sets(ctxs.size());     // built first: a failure keeps the old ones
+        try{
+            for(size_t i = 0; i < ctxs.size(); ++i)
+                for(int k=0;k<2;++k){
+                    IoSet& in = sets[i][k]; IoSet& out = sets[i][2+k];
+                    arena->seek(k*inMax);
+                    createInputBufferMap (in.map,  in.buf,  in.ub,  ctxs[i]->snpe, false, false, 32, arena.get());
+                    arena->seek(2*inMax + k*outMax);
+                    createOutputBufferMap(out.map, out.buf, out.ub, ctxs[i]->snpe, false, 32, arena.get());
+                }
+        }
+        catch(...){ continue; }
+        for(size_t i = 0; i < ctxs.size(); ++i){
+            for(int k=0;k<2;++k){ ctxs[i]->inSet[k] = std::move(sets[i][k]); ctxs[i]->outSet[k] = std::move(sets[i][2+k]); }
+            ctxs[i]->shared = &gShare[r].slots;
+        }
+        f.sharedBytes = arena->capacity(); f.pages = arena->pageKind();
+        gShare[r].arena = std::move(arena);
+    }
+#ifdef __GLIBC__
+    malloc_trim(0);                                         // hand the freed sets back to the kernel
+#endif
+    for(IoShare& sh : gShare)                               // then resident like the sets they replace
+        if(sh.arena) touch(sh.arena->data(), sh.arena->capacity());
+    gPlan.residentAfter = residentBytes();
+    gPlan.applied = true;
+    return gPlan;
+}
+uint64_t ioLivenessFaults(){ return gLiveFaults.load(); }
+
+/* a float user buffer over caller memory for the single input of one runtime ------ */
+static std::unique_ptr<IoSet> wrapInput(RtCtx& c, const float* data, size_t count)
+{
+    const auto names = c.snpe->getInputTensorNames();
+    if(!names || (*names).size() != 1) return nullptr;
+    const char* name = *(*names).begin();
+    auto attr = c.snpe->getInputOutputBufferAttributes(name);
+    if(!attr) return nullptr;
+    const zdl::DlSystem::TensorShape& dims = (*attr)->getDims();
+    if(dims.rank() == 0) return nullptr;
+    std::vector<size_t> strides(dims.rank());
+    size_t stride = sizeof(float);
+    for(size_t i = dims.rank(); i-- > 0; ){ strides[i] = stride; stride *= dims[i]; }
+    if(stride != count*sizeof(float)) return nullptr;
+
+    std::unique_ptr<IoSet> s(new IoSet);
+    zdl::DlSystem::UserBufferEncodingFloat enc;
+    s->ub.push_back(zdl::SNPE::SNPEFactory::getUserBufferFactory().createUserBuffer(
+                        const_cast<float*>(data), stride, strides, &enc));
+    if(!s->ub.back()) return nullptr;
+    s->map.add(name, s->ub.back().get());
+    return s;
+}
+
+bool bindInput(int model, const float* data, size_t count)
+{
+    if(!gCfg.pipeline || !validId(model) || !data || count != inputSize(model)) return false;
+    ModelCtx& mc = *gModels[model]->ctx;
+    std::vector<std::unique_ptr<IoSet>> sets;
+    for(Runtime_t rt : mc.avail){
+        sets.push_back(wrapInput(mc.rt[int(rt)], data, count));
+        if(!sets.back()) return false;
+    }
+    std::lock_guard<std::mutex> lk(gBindM);
+    for(size_t i = 0; i < sets.size(); ++i) mc.rt[int(mc.avail[i])].bound[data] = std::move(sets[i]);
+    return true;
+}
+void unbindInput(int model, const float* data)
+{
+    if(!validId(model)) return;
+    std::unique_ptr<IoSet> drop[3];                         // freed outside the lock
+    std::lock_guard<std::mutex> lk(gBindM);
+    for(int r=0;r<3;++r){
+        auto& b = gModels[model]->ctx->rt[r].bound;
+        auto it = b.find(data);
+        if(it != b.end()){ drop[r] = std::move(it->second); b.erase(it); }
+    }
+}
+
+/* a result carrying the request's identity ---------------------------------------- */
+static Result resultOf(const Request& rq, Status st)
+{
+    Result r; r.status = st; r.model = rq.model; r.runtime = rq.rt;
+    r.released = rq.rel; r.deadline = rq.dl;
+    return r;
+}
+
+/* result cache: frame keys, lookup on submit, store on finish --------------------- */
+// Exact keys hash the frame 8 bytes at a time; tolerant keys are the means of kSigCells
+// equal slices, which sensor noise keeps within the tolerance and a new scene does not.
+static constexpr size_t kSigCells = 64;
+
+template<typename T> static CacheKey cacheKey(const T* p, size_t n, float tol)
+{
+    CacheKey k; k.valid = true;
+    if(tol <= 0.0f){
+        const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+        const size_t bytes = n*sizeof(T);
+        uint64_t h = 1469598103934665603ULL ^ bytes, w;
+        size_t i = 0;
+        for(; i + 8 <= bytes; i += 8){ std::memcpy(&w, b+i, 8); h = (h ^ w)*1099511628211ULL; h ^= h >> 32; }
+        for(; i < bytes; ++i) h = (h ^ b[i])*1099511628211ULL;
+        k.hash = h;
+        return k;
+    }
+    const size_t cells = std::min(n, kSigCells);
+    k.cells.resize(cells);
+    for(size_t c = 0; c < cells; ++c){
+        const size_t a = c*n/cells, e = (c+1)*n/cells;
+        double sum = 0.0;
+        for(size_t i = a; i < e; ++i) sum += p[i];
+        k.cells[c] = float(sum/double(e-a));
+    }
+    return k;
+}
+static bool sameFrame(const CacheKey& a, const CacheKey& b, float tol)
+{
+    if(tol <= 0.0f) return a.hash == b.hash;
+    if(a.cells.size() != b.cells.size()) return false;
+    for(size_t i = 0; i < a.cells.size(); ++i) if(std::fabs(a.cells[i]-b.cells[i]) > tol) return false;
+    return true;
+}
+
+// Completes the request from the cache and returns true on a hit; otherwise leaves the
+// frame's key in rq for finish() to file the result under.
+static bool cacheLookup(Request& rq)
+{
+    Model& m = *gModels[rq.model];
+    const RtCtx& dflt = m.ctx->rt[int(m.ctx->avail[0])];
+    const auto t0 = Clock::now();
+    rq.key = rq.in.camera.data ? cacheKey(rq.in.camera.data, YuvFrameBytes(rq.in.camera.width, rq.in.camera.height),
+                                          m.cfg.cacheTolerance)
+           : rq.in.data        ? cacheKey(rq.in.data, rq.in.count, m.cfg.cacheTolerance)
+                               : cacheKey(dflt.frame.data(), dflt.frame.size(), m.cfg.cacheTolerance);
+    const double keyMs = msBetween(t0, Clock::now());
+    Result res = resultOf(rq, Status::OK);
+    { std::lock_guard<std::mutex> lk(m.cache.m);
+      ResultCache& rc = m.cache;
+      rc.st.lookups++; rc.st.keyMs += keyMs;
+      auto it = std::find_if(rc.lru.begin(), rc.lru.end(),
+                             [&](const CacheEntry& e){ return sameFrame(e.key, rq.key, m.cfg.cacheTolerance); });
+      if(it == rc.lru.end()) return false;
+      double est = m.ctx->prof[int(it->rt)];                  // what the runtime would have spent
+      if(est <= 0.0) est = m.ctx->lat[int(it->rt)].avg;
+      rc.st.hits++; rc.st.savedMs += est; rc.st.freedMs += rc.execMs;
+      res.runtime = it->rt; res.top1 = it->top1;
+      if(m.cfg.keepOutput) res.output = it->output;
+      std::rotate(rc.lru.begin(), it, it+1); }
+    res.cached  = true;
+    res.started = res.finished = res.completed = Clock::now();
+    if(rq.done) rq.done(std::move(res));
+    return true;
+}
+static void cacheStore(const Request& rq, const Result& res)
+{
+    Model& m = *gModels[rq.model];
+    std::lock_guard<std::mutex> lk(m.cache.m);
+    ResultCache& rc = m.cache;
+    const double exec = msBetween(res.started, res.finished);
+    rc.execMs = rc.seen ? 0.9*rc.execMs + 0.1*exec : exec;
+    rc.seen = true;
+    auto it = std::find_if(rc.lru.begin(), rc.lru.end(),
+                           [&](const CacheEntry& e){ return sameFrame(e.key, rq.key, m.cfg.cacheTolerance); });
+    if(it != rc.lru.end()) rc.lru.erase(it);
+    rc.lru.push_front({ rq.key, res.runtime, res.top1, res.output });
+    if(rc.lru.size() > m.cfg.cacheEntries) rc.lru.pop_back();
+}
+
+/* bookkeeping for one finished request, then hand the result over --------------- */
+static void finish(Request& rq, Result&& res)
+{
+    if(res.status == Status::OK){
+        gGauge[int(rq.rt)].done++;
+        gBandit.upd(rq.model, rq.rt, rq.ctx, msBetween(rq.rel, res.completed));
+        gModels[rq.model]->ctx->lat[int(rq.rt)].upd(msBetween(res.started, res.finished));
+        if(rq.key.valid) cacheStore(rq, res);
+    }
+    if(rq.done) rq.done(std::move(res));
+}
+
+/* worker thread: stage → execute → post in sequence, or the accelerator stage when pipelined */
+static void worker(Runtime_t rt)
+{
+    if(gCfg.threadStart) gCfg.threadStart();
+    gWorkerTid[int(rt)] = gettid_();
+    if(gCfg.pipeline){
+        Pipe& P = gPipe[int(rt)];
+        for(;;){
+            Staged s; bool held;
+            { std::unique_lock<std::mutex> lk(P.m);
+              P.cv.wait(lk,[&]{ if(gStop.load()) return true;
+                                if(P.ready.empty()) return false;
+                                const IoSlots& sl = slots(*P.ready.front().c);
+                                return !sl.out[0] || !sl.out[1]; });
+              if(gStop) return;
+              s = std::move(P.ready.front()); P.ready.pop_front();
+              IoSlots& sl = slots(*s.c);
+              s.out = sl.out[0] ? 1 : 0; sl.out[s.out] = s.id;
+              held = s.in < 0 || sl.in[s.in] == s.id; }
+            P.cv.notify_all();                             // stager may run ahead again
+            if(!held) gLiveFaults++;
+            s.t0 = Clock::now(); execBegin(rt, s.t0);
+            s.ok = held && s.c->snpe->execute(s.in < 0 ? *s.inMap : s.c->inSet[s.in].map, s.c->outSet[s.out].map);
+            s.t1 = Clock::now(); execEnd(rt, s.t0, s.t1);
+            { std::lock_guard<std::mutex> lk(P.m);
+              IoSlots& sl = slots(*s.c);
+              if(s.in >= 0 && sl.in[s.in] == s.id) sl.in[s.in] = 0;
+              P.done.push_back(std::move(s)); }
+            P.cv.notify_all();
+        }
+    }
+    for(Request rq; !gStop && queues[int(rt)].pop(rq); ){
+        RtCtx& ctx = gModels[rq.model]->ctx->rt[int(rt)];
+        Result res = resultOf(rq, Status::FAILED);
+        if(!ctx.snpe){                            // runtime not available after all
+            res.completed = Clock::now();
+            finish(rq, std::move(res)); leave(rt);
+            continue;
+        }
+        auto h0 = Clock::now();
+        res.stagedBytes = stageInput(ctx, 0, rq.in, gModels[rq.model]->cfg.norm, &res.prep);
+        res.started = Clock::now(); execBegin(rt, res.started);
+        zdl::DlSystem::TensorMap om;
+        bool ok = ctx.snpe->execute(ctx.input.get(), om);
+        res.finished = Clock::now(); execEnd(rt, res.started, res.finished);
+        if(ok){
+            res.status = Status::OK;
+            res.top1 = postOutput(om, gModels[rq.model]->cfg.keepOutput ? &res.output : nullptr);
+        }
+        res.completed = Clock::now();
+        res.hostMs = msBetween(h0, res.started) + msBetween(res.finished, res.completed);
+        finish(rq, std::move(res));
+        leave(rt);
+    }
+}
+
+/* pipelined: copy the next request's input into a free input set, unless it is bound */
+static void stager(Runtime_t rt)
+{
+    if(gCfg.threadStart) gCfg.threadStart();
+    gHelperTid[int(rt)][0] = gettid_();
+    Pipe& P = gPipe[int(rt)];
+    for(;;){
+        { std::unique_lock<std::mutex> lk(P.m);
+          P.cv.wait(lk,[&]{ return gStop.load() || P.ready.empty(); }); }
+        Request rq;
+        if(gStop || !queues[int(rt)].pop(rq)) return;
+        RtCtx& ctx = gModels[rq.model]->ctx->rt[int(rt)];
+        if(!ctx.snpe){
+            Result res = resultOf(rq, Status::FAILED); res.completed = Clock::now();
+            finish(rq, std::move(res)); leave(rt);
+            continue;
+        }
+        if(const zdl::DlSystem::UserBufferMap* b = boundInput(ctx, rq.in)){
+            Staged s{ std::move(rq), &ctx, -1, -1, b, 0.0, 0, {}, {}, false, PreprocessTimes(), 0 };
+            { std::lock_guard<std::mutex> lk(P.m); s.id = ++P.lastId; P.ready.push_back(std::move(s)); }
+            P.cv.notify_all();
+            continue;
+        }
+        int set; uint64_t id;
+        { std::unique_lock<std::mutex> lk(P.m);
+          IoSlots& sl = slots(ctx);
+          P.cv.wait(lk,[&]{ return gStop.load() || !sl.in[0] || !sl.in[1]; });
+          if(gStop) return;
+          set = sl.in[0] ? 1 : 0; id = sl.in[set] = ++P.lastId; }
+        auto h0 = Clock::now();
+        PreprocessTimes prep;
+        const size_t bytes = stageInput(ctx, set, rq.in, gModels[rq.model]->cfg.norm, &prep);
+        Staged s{ std::move(rq), &ctx, set, -1, nullptr, msBetween(h0, Clock::now()), bytes, {}, {}, false, prep, id };
+        { std::lock_guard<std::mutex> lk(P.m); P.ready.push_back(std::move(s)); }
+        P.cv.notify_all();
+    }
+}
+
+/* pipelined: consume the outputs of executed requests, then release their output set */
+static void poster(Runtime_t rt)
+{
+    if(gCfg.threadStart) gCfg.threadStart();
+    gHelperTid[int(rt)][1] = gettid_();
+    Pipe& P = gPipe[int(rt)];
+    for(;;){
+        Staged s; bool held;
+        { std::unique_lock<std::mutex> lk(P.m);
+          P.cv.wait(lk,[&]{ return gStop.load() || !P.done.empty(); });
+          if(gStop) return;
+          s = std::move(P.done.front()); P.done.pop_front();
+          held = slots(*s.c).out[s.out] == s.id; }
+        if(!held){ gLiveFaults++; s.ok = false; }
+        auto h0 = Clock::now();
+        Result res = resultOf(s.rq, s.ok ? Status::OK : Status::FAILED);
+        res.started = s.t0; res.finished = s.t1; res.stagedBytes = s.bytes; res.prep = s.prep;
+        if(s.ok)
+            res.top1 = postOutput(*s.c, s.c->outSet[s.out],
+                                  gModels[s.rq.model]->cfg.keepOutput ? &res.output : nullptr);
+        res.completed = Clock::now();
+        res.hostMs = s.hostMs + msBetween(h0, res.completed);
+        { std::lock_guard<std::mutex> lk(P.m);
+          IoSlots& sl = slots(*s.c);
+          if(sl.out[s.out] == s.id) sl.out[s.out] = 0; }
+        P.cv.notify_all();
+        finish(s.rq, std::move(res));
+        leave(rt);
+    }
+}
+
+void init(const ServiceConfig& cfg)
+{
+    gCfg = cfg;
+    gRng.seed(cfg.seed);
+}
+
+void start()
+{
+    for(Runtime_t rt:{Runtime_t::CPU,Runtime_t::GPU,Runtime_t::DSP}){
+        gThreads.emplace_back(worker, rt);
+        if(gCfg.pipeline){ gThreads.emplace_back(stager, rt); gThreads.emplace_back(poster, rt); }
+    }
+    auto started = [](){ for(int r=0;r<3;++r)
+                             if(!gWorkerTid[r] || (gCfg.pipeline && (!gHelperTid[r][0] || !gHelperTid[r][1])))
+                                 return false;
+                         return true; };
+    while(!started()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void stop()
+{
+    cancelQueued([](int, Clock::time_point){ return true; });
+    while(gInFlight.load() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    gStop = true; for(auto& q:queues){ { std::lock_guard<std::mutex> lk(q.m); } q.cv.notify_all(); }
+    for(auto& p:gPipe){ { std::lock_guard<std::mutex> lk(p.m); } p.cv.notify_all(); }
+    for(auto& t:gThreads) t.join();
+    gThreads.clear();
+}
+
+/* selectors ---------------------------------------------------------------------- */
+static Runtime_t pickJSQ(const std::vector<Runtime_t>& rts)
+{
+    Runtime_t best=rts[0]; size_t bq=queues[int(best)].size();
+    auto pref = {Runtime_t::DSP,Runtime_t::GPU,Runtime_t::CPU};
+    for(Runtime_t rt:rts){
+        size_t q=queues[int(rt)].size();
+        if(q<bq || (q==bq &&
+           std::find(pref.begin(),pref.end(),rt)<std::find(pref.begin(),pref.end(),best)))
+        { best=rt; bq=q; }
+    }
+    return best;
+}
+static Runtime_t pickDyn(const ModelCtx& mc,const std::vector<Runtime_t>&rts,double slack)
+{
+    for(Runtime_t pref:{Runtime_t::DSP,Runtime_t::GPU,Runtime_t::CPU}){
+        if(std::find(rts.begin(),rts.end(),pref)==rts.end()) continue;
+        double qLat = queues[int(pref)].size()*mc.lat[int(pref)].avg;
+        if(qLat <= slack) return pref;
+    }
+    return pickJSQ(rts);
+}
+
+// UCB on response time: the arm with the lowest optimistic (lower‑confidence) cost
+// wins, so an arm that went stale is re‑sampled once its bonus has grown with the
+// number of decisions. Exploring is only allowed while that arm's mean cost fits the
+// slack; otherwise the arm with the best mean is exploited.
+static Runtime_t pickBandit(int mi,const std::vector<Runtime_t>& rts,double slack)
+{
+    std::lock_guard<std::mutex> lk(gBandit.m);
+    double logN = std::log(double(++gBandit.pulls[mi]));
+    Runtime_t ucb = rts[0], greedy = rts[0];
+    double bestLcb = std::numeric_limits<double>::infinity(), bestMean = bestLcb, ucbMean = 0.0;
+    for(Runtime_t rt:rts){
+        const Arm& a = gBandit.arm[mi][int(rt)][depthCtx(queues[int(rt)].size())];
+        double lcb = a.n ? a.mean() - kUcbC*slack*std::sqrt(2.0*logN/a.n)
+                         : -std::numeric_limits<double>::infinity();
+        if(lcb < bestLcb){ bestLcb = lcb; ucb = rt; ucbMean = a.mean(); }
+        if(a.n && a.mean() < bestMean){ bestMean = a.mean(); greedy = rt; }
+    }
+    return (ucbMean <= slack || bestMean == std::numeric_limits<double>::infinity()) ? ucb : greedy;
+}
+
+static Runtime_t pick(int mi, const std::vector<Runtime_t>& rts, double slack)
+{
+    auto prefer = [&](Runtime_t rt){ return std::find(rts.begin(),rts.end(),rt)!=rts.end() ? rt : rts[0]; };
+    switch(Policy(gPolicy.load())){
+        case Policy::CPU_ONLY:   return prefer(Runtime_t::CPU);
+        case Policy::GPU_ONLY:   return prefer(Runtime_t::GPU);
+        case Policy::DSP_ONLY:   return prefer(Runtime_t::DSP);
+        case Policy::RANDOM:{
+            std::lock_guard<std::mutex> lk(gRngM);
+            return rts[std::uniform_int_distribution<int>(0,int(rts.size())-1)(gRng)];
+        }
+        case Policy::JSQ:        return pickJSQ(rts);
+        case Policy::DYNAMIC:    return pickDyn(*gModels[mi]->ctx, rts, slack);
+        case Policy::STATIC_OPT:{
+            int f = gModels[mi]->fixed;
+            return f < 0 ? rts[0] : prefer(static_cast<Runtime_t>(f));
+        }
+        case Policy::BANDIT:     return pickBandit(mi, rts, slack);
+    }
+    return rts[0];
+}
+
+/* requests ----------------------------------------------------------------------- */
+void submit(int model, InputView in, Clock::time_point deadline, Completion done,
+            Clock::time_point released, int priority)
+{
+    if(released == Clock::time_point()) released = Clock::now();
+    Request rq{ model, Runtime_t::CPU, deadline, released, 0, priority, 0.0, 0.0, in, std::move(done), CacheKey() };
+    if(!validId(model) || gModels[model]->ctx->avail.empty() ||
+       (in.camera.data && (!in.camera.width || !in.camera.height || !cameraInput(model)))){
+        Result res = resultOf(rq, Status::FAILED); res.completed = Clock::now();
+        if(rq.done) rq.done(std::move(res));
+        return;
+    }
+    if(gModels[model]->cfg.cacheEntries && cacheLookup(rq)) return;
+    const ModelCtx& mc = *gModels[model]->ctx;
+    const Runtime_t tgt = pick(model, mc.avail, std::max(0.0, msBetween(released, deadline)));
+    double cost = mc.prof[int(tgt)];
+    if(cost <= 0.0) cost = mc.lat[int(tgt)].avg;
+    rq.rt = tgt; rq.ctx = depthCtx(queues[int(tgt)].size()); rq.cost = cost;
+    queues[int(tgt)].push(std::move(rq));
+}
+
+std::future<Result> submit(int model, InputView in, Clock::time_point deadline,
+                           Clock::time_point released, int priority)
+{
+    auto p = std::make_shared<std::promise<Result>>();
+    std::future<Result> f = p->get_future();
+    submit(model, in, deadline, [p](Result&& r){ p->set_value(std::move(r)); }, released, priority);
+    return f;
+}
+
+size_t cancelQueued(const std::function<bool(int, Clock::time_point)>& pred)
+{
+    std::vector<Request> out;
+    for(auto& q:queues){
+        std::lock_guard<std::mutex> lk(q.m);
+        auto keep = std::stable_partition(q.q.begin(), q.q.end(),
+                        [&](const Request& r){ return !pred(r.model, r.rel); });
+        std::move(keep, q.q.end(), std::back_inserter(out));
+        q.q.erase(keep, q.q.end());
+    }
+    const auto now = Clock::now();
+    for(auto& rq:out){
+        Result res = resultOf(rq, Status::CANCELLED); res.completed = now;
+        if(rq.done) rq.done(std::move(res));
+    }
+    return out.size();
+}
+
+/* result cache ------------------------------------------------------------------- */
+CacheStats cacheStats(int model)
+{
+    if(!validId(model)) return CacheStats{};
+    ResultCache& rc = gModels[model]->cache;
+    std::lock_guard<std::mutex> lk(rc.m);
+    return rc.st;
+}
+void resetCaches()
+{
+    for(auto& m : gModels){
+        std::lock_guard<std::mutex> lk(m->cache.m);
+        m->cache.lru.clear(); m->cache.st = CacheStats{};
+        m->cache.execMs = 0.0; m->cache.seen = false;
+    }
+}
+
+/* policy ------------------------------------------------------------------------- */
+void setPolicy(Policy p){ gPolicy = int(p); }
+void setStaticRuntime(int model, int rt){ if(validId(model)) gModels[model]->fixed = rt < 3 ? rt : -1; }
+void setFairQueuing(bool wfq){ for(auto& q:queues) q.reset(wfq); }
+void resetLearning()
+{
+    gBandit.reset();
+    for(size_t mi=0; mi<gModels.size(); ++mi) gBandit.seed(int(mi), gModels[mi]->ctx->prof);
+    gBandit.resetRun();
+}
+void resetRegret(){ gBandit.resetRun(); }
+
+/* mean per‑completion regret [ms] of this run against the best learned arm of the context;
+   an arm that beat it this run adds none */
+double banditRegret(const std::vector<int>& models)
+{
+    std::lock_guard<std::mutex> lk(gBandit.m);
+    double reg = 0.0; uint64_t n = 0;
+    for(int mi : models){
+        if(mi < 0 || mi >= kMaxModels) continue;
+        for(int c=0;c<kCtx;++c){
+            double best = std::numeric_limits<double>::infinity();
+            for(int r=0;r<3;++r){ const Arm& a = gBandit.arm[mi][r][c]; if(a.n) best = std::min(best,a.mean()); }
+            for(int r=0;r<3;++r){ const Arm& a = gBandit.run[mi][r][c];
+                                  if(a.n){ reg += a.n*std::max(0.0, a.mean()-best); n += a.n; } }
+        }
+    }
+    return n ? reg/n : 0.0;
+}
+
+/* introspection ------------------------------------------------------------------ */
+RuntimeGauge gauge(Runtime_t rt, Clock::time_point now)
+{
+    const RtGauge& g = gGauge[int(rt)];
+    int64_t s = g.execSince;
+    return { g.busyNs + (s ? ticks(now)-s : 0), g.done.load(), g.inFlight.load(), queues[int(rt)].size() };
+}
+int inFlight(){ return gInFlight.load(); }
+std::vector<pid_t> threadIds(Runtime_t rt)
+{
+    std::vector<pid_t> t{ gWorkerTid[int(rt)].load() };
+    if(gCfg.pipeline) for(auto& h : gHelperTid[int(rt)]) t.push_back(h.load());
+    return t;
+}
+
+} // namespace dsched
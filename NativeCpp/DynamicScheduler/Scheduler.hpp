@@ -0,0 +1,171 @@
+// Scheduler.hpp – in‑process inference service: preloaded models, per‑runtime worker
+//                 threads and the runtime selection policies of the benchmark
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "DlSystem/DlEnums.hpp"
+#include "YuvPreprocess.hpp"
+
+namespace dsched {
+
+using Clock     = std::chrono::steady_clock;
+using Runtime_t = zdl::DlSystem::Runtime_t;
+
+constexpr int kMaxModels = 64;   // registered models
+
+enum class Policy : int { CPU_ONLY, GPU_ONLY, DSP_ONLY, RANDOM, JSQ, DYNAMIC, STATIC_OPT, BANDIT };
+const char* policyName(Policy p);
+const char* runtimeName(Runtime_t rt);
+
+struct ServiceConfig {
+    bool     pipeline = false;   // double‑buffered stage / execute / post threads per runtime
+    uint32_t seed     = 1;       // RANDOM policy
+    std::function<void()> threadStart;   // run first on every service thread (real‑time setup)
+};
+
+struct ModelConfig {
+    std::string dlc;             // loaded with init caching on every available runtime; models
+                                 // registered with the same container share its runtime contexts
+    std::string inputList;       // first entry is the default frame (first registration of a dlc)
+    double      weight = 1.0;    // share of runtime time under weighted fair queuing
+    bool        keepOutput = false;   // copy the output tensors into Result::output
+    size_t      cacheEntries = 0;     // result cache: frames remembered (LRU), 0 = off
+    float       cacheTolerance = 0.0f;   // 0: a hit needs the same bytes (64‑bit hash); > 0: the
+                                         // means of 64 slices of the frame within this tolerance
+                                         // (of its YUV bytes for a camera frame)
+    PixelNormalization norm;     // camera frames: (pixel − mean) · scale per channel
+};
+
+// count floats at data, read while the request is staged; they must stay valid until it
+// completes. An empty view runs the model's default frame. A camera frame (camera.data
+// set) is converted, resized to the input and normalized while staged, straight into the
+// input buffer; the model needs a single H×W×3 input.
+struct InputView { const float* data = nullptr; size_t count = 0; YuvFrame camera; };
+
+enum class Status { OK, CANCELLED, FAILED };
+
+struct Result {
+    Status    status  = Status::FAILED;
+    int       model   = -1;
+    Runtime_t runtime = Runtime_t::CPU;
+    Clock::time_point released, deadline;
+    Clock::time_point started, finished;   // execute()
+    Clock::time_point completed;           // after post‑processing (or cancellation)
+    double    hostMs  = 0.0;               // staging + post‑processing
+    size_t    stagedBytes = 0;             // input copied before execute(), 0 for a bound input
+    PreprocessTimes prep;                  // camera frame stages, part of hostMs
+    int       top1    = -1;                // argmax over all outputs
+    std::vector<float> output;             // all outputs back to back, with keepOutput
+    bool      cached  = false;             // from the result cache: nothing staged or executed
+    bool late() const { return completed > deadline; }
+};
+// Called on the worker (or poster) thread of the runtime, on the thread that cancels the
+// request, or inside submit() for a cache hit; keep it short, it holds up the next
+// request of that runtime.
+using Completion = std::function<void(Result&&)>;
+
+/* setup -------------------------------------------------------------------------- */
+// Selects the buffer mode and seeds the RANDOM policy; call first, once per process.
+void init(const ServiceConfig& cfg = ServiceConfig());
+// Loads, profiles and preallocates the buffers of a model; call before start(). Returns
+// the model id, or -1 if the container is missing, no runtime accepted it or the
+// registry is full.
+int  registerModel(const ModelConfig& cfg);
+const std::vector<Runtime_t>& availableRuntimes(int model);
+std::array<double,3> profiledLatency(int model);   // mean execute() [ms], < 0 = unavailable
+size_t inputSize(int model);                        // floats of the input tensor, 0 = unknown model
+bool   cameraInput(int model);                      // single H×W×3 input: takes camera frames
+// Writes every page of the preallocated frames and input / output buffers once, so the
+// first requests do not page‑fault; call after registering (and planIo()) and before
+// start(). Returns the bytes touched.
+size_t prefault();
+
+// A runtime executes one request at a time, yet with pipeline every model on it keeps two
+// input and two output user‑buffer sets of its own. planIo() sizes one arena per runtime
+// by the largest input set and the largest output set of its models and rebuilds every
+// model's sets over it, set k of each at the same offset. The four sets then belong to
+// the runtime: an input set is restaged only after the request it held executed, an
+// output set is written again only after the poster consumed it, and every stage checks
+// that its request still holds the set before touching it (a request that does not is
+// failed and counted in ioLivenessFaults()). Call once, after registering and before
+// prefault() and start(). A runtime with a single model keeps its own sets; in serial
+// mode there are no user buffers and nothing is planned.
+struct IoFootprint {
+    int         models = 0;        // contexts (containers) on the runtime
+    size_t      ownBytes = 0;      // their input and output sets, each model its own
+    size_t      sharedBytes = 0;   // after planning: the arena, or ownBytes if not shared
+    const char* pages = "";        // page size backing the arena
+};
+struct IoPlan {
+    bool applied = false;
+    std::array<IoFootprint,3> rt;  // CPU, GPU, DSP
+    size_t residentBefore = 0, residentAfter = 0;   // process resident bytes around the rebuild
+};
+IoPlan   planIo(bool hugePages = false);
+uint64_t ioLivenessFaults();
+
+// Frame memory of the caller that the runtimes read in place. With pipeline, a request
+// whose InputView starts at a bound pointer executes straight from it instead of being
+// copied into an input set. count must equal inputSize(model); returns false without
+// user buffers (serial mode), where such a frame is copied like any other. Unbind only
+// when no request on that memory is queued or in flight. Both are safe while running.
+bool bindInput(int model, const float* data, size_t count);
+void unbindInput(int model, const float* data);
+
+// Starts one worker per runtime, plus stager and poster with pipeline.
+void start();
+// Cancels what is queued, waits for the requests in flight, then joins the threads.
+void stop();
+
+/* requests ----------------------------------------------------------------------- */
+// Queue one inference on the runtime the current policy picks. released (default now)
+// is where the response time and the slack to the absolute deadline are measured from.
+// A runtime serves its queued requests of higher priority first, in FIFO or WFQ order
+// among equal priorities.
+std::future<Result> submit(int model, InputView in, Clock::time_point deadline,
+                           Clock::time_point released = Clock::time_point(), int priority = 0);
+void submit(int model, InputView in, Clock::time_point deadline, Completion done,
+            Clock::time_point released = Clock::time_point(), int priority = 0);
+
+// Removes the queued requests pred(model, released) selects and completes them as
+// CANCELLED. Returns their number.
+size_t cancelQueued(const std::function<bool(int, Clock::time_point)>& pred);
+
+/* result cache ------------------------------------------------------------------- */
+// Per model, with ModelConfig::cacheEntries. submit() looks the frame up and completes a
+// hit at once with the runtime, top‑1 and output of the request that computed it.
+// savedMs adds the execute‑time estimate (profile) of the runtime that computed the
+// result per hit, freedMs the model's measured mean execute() time (runtime time the
+// hit did not use); keyMs is what keying the frames cost the submitting threads.
+struct CacheStats { uint64_t lookups, hits; double savedMs, freedMs, keyMs; };
+CacheStats cacheStats(int model);
+void resetCaches();                         // forget every cached result, zero the statistics
+
+/* policy ------------------------------------------------------------------------- */
+void setPolicy(Policy p);
+void setStaticRuntime(int model, int rt);   // STATIC_OPT target (0=CPU 1=GPU 2=DSP), < 0 = first available
+void setFairQueuing(bool wfq);              // FIFO or WFQ runtime queues; resets the virtual time
+void resetLearning();                       // re‑seed the BANDIT arms from the profile
+void resetRegret();                         // start a new run for banditRegret(); the arms keep learning
+double banditRegret(const std::vector<int>& models);   // mean per‑completion regret [ms] since resetRegret()
+
+/* introspection ------------------------------------------------------------------ */
+struct RuntimeGauge { int64_t busyNs; uint64_t done; int inFlight; size_t queued; };
+RuntimeGauge gauge(Runtime_t rt, Clock::time_point now = Clock::now());   // busyNs includes a running execute()
+int    inFlight();                           // staged or executing, all runtimes
+std::vector<pid_t> threadIds(Runtime_t rt);  // worker, then stager and poster with pipeline
+
+} // namespace dsched
+
+#endif // SCHEDULER_H
@@ -0,0 +1,92 @@
+// ShmRing.hpp – shared‑memory frame ring between a producer process and the daemon (-D)
+#ifndef SHMRING_H
+#define SHMRING_H
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// One memfd region per ATTACH, mapped by both processes:
+//
+//   RingLayout | pad to page | slot 0 | slot 1 | …     (each slot frameBytes, page aligned)
+//
+// The producer owns a slot until it submits it and again once its completion arrives;
+// the daemon hands the slot to the runtimes as bound user‑buffer memory (bindInput), so
+// the frame is never copied. At most `slots` frames are outstanding, so neither
+// direction can overflow. Both directions are single‑producer single‑consumer rings
+// (the daemon serialises its completions); a consumer that finds its ring empty raises
+// `sleeping` and waits on the head word with a futex, so a busy ring costs no syscalls.
+constexpr uint32_t kRingMagic    = 0x44535247;   // "DSRG"
+constexpr uint32_t kMaxRingSlots = 64;
+constexpr size_t   kRingPage     = 4096;
+
+struct RingSub { uint64_t seq; uint32_t slot; int32_t priority; int64_t releasedNs, deadlineNs; };
+struct RingCom { uint64_t seq; uint32_t slot; int32_t status;              // DaemonStatus
+                 int32_t runtime, top1; uint64_t stagedBytes;              // 0 = executed in place
+                 int64_t startedNs, finishedNs, completedNs; };
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "ring indices must be lock‑free to be shared");
+
+struct alignas(64) RingDir {
+    std::atomic<uint32_t> head;                  // written by the producer side, futex word
+    char pad0[60];
+    std::atomic<uint32_t> tail;                  // written by the consumer side
+    std::atomic<uint32_t> sleeping;              // consumer waits on head
+    char pad1[56];
+};
+
+struct RingLayout {
+    uint32_t magic, slots, frameFloats, reserved;
+    uint64_t frameBytes, framesOffset;           // slot stride and offset of slot 0
+    RingDir  sub, com;                           // producer → daemon, daemon → producer
+    RingSub  subq[kMaxRingSlots];
+    RingCom  comq[kMaxRingSlots];
+
+    // client side: the daemon keeps the geometry it made and never trusts these fields
+    float* frame(uint32_t slot){
+        return reinterpret_cast<float*>(reinterpret_cast<char*>(this) + framesOffset + slot*frameBytes); }
+};
+
+inline size_t ringPageAlign(size_t n){ return (n + kRingPage - 1) & ~(kRingPage - 1); }
+inline size_t ringBytes(uint32_t slots, size_t frameFloats){
+    return ringPageAlign(sizeof(RingLayout)) + slots*ringPageAlign(frameFloats*sizeof(float)); }
+
+// The region is MAP_SHARED between processes, so the futex must not be process‑private.
+inline void ringFutexWake(std::atomic<uint32_t>& w){
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&w), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0); }
+inline void ringFutexWait(std::atomic<uint32_t>& w, uint32_t seen, int timeoutMs){
+    timespec ts{ timeoutMs/1000, long(timeoutMs%1000)*1000000L };
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&w), FUTEX_WAIT, seen, &ts, nullptr, 0); }
+
+template<class T> void ringPush(RingDir& d, T* q, const T& e)
+{
+    const uint32_t h = d.head.load(std::memory_order_relaxed);
+    q[h % kMaxRingSlots] = e;
+    d.head.store(h + 1);                         // seq_cst: ordered against the sleeping load
+    if(d.sleeping.load()) ringFutexWake(d.head);
+}
+
+// false if the ring stayed empty for timeoutMs (0 = do not wait)
+template<class T> bool ringPop(RingDir& d, const T* q, T& e, int timeoutMs)
+{
+    const uint32_t t = d.tail.load(std::memory_order_relaxed);
+    uint32_t h = d.head.load(std::memory_order_acquire);
+    if(h == t && timeoutMs > 0){
+        d.sleeping.store(1);
+        if(d.head.load() == t) ringFutexWait(d.head, t, timeoutMs);
+        d.sleeping.store(0);
+        h = d.head.load(std::memory_order_acquire);
+    }
+    if(h == t) return false;
+    e = q[t % kMaxRingSlots];
+    d.tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+#endif // SHMRING_H
@@ -0,0 +1,156 @@
+// StaticAssign.cpp – offline model → runtime placement for periodic workloads
+#include "StaticAssign.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+static constexpr double kInf = std::numeric_limits<double>::infinity();
+
+static bool usable(const AssignLoad& l, int r){ return l.latMs[r] >= 0.0; }
+
+/* cost ----------------------------------------------------------------------------- */
+// MAX_UTIL: busiest runtime's utilization, ties broken towards less total work.
+// EXP_MISS: expected missed releases per second. Each runtime is an M/G/1 queue with
+//           deterministic per‑model service; a saturated runtime misses everything,
+//           otherwise P(wait > D‑s) ≈ ρ·exp(−(D‑s)·ρ/W) with W from Pollaczek–Khinchine.
+// MAX_UTIL only grows when a model is added, so a partial cost bounds its completions.
+// EXP_MISS does not: a light, high‑rate model raises ρ and with it W, which can lower the
+// miss probability of the models already there (see lowerBound()).
+double assignmentCost(const std::vector<AssignLoad>& loads, const std::vector<int>& rt,
+                      AssignObjective obj)
+{
+    std::array<double,3> rho{}, s2{};
+    for(size_t i=0;i<loads.size();++i){
+        if(rt[i] < 0) continue;
+        double s = loads[i].latMs[rt[i]]/1000.0;
+        rho[rt[i]] += loads[i].rate*s;
+        s2 [rt[i]] += loads[i].rate*s*s;
+    }
+    if(obj == AssignObjective::MAX_UTIL)
+        return *std::max_element(rho.begin(),rho.end()) + 1e-3*(rho[0]+rho[1]+rho[2]);
+
+    double miss = 0.0;
+    for(size_t i=0;i<loads.size();++i){
+        int r = rt[i]; if(r < 0) continue;
+        const double s = loads[i].latMs[r]/1000.0, d = loads[i].deadlineMs/1000.0;
+        double p;
+        if(rho[r] >= 1.0 || s >= d) p = 1.0;
+        else {
+            double w = s2[r]/(2.0*(1.0-rho[r]));
+            p = (w > 0.0) ? rho[r]*std::exp(-(d-s)*rho[r]/w) : 0.0;
+        }
+        miss += loads[i].rate*p;
+    }
+    return miss;
+}
+
+/* greedy + local search ------------------------------------------------------------ */
+static void localSearch(const std::vector<AssignLoad>& L, std::vector<int>& rt,
+                        double& cost, AssignObjective obj)
+{
+    for(bool improved=true; improved; ){
+        improved = false;
+        for(size_t i=0;i<L.size();++i){                       // single moves
+            if(rt[i] < 0) continue;
+            for(int r=0;r<3;++r){
+                if(r==rt[i] || !usable(L[i],r)) continue;
+                int old = rt[i]; rt[i] = r;
+                double c = assignmentCost(L,rt,obj);
+                if(c < cost - 1e-12){ cost = c; improved = true; } else rt[i] = old;
+            }
+        }
+        for(size_t i=0;i<L.size();++i)                          // pairwise swaps
+            for(size_t j=i+1;j<L.size();++j){
+                if(rt[i]<0 || rt[j]<0 || rt[i]==rt[j]) continue;
+                if(!usable(L[i],rt[j]) || !usable(L[j],rt[i])) continue;
+                std::swap(rt[i],rt[j]);
+                double c = assignmentCost(L,rt,obj);
+                if(c < cost - 1e-12){ cost = c; improved = true; } else std::swap(rt[i],rt[j]);
+            }
+    }
+}
+
+static double minLoad(const AssignLoad& l)
+{
+    double m = kInf;
+    for(int r=0;r<3;++r) if(usable(l,r)) m = std::min(m, l.rate*l.latMs[r]);
+    return m==kInf ? 0.0 : m;
+}
+
+/* branch‑and‑bound ----------------------------------------------------------------- */
+// Cost no completion of the partial assignment cur can go below. For EXP_MISS only the
+// misses that adding models cannot undo count: every release of a model that does not
+// fit its deadline (s ≥ D) or sits on a saturated runtime (ρ only grows), and of every
+// unplaced model that fits nowhere.
+static double lowerBound(const std::vector<AssignLoad>& L, const std::vector<int>& cur, AssignObjective obj)
+{
+    if(obj == AssignObjective::MAX_UTIL) return assignmentCost(L,cur,obj);
+    std::array<double,3> rho{};
+    for(size_t i=0;i<L.size();++i) if(cur[i] >= 0) rho[cur[i]] += L[i].rate*L[i].latMs[cur[i]]/1000.0;
+    double miss = 0.0;
+    for(size_t i=0;i<L.size();++i){
+        if(cur[i] >= 0){
+            if(rho[cur[i]] >= 1.0 || L[i].latMs[cur[i]] >= L[i].deadlineMs) miss += L[i].rate;
+            continue;
+        }
+        bool fits = false;
+        for(int r=0;r<3;++r) fits |= usable(L[i],r) && L[i].latMs[r] < L[i].deadlineMs;
+        if(!fits && (usable(L[i],0) || usable(L[i],1) || usable(L[i],2))) miss += L[i].rate;
+    }
+    return miss;
+}
+
+static void branch(const std::vector<AssignLoad>& L, const std::vector<size_t>& order, size_t k,
+                   std::vector<int>& cur, std::vector<int>& best, double& bestCost, AssignObjective obj)
+{
+    if(k == order.size()){
+        double c = assignmentCost(L,cur,obj);
+        if(c < bestCost){ bestCost = c; best = cur; }
+        return;
+    }
+    size_t i = order[k];
+    if(!usable(L[i],0) && !usable(L[i],1) && !usable(L[i],2)){
+        branch(L,order,k+1,cur,best,bestCost,obj); return;
+    }
+    for(int r : {2,1,0}){                                       // DSP first: usually the cheapest
+        if(!usable(L[i],r)) continue;
+        cur[i] = r;
+        if(lowerBound(L,cur,obj) < bestCost)
+            branch(L,order,k+1,cur,best,bestCost,obj);
+        cur[i] = -1;
+    }
+}
+
+Assignment solveStaticAssignment(const std::vector<AssignLoad>& loads, AssignObjective obj,
+                                 size_t exactLimit)
+{
+    const size_t n = loads.size();
+    std::vector<size_t> order(n);
+    std::iota(order.begin(),order.end(),0);
+    std::stable_sort(order.begin(),order.end(),
+                     [&](size_t a,size_t b){ return minLoad(loads[a]) > minLoad(loads[b]); });
+
+    Assignment A; A.rt.assign(n,-1);
+    for(size_t i : order){                                      // greedy, heaviest first
+        double bc = kInf; int br = -1;
+        for(int r=0;r<3;++r){
+            if(!usable(loads[i],r)) continue;
+            A.rt[i] = r;
+            double c = assignmentCost(loads,A.rt,obj);
+            if(c < bc){ bc = c; br = r; }
+        }
+        A.rt[i] = br;
+    }
+    A.cost = assignmentCost(loads,A.rt,obj);
+    localSearch(loads,A.rt,A.cost,obj);
+
+    if(n <= exactLimit){
+        std::vector<int> cur(n,-1), best = A.rt;
+        double bestCost = A.cost + 1e-12;                       // incumbent from local search
+        branch(loads,order,0,cur,best,bestCost,obj);
+        A.rt = best; A.cost = assignmentCost(loads,A.rt,obj); A.exact = true;
+    }
+    return A;
+}
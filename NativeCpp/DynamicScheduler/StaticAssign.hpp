@@ -0,0 +1,34 @@
+// StaticAssign.hpp – offline model → runtime placement for periodic workloads
+#ifndef STATICASSIGN_H
+#define STATICASSIGN_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// one periodic model as seen by the solver
+struct AssignLoad {
+    double rate;                 // expected releases per second (fps · scale · prob)
+    double deadlineMs;           // relative deadline of one release
+    std::array<double,3> latMs;  // profiled latency per runtime (0=CPU 1=GPU 2=DSP), < 0 = unavailable
+};
+
+enum class AssignObjective : int { MAX_UTIL, EXP_MISS };
+
+struct Assignment {
+    std::vector<int> rt;         // runtime index per model, -1 if no runtime is available
+    double cost  = 0.0;          // value of the objective for rt
+    bool   exact = false;        // true if proven optimal by branch‑and‑bound
+};
+
+// Exhaustive branch‑and‑bound for up to exactLimit models, greedy construction
+// followed by move/swap local search for larger scenarios.
+Assignment solveStaticAssignment(const std::vector<AssignLoad>& loads,
+                                 AssignObjective obj = AssignObjective::MAX_UTIL,
+                                 size_t exactLimit = 12);
+
+// objective of a (possibly partial, -1 entries ignored) assignment
+double assignmentCost(const std::vector<AssignLoad>& loads, const std::vector<int>& rt,
+                      AssignObjective obj);
+
+#endif
@@ -0,0 +1,152 @@
+// Topology.cpp – CPU topology discovery and thread placement for the scheduler
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include <sched.h>
+
+static bool readLine(const std::string& path, std::string& line)
+{
+    std::ifstream in(path);
+    return in && std::getline(in, line);
+}
+
+static long readLong(const std::string& path, long dflt)
+{
+    std::string s;
+    return readLine(path, s) && !s.empty() ? std::strtol(s.c_str(), nullptr, 10) : dflt;
+}
+
+// "0-3,6,8-9" → {0,1,2,3,6,8,9}; false for a reversed range or a CPU outside
+// [0, CPU_SETSIZE), checked before the range is expanded
+static bool parseCpuList(const std::string& s, std::vector<int>& out)
+{
+    out.clear();
+    std::stringstream ss(s); std::string tok;
+    while(std::getline(ss, tok, ',')){
+        if(tok.empty()) continue;
+        auto dash = tok.find('-');
+        long a = std::strtol(tok.c_str(), nullptr, 10);
+        long b = dash==std::string::npos ? a : std::strtol(tok.c_str()+dash+1, nullptr, 10);
+        if(a < 0 || b < a || b >= CPU_SETSIZE) return false;
+        for(long c=a;c<=b;++c) out.push_back(int(c));
+    }
+    return true;
+}
+
+std::string cpuListStr(const std::vector<int>& cpus)
+{
+    if(cpus.empty()) return "any";
+    std::ostringstream o;
+    for(size_t i=0;i<cpus.size();){
+        size_t j=i; while(j+1<cpus.size() && cpus[j+1]==cpus[j]+1) ++j;
+        o<<(i?",":"")<<cpus[i]; if(j>i) o<<'-'<<cpus[j];
+        i=j+1;
+    }
+    return o.str();
+}
+
+std::vector<CpuInfo> readCpuTopology(const std::string& root)
+{
+    std::string line;
+    std::vector<int> online, iso;
+    if(!readLine(root+"/online", line) || !parseCpuList(line, online)) online = {0};
+    std::set<int> isolated;
+    if(readLine(root+"/isolated", line) && parseCpuList(line, iso)) isolated.insert(iso.begin(), iso.end());
+
+    std::vector<CpuInfo> cpus;
+    for(int id:online){
+        std::string d = root+"/cpu"+std::to_string(id);
+        cpus.push_back({ id,
+                         int(readLong(d+"/topology/cluster_id", -1)),
+                         int(readLong(d+"/cpu_capacity", 0)),
+                         readLong(d+"/cpufreq/cpuinfo_max_freq", 0),
+                         0, isolated.count(id)>0 });
+    }
+    std::set<std::pair<int,long>> keys;
+    for(auto& c:cpus) keys.insert({c.capacity, c.maxKHz});
+    for(auto& c:cpus) c.cls = int(std::distance(keys.begin(), keys.find({c.capacity, c.maxKHz})));
+    return cpus;
+}
+
+void printCpuTopology(const std::vector<CpuInfo>& cpus)
+{
+    std::cout<<"=== CPU topology ("<<cpus.size()<<" online) ===\n";
+    for(auto& c:cpus)
+        std::cout<<"  cpu"<<c.id<<"  class "<<c.cls<<"  cluster "<<c.clusterId
+                 <<"  capacity "<<c.capacity<<"  max "<<c.maxKHz/1000<<" MHz"
+                 <<(c.isolated?"  isolated":"")<<"\n";
+}
+
+static std::vector<int> ofClass(const std::vector<CpuInfo>& cpus, int lo, int hi)
+{
+    std::vector<int> v;
+    for(auto& c:cpus) if(c.cls>=lo && c.cls<=hi) v.push_back(c.id);
+    return v;
+}
+
+static void erase(std::vector<int>& v, int id){ v.erase(std::remove(v.begin(),v.end(),id), v.end()); }
+
+static bool autoPlacement(const std::vector<CpuInfo>& cpus, Placement& p)
+{
+    int top = 0; for(auto& c:cpus) top = std::max(top, c.cls);
+    std::vector<int> little = ofClass(cpus, 0, 0);
+    std::vector<int> big    = top>0 ? ofClass(cpus, 1, top) : ofClass(cpus, 0, 0);
+
+    // dispatcher: an isolated core if the kernel has one, else a spare core that the
+    // workers give up – a middle‑class core, the last little core, or the last core
+    int disp = -1;
+    for(auto& c:cpus) if(c.isolated){ disp = c.id; break; }
+    if(disp < 0){
+        if(top >= 2)                 disp = ofClass(cpus, 1, 1).front();
+        else if(little.size() >= 2)  disp = little.back();
+        else if(cpus.size() >= 3)    disp = cpus.back().id;
+    }
+    if(disp >= 0){ erase(little, disp); erase(big, disp); p.dispatcher = {disp}; }
+
+    if(top == 0){
+        // homogeneous cores: keep one core for the submit‑only accelerator workers
+        if(big.size() >= 2){ little = {big.back()}; big.pop_back(); }
+        else little = big;
+    }
+    if(little.empty()) little = big;
+    p.worker[0] = big;
+    p.worker[1] = p.worker[2] = little;
+    return !big.empty();
+}
+
+bool makePlacement(const std::string& spec, const std::vector<CpuInfo>& cpus, Placement& p)
+{
+    p = Placement(); p.name = spec;
+    if(spec == "legacy"){ p.worker[0] = {0}; p.worker[1] = {1}; p.worker[2] = {2}; return true; }
+    if(spec == "auto")  return autoPlacement(cpus, p);
+
+    std::stringstream ss(spec); std::string role;
+    while(std::getline(ss, role, ':')){
+        auto eq = role.find('=');
+        if(eq == std::string::npos) return false;
+        std::string k = role.substr(0,eq);
+        std::vector<int> set;
+        if(!parseCpuList(role.substr(eq+1), set)) return false;     // CPU_SET is undefined beyond
+        if     (k=="cpu")  p.worker[0]    = set;
+        else if(k=="gpu")  p.worker[1]    = set;
+        else if(k=="dsp")  p.worker[2]    = set;
+        else if(k=="disp") p.dispatcher   = set;
+        else return false;
+    }
+    return true;
+}
+
+bool pinThread(pid_t tid, const std::vector<int>& cpus, const std::vector<CpuInfo>& online)
+{
+    cpu_set_t s; CPU_ZERO(&s);
+    for(int c:cpus) if(c < 0 || c >= CPU_SETSIZE) return false;
+    if(cpus.empty()){ for(auto& c:online) if(c.id >= 0 && c.id < CPU_SETSIZE) CPU_SET(c.id, &s); }
+    else              for(int c:cpus)     CPU_SET(c, &s);
+    return sched_setaffinity(tid, sizeof(s), &s) == 0;
+}
@@ -0,0 +1,43 @@
+// Topology.hpp – CPU topology discovery and thread placement for the scheduler
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+struct CpuInfo {
+    int  id;
+    int  clusterId;      // topology/cluster_id, -1 if the kernel does not export it
+    int  capacity;       // cpu_capacity (1024 = biggest core), 0 if unknown
+    long maxKHz;         // cpufreq/cpuinfo_max_freq, 0 if unknown
+    int  cls;            // capacity class, 0 = littlest … n‑1 = biggest
+    bool isolated;       // listed in /sys/devices/system/cpu/isolated
+};
+
+// Online CPUs read from sysfs, classified by (capacity, max frequency).
+std::vector<CpuInfo> readCpuTopology(const std::string& root = "/sys/devices/system/cpu");
+void printCpuTopology(const std::vector<CpuInfo>& cpus);
+
+// CPU sets per thread role; an empty set leaves that thread unpinned.
+struct Placement {
+    std::string name;
+    std::array<std::vector<int>,3> worker;   // 0=CPU 1=GPU 2=DSP runtime worker
+    std::vector<int> dispatcher;
+};
+
+// legacy : the old hard‑coded CPU/GPU/DSP → cores 0/1/2, dispatcher unpinned
+// auto   : CPU runtime on the big cores, submit‑only GPU/DSP workers on the little
+//          cores, dispatcher alone on an isolated (or otherwise spare) core
+// spec   : explicit "cpu=4-7:gpu=0-1:dsp=0-1:disp=3", omitted roles stay unpinned;
+//          false for a reversed range or a CPU id outside [0, CPU_SETSIZE)
+bool makePlacement(const std::string& spec, const std::vector<CpuInfo>& cpus, Placement& out);
+std::string cpuListStr(const std::vector<int>& cpus);
+
+// sched_setaffinity on a thread id (0 = calling thread); empty set = all online CPUs.
+// False, leaving the affinity alone, for a CPU id outside [0, CPU_SETSIZE).
+bool pinThread(pid_t tid, const std::vector<int>& cpus, const std::vector<CpuInfo>& online);
+
+#endif
@@ -0,0 +1,616 @@
+// YuvPreprocess.cpp – NV21 / NV12 to RGB, bilinear resize and normalization kernels
+#include "YuvPreprocess.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define YUV_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define YUV_TARGET(isa)
+#else
+#include <cpuid.h>
+#define YUV_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define YUV_NEON
+#include <arm_neon.h>
+#endif
+
+// Kernels -----------------------------------------------------------------------------------
+// YUV to RGB is integer arithmetic, so every kernel gives the same bytes. The float kernels
+// compute the same expressions element by element, without fused multiply-adds on x86-64;
+// a compiler contracting the scalar ones (the AArch64 default) can differ in the last bit.
+// The vector kernels handle whole vectors and leave the tail to the scalar ones.
+namespace
+{
+struct YuvKernels
+{
+    const char* name;
+    // One row of width pixels: luma y and chroma pairs uv (U first when uFirst) to RGB bytes
+    void (*toRgb)(uint8_t* rgb, const uint8_t* y, const uint8_t* uv, size_t width, bool uFirst);
+    // out[k] = row[i0[k]] + (row[i1[k]] - row[i0[k]]) * w[k]; row is read up to 3 bytes past i0 / i1
+    void (*horizontal)(float* out, const uint8_t* row, const int32_t* i0, const int32_t* i1, const float* w, size_t n);
+    // out = a + (b - a) * w
+    void (*vertical)(float* out, const float* a, const float* b, size_t n, float w);
+    // out[3p + c] = (in[3p + c] - mean[c]) * scale[c]
+    void (*normalize)(float* out, const float* in, size_t pixels, const float* mean, const float* scale);
+};
+
+// BT.601 limited range in 8-bit fixed point: 298 = 1.164 * 256, and so on
+const int kYScale = 298, kRv = 409, kGu = -100, kGv = -208, kBu = 516;
+
+inline uint8_t clampByte(int v)
+{
+    return static_cast<uint8_t>(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+void toRgbScalar(uint8_t* rgb, const uint8_t* y, const uint8_t* uv, size_t width, bool uFirst)
+{
+    for (size_t x = 0; x < width; ++x)
+    {
+        const uint8_t* pair = uv + (x & ~size_t(1));
+        const int c = kYScale * (y[x] - 16) + 128;
+        const int u = pair[uFirst ? 0 : 1] - 128;
+        const int v = pair[uFirst ? 1 : 0] - 128;
+        rgb[3 * x]     = clampByte((c + kRv * v) >> 8);
+        rgb[3 * x + 1] = clampByte((c + kGu * u + kGv * v) >> 8);
+        rgb[3 * x + 2] = clampByte((c + kBu * u) >> 8);
+    }
+}
+
+void horizontalScalar(float* out, const uint8_t* row, const int32_t* i0, const int32_t* i1, const float* w, size_t n)
+{
+    for (size_t k = 0; k < n; ++k)
+    {
+        const float a = row[i0[k]];
+        out[k] = a + (static_cast<float>(row[i1[k]]) - a) * w[k];
+    }
+}
+
+void verticalScalar(float* out, const float* a, const float* b, size_t n, float w)
+{
+    for (size_t k = 0; k < n; ++k) out[k] = a[k] + (b[k] - a[k]) * w;
+}
+
+void normalizeScalar(float* out, const float* in, size_t pixels, const float* mean, const float* scale)
+{
+    for (size_t p = 0; p < pixels; ++p)
+        for (int c = 0; c < 3; ++c) out[3 * p + c] = (in[3 * p + c] - mean[c]) * scale[c];
+}
+
+// mean and scale repeated over 24 floats, so any vector of 4 or 8 starting at a multiple of
+// 12 or 24 lines up with its channels
+void periodic(const float* mean, const float* scale, float* m, float* s)
+{
+    for (int i = 0; i < 24; ++i)
+    {
+        m[i] = mean[i % 3];
+        s[i] = scale[i % 3];
+    }
+}
+
+const YuvKernels kScalarKernels = {
+    "scalar", toRgbScalar, horizontalScalar, verticalScalar, normalizeScalar
+};
+
+#ifdef YUV_X86
+inline int load32(const uint8_t* p)
+{
+    int v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// R, G, B of four pixels in int32 lanes to bytes R0..R3 G0..G3 B0..B3; packing saturates
+// to 0..255 like clampByte
+YUV_TARGET("sse4.1")
+__m128i rgbBytesSse41(__m128i y, __m128i u, __m128i v)
+{
+    const __m128i c = _mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(y, _mm_set1_epi32(16)), _mm_set1_epi32(kYScale)),
+                                    _mm_set1_epi32(128));
+    u = _mm_sub_epi32(u, _mm_set1_epi32(128));
+    v = _mm_sub_epi32(v, _mm_set1_epi32(128));
+    const __m128i r = _mm_srai_epi32(_mm_add_epi32(c, _mm_mullo_epi32(v, _mm_set1_epi32(kRv))), 8);
+    const __m128i g = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(c, _mm_mullo_epi32(u, _mm_set1_epi32(kGu))),
+                                                   _mm_mullo_epi32(v, _mm_set1_epi32(kGv))), 8);
+    const __m128i b = _mm_srai_epi32(_mm_add_epi32(c, _mm_mullo_epi32(u, _mm_set1_epi32(kBu))), 8);
+    return _mm_packus_epi16(_mm_packs_epi32(r, g), _mm_packs_epi32(b, _mm_setzero_si128()));
+}
+
+// Planar R0..R3 G0..G3 B0..B3 to 12 interleaved bytes at out
+YUV_TARGET("sse4.1")
+void storeRgb4Sse41(uint8_t* out, __m128i planar)
+{
+    const __m128i rgb = _mm_shuffle_epi8(planar, _mm_setr_epi8(0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11, -1, -1, -1, -1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), rgb);
+    const int last = _mm_extract_epi32(rgb, 2);
+    std::memcpy(out + 8, &last, sizeof(last));
+}
+
+YUV_TARGET("sse4.1")
+void toRgbSse41(uint8_t* rgb, const uint8_t* y, const uint8_t* uv, size_t width, bool uFirst)
+{
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const __m128i yy = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(load32(y + x)));
+        const __m128i c = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(load32(uv + x)));     // two chroma pairs
+        const __m128i even = _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128i odd = _mm_shuffle_epi32(c, _MM_SHUFFLE(3, 3, 1, 1));
+        storeRgb4Sse41(rgb + 3 * x, uFirst ? rgbBytesSse41(yy, even, odd) : rgbBytesSse41(yy, odd, even));
+    }
+    toRgbScalar(rgb + 3 * x, y + x, uv + x, width - x, uFirst);
+}
+
+YUV_TARGET("sse4.1")
+void verticalSse41(float* out, const float* a, const float* b, size_t n, float w)
+{
+    const __m128 ww = _mm_set1_ps(w);
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4)
+    {
+        const __m128 x = _mm_loadu_ps(a + k);
+        _mm_storeu_ps(out + k, _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + k), x), ww)));
+    }
+    verticalScalar(out + k, a + k, b + k, n - k, w);
+}
+
+YUV_TARGET("sse4.1")
+void normalizeSse41(float* out, const float* in, size_t pixels, const float* mean, const float* scale)
+{
+    float m[24], s[24];
+    periodic(mean, scale, m, s);
+    const __m128 m0 = _mm_loadu_ps(m), m1 = _mm_loadu_ps(m + 4), m2 = _mm_loadu_ps(m + 8);
+    const __m128 s0 = _mm_loadu_ps(s), s1 = _mm_loadu_ps(s + 4), s2 = _mm_loadu_ps(s + 8);
+    const size_t n = 3 * pixels;
+    size_t i = 0;
+    for (; i + 12 <= n; i += 12)
+    {
+        _mm_storeu_ps(out + i,     _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(in + i),     m0), s0));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(in + i + 4), m1), s1));
+        _mm_storeu_ps(out + i + 8, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(in + i + 8), m2), s2));
+    }
+    normalizeScalar(out + i, in + i, (n - i) / 3, mean, scale);
+}
+
+const YuvKernels kSse41Kernels = {
+    "sse4.1", toRgbSse41, horizontalScalar, verticalSse41, normalizeSse41
+};
+
+// Eight pixels: each 128-bit lane packs and interleaves four of them like the SSE kernel
+YUV_TARGET("avx2")
+void toRgbAvx2(uint8_t* rgb, const uint8_t* y, const uint8_t* uv, size_t width, bool uFirst)
+{
+    const __m256i evenIdx = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6), oddIdx = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+    const __m256i uIdx = uFirst ? evenIdx : oddIdx, vIdx = uFirst ? oddIdx : evenIdx;
+    const __m256i interleave = _mm256_setr_epi8(0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11, -1, -1, -1, -1,
+                                                0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11, -1, -1, -1, -1);
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        const __m256i yy = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + x)));
+        const __m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(uv + x)));
+        const __m256i u = _mm256_sub_epi32(_mm256_permutevar8x32_epi32(c, uIdx), _mm256_set1_epi32(128));
+        const __m256i v = _mm256_sub_epi32(_mm256_permutevar8x32_epi32(c, vIdx), _mm256_set1_epi32(128));
+        const __m256i l = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(yy, _mm256_set1_epi32(16)),
+                                                              _mm256_set1_epi32(kYScale)), _mm256_set1_epi32(128));
+        const __m256i r = _mm256_srai_epi32(_mm256_add_epi32(l, _mm256_mullo_epi32(v, _mm256_set1_epi32(kRv))), 8);
+        const __m256i g = _mm256_srai_epi32(_mm256_add_epi32(_mm256_add_epi32(l, _mm256_mullo_epi32(u, _mm256_set1_epi32(kGu))),
+                                                             _mm256_mullo_epi32(v, _mm256_set1_epi32(kGv))), 8);
+        const __m256i b = _mm256_srai_epi32(_mm256_add_epi32(l, _mm256_mullo_epi32(u, _mm256_set1_epi32(kBu))), 8);
+        const __m256i planar = _mm256_packus_epi16(_mm256_packs_epi32(r, g), _mm256_packs_epi32(b, _mm256_setzero_si256()));
+        const __m256i px = _mm256_shuffle_epi8(planar, interleave);
+        const __m128i lo = _mm256_castsi256_si128(px), hi = _mm256_extracti128_si256(px, 1);
+        uint8_t* out = rgb + 3 * x;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), lo);
+        const int loLast = _mm_extract_epi32(lo, 2);
+        std::memcpy(out + 8, &loLast, sizeof(loLast));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 12), hi);
+        const int hiLast = _mm_extract_epi32(hi, 2);
+        std::memcpy(out + 20, &hiLast, sizeof(hiLast));
+    }
+    toRgbScalar(rgb + 3 * x, y + x, uv + x, width - x, uFirst);
+}
+
+// Gathers read four bytes at every index and keep the low one
+YUV_TARGET("avx2")
+void horizontalAvx2(float* out, const uint8_t* row, const int32_t* i0, const int32_t* i1, const float* w, size_t n)
+{
+    const int* base = reinterpret_cast<const int*>(row);
+    const __m256i low = _mm256_set1_epi32(0xff);
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8)
+    {
+        const __m256i j0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i0 + k));
+        const __m256i j1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i1 + k));
+        const __m256 a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_i32gather_epi32(base, j0, 1), low));
+        const __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_i32gather_epi32(base, j1, 1), low));
+        _mm256_storeu_ps(out + k, _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), _mm256_loadu_ps(w + k))));
+    }
+    horizontalScalar(out + k, row, i0 + k, i1 + k, w + k, n - k);
+}
+
+YUV_TARGET("avx2")
+void verticalAvx2(float* out, const float* a, const float* b, size_t n, float w)
+{
+    const __m256 ww = _mm256_set1_ps(w);
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8)
+    {
+        const __m256 x = _mm256_loadu_ps(a + k);
+        _mm256_storeu_ps(out + k, _mm256_add_ps(x, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b + k), x), ww)));
+    }
+    verticalScalar(out + k, a + k, b + k, n - k, w);
+}
+
+YUV_TARGET("avx2")
+void normalizeAvx2(float* out, const float* in, size_t pixels, const float* mean, const float* scale)
+{
+    float m[24], s[24];
+    periodic(mean, scale, m, s);
+    const __m256 m0 = _mm256_loadu_ps(m), m1 = _mm256_loadu_ps(m + 8), m2 = _mm256_loadu_ps(m + 16);
+    const __m256 s0 = _mm256_loadu_ps(s), s1 = _mm256_loadu_ps(s + 8), s2 = _mm256_loadu_ps(s + 16);
+    const size_t n = 3 * pixels;
+    size_t i = 0;
+    for (; i + 24 <= n; i += 24)
+    {
+        _mm256_storeu_ps(out + i,      _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i),      m0), s0));
+        _mm256_storeu_ps(out + i + 8,  _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i + 8),  m1), s1));
+        _mm256_storeu_ps(out + i + 16, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i + 16), m2), s2));
+    }
+    normalizeScalar(out + i, in + i, (n - i) / 3, mean, scale);
+}
+
+const YuvKernels kAvx2Kernels = {
+    "avx2", toRgbAvx2, horizontalAvx2, verticalAvx2, normalizeAvx2
+};
+
+bool cpuHas(int leaf, int reg, int bit)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < leaf) return false;
+    __cpuidex(r, leaf, 0);
+    return (r[reg] >> bit) & 1;
+#else
+    unsigned int r[4] = {0, 0, 0, 0};
+    if (!__get_cpuid_count(leaf, 0, &r[0], &r[1], &r[2], &r[3])) return false;
+    return (r[reg] >> bit) & 1;
+#endif
+}
+
+bool osSavesYmm()
+{
+    if (!cpuHas(1, 2, 27)) return false;                    // OSXSAVE
+#if defined(_MSC_VER) && !defined(__clang__)
+    return (_xgetbv(0) & 6) == 6;
+#else
+    unsigned int lo, hi;
+    __asm__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (lo & 6) == 6;
+#endif
+}
+#endif // YUV_X86
+
+#ifdef YUV_NEON
+// One channel of eight pixels: (128 + 298 (y - 16) + cu u + cv v) >> 8, narrowed with
+// saturation to 0..255 like clampByte
+uint8x8_t rgbChannelNeon(int16x8_t y, int16x8_t u, int16x8_t v, int16_t cu, int16_t cv)
+{
+    int32x4_t lo = vmlal_n_s16(vdupq_n_s32(128), vget_low_s16(y), kYScale);
+    int32x4_t hi = vmlal_n_s16(vdupq_n_s32(128), vget_high_s16(y), kYScale);
+    lo = vmlal_n_s16(vmlal_n_s16(lo, vget_low_s16(u), cu), vget_low_s16(v), cv);
+    hi = vmlal_n_s16(vmlal_n_s16(hi, vget_high_s16(u), cu), vget_high_s16(v), cv);
+    return vqmovun_s16(vcombine_s16(vqshrn_n_s32(lo, 8), vqshrn_n_s32(hi, 8)));
+}
+
+void toRgbNeon(uint8_t* rgb, const uint8_t* y, const uint8_t* uv, size_t width, bool uFirst)
+{
+    const int16x8_t bias = vdupq_n_s16(128);
+    size_t x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        const uint8x8_t c = vld1_u8(uv + x);                                    // four chroma pairs
+        const uint8x8x2_t split = vuzp_u8(c, c);
+        const uint8x8_t first = vzip_u8(split.val[0], split.val[0]).val[0];     // each pair's value twice
+        const uint8x8_t second = vzip_u8(split.val[1], split.val[1]).val[0];
+        const int16x8_t yy = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + x))), vdupq_n_s16(16));
+        const int16x8_t u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uFirst ? first : second)), bias);
+        const int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uFirst ? second : first)), bias);
+        uint8x8x3_t px;
+        px.val[0] = rgbChannelNeon(yy, u, v, 0, kRv);
+        px.val[1] = rgbChannelNeon(yy, u, v, kGu, kGv);
+        px.val[2] = rgbChannelNeon(yy, u, v, kBu, 0);
+        vst3_u8(rgb + 3 * x, px);
+    }
+    toRgbScalar(rgb + 3 * x, y + x, uv + x, width - x, uFirst);
+}
+
+void verticalNeon(float* out, const float* a, const float* b, size_t n, float w)
+{
+    const float32x4_t ww = vdupq_n_f32(w);
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4)
+    {
+        const float32x4_t x = vld1q_f32(a + k);
+        vst1q_f32(out + k, vaddq_f32(x, vmulq_f32(vsubq_f32(vld1q_f32(b + k), x), ww)));
+    }
+    verticalScalar(out + k, a + k, b + k, n - k, w);
+}
+
+void normalizeNeon(float* out, const float* in, size_t pixels, const float* mean, const float* scale)
+{
+    float m[24], s[24];
+    periodic(mean, scale, m, s);
+    const float32x4_t m0 = vld1q_f32(m), m1 = vld1q_f32(m + 4), m2 = vld1q_f32(m + 8);
+    const float32x4_t s0 = vld1q_f32(s), s1 = vld1q_f32(s + 4), s2 = vld1q_f32(s + 8);
+    const size_t n = 3 * pixels;
+    size_t i = 0;
+    for (; i + 12 <= n; i += 12)
+    {
+        vst1q_f32(out + i,     vmulq_f32(vsubq_f32(vld1q_f32(in + i),     m0), s0));
+        vst1q_f32(out + i + 4, vmulq_f32(vsubq_f32(vld1q_f32(in + i + 4), m1), s1));
+        vst1q_f32(out + i + 8, vmulq_f32(vsubq_f32(vld1q_f32(in + i + 8), m2), s2));
+    }
+    normalizeScalar(out + i, in + i, (n - i) / 3, mean, scale);
+}
+
+const YuvKernels kNeonKernels = {
+    "neon", toRgbNeon, horizontalScalar, verticalNeon, normalizeNeon
+};
+#endif // YUV_NEON
+
+// The kernels this CPU runs, best first; scalar is always last
+std::vector<const YuvKernels*> supportedYuvKernels()
+{
+    std::vector<const YuvKernels*> kernels;
+#ifdef YUV_X86
+    if (cpuHas(7, 1, 5) && osSavesYmm()) kernels.push_back(&kAvx2Kernels);
+    if (cpuHas(1, 2, 19)) kernels.push_back(&kSse41Kernels);
+#endif
+#ifdef YUV_NEON
+    kernels.push_back(&kNeonKernels);
+#endif
+    kernels.push_back(&kScalarKernels);
+    return kernels;
+}
+
+std::atomic<const YuvKernels*>& activeYuvKernels()
+{
+    static std::atomic<const YuvKernels*> active(supportedYuvKernels().front());
+    return active;
+}
+
+// Source sample positions of out output positions over in input ones, half-pixel centres:
+// value = p[i0] + (p[i1] - p[i0]) * w, both indices times stride plus offset
+void bilinearTaps(size_t in, size_t out, size_t stride, size_t offset,
+                  int32_t* i0, int32_t* i1, float* w, size_t step)
+{
+    const double ratio = static_cast<double>(in) / static_cast<double>(out);
+    for (size_t o = 0; o < out; ++o)
+    {
+        const double s = std::max(0.0, (o + 0.5) * ratio - 0.5);
+        const size_t a = std::min(static_cast<size_t>(s), in - 1);
+        const size_t b = std::min(a + 1, in - 1);
+        i0[o * step] = static_cast<int32_t>(a * stride + offset);
+        i1[o * step] = static_cast<int32_t>(b * stride + offset);
+        w[o * step] = a == b ? 0.0f : static_cast<float>(s - a);
+    }
+}
+
+// Per thread: the taps of the last frame and output size, and the stage buffers
+struct Scratch
+{
+    size_t inWidth = 0, inHeight = 0, outWidth = 0, outHeight = 0;
+    std::vector<int32_t> col0, col1, row0, row1;   // per output element / row
+    std::vector<float> colW, rowW;
+    std::vector<int32_t> slot;                     // per source row: its row in rgb, -1 if unread
+    std::vector<uint8_t> rgb;                      // the converted source rows, padded by 4 bytes
+    size_t rgbStride = 0;
+    std::vector<float> resized[2];                 // horizontally resized source rows
+    int32_t resizedRow[2] = {-1, -1};
+    std::vector<float> image;                      // resized frame, before normalization
+};
+
+void prepare(Scratch& s, size_t inWidth, size_t inHeight, size_t outWidth, size_t outHeight)
+{
+    if (s.inWidth == inWidth && s.inHeight == inHeight && s.outWidth == outWidth && s.outHeight == outHeight) return;
+    const size_t n = outWidth * 3;
+    s.col0.resize(n);
+    s.col1.resize(n);
+    s.colW.resize(n);
+    for (size_t c = 0; c < 3; ++c)
+        bilinearTaps(inWidth, outWidth, 3, c, &s.col0[c], &s.col1[c], &s.colW[c], 3);
+    s.row0.resize(outHeight);
+    s.row1.resize(outHeight);
+    s.rowW.resize(outHeight);
+    bilinearTaps(inHeight, outHeight, 1, 0, s.row0.data(), s.row1.data(), s.rowW.data(), 1);
+
+    s.slot.assign(inHeight, -1);
+    int32_t rows = 0;
+    for (size_t o = 0; o < outHeight; ++o)
+        for (int32_t r : {s.row0[o], s.row1[o]})
+            if (s.slot[r] < 0) s.slot[r] = rows++;
+    s.rgbStride = inWidth * 3 + 4;
+    s.rgb.assign(s.rgbStride * rows, 0);
+    s.resized[0].resize(n);
+    s.resized[1].resize(n);
+    s.image.resize(n * outHeight);
+    s.inWidth = inWidth;
+    s.inHeight = inHeight;
+    s.outWidth = outWidth;
+    s.outHeight = outHeight;
+}
+
+// The horizontally resized source row r, computed unless one of the two kept rows is r;
+// the other kept row is replaced unless it is keep
+const float* resizedRow(Scratch& s, const YuvKernels& k, int32_t r, int32_t keep)
+{
+    for (int i = 0; i < 2; ++i)
+        if (s.resizedRow[i] == r) return s.resized[i].data();
+    const int i = s.resizedRow[0] == keep ? 1 : 0;
+    k.horizontal(s.resized[i].data(), s.rgb.data() + s.rgbStride * s.slot[r],
+                 s.col0.data(), s.col1.data(), s.colW.data(), s.resized[i].size());
+    s.resizedRow[i] = r;
+    return s.resized[i].data();
+}
+
+double msSince(std::chrono::steady_clock::time_point& t)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - t).count();
+    t = now;
+    return ms;
+}
+
+bool parseFloats(const std::string& s, float* out)
+{
+    std::vector<float> v;
+    std::stringstream ss(s);
+    for (std::string x; std::getline(ss, x, ','); )
+    {
+        char* end = nullptr;
+        v.push_back(std::strtof(x.c_str(), &end));
+        if (x.empty() || *end) return false;
+    }
+    if (v.size() != 1 && v.size() != 3) return false;
+    for (size_t c = 0; c < 3; ++c) out[c] = v[v.size() == 1 ? 0 : c];
+    return true;
+}
+}
+
+size_t YuvFrameBytes(size_t width, size_t height)
+{
+    return width * height + 2 * ((width + 1) / 2) * ((height + 1) / 2);
+}
+
+bool PixelNormalization::identity() const
+{
+    for (int c = 0; c < 3; ++c)
+        if (mean[c] != 0.0f || scale[c] != 1.0f) return false;
+    return true;
+}
+
+PreprocessTimes& PreprocessTimes::operator+=(const PreprocessTimes& other)
+{
+    convertMs += other.convertMs;
+    resizeMs += other.resizeMs;
+    normalizeMs += other.normalizeMs;
+    frames += other.frames;
+    return *this;
+}
+
+bool PreprocessYuvFrame(const YuvFrame& frame, size_t outWidth, size_t outHeight,
+                        const PixelNormalization& norm, float* dst, PreprocessTimes* times)
+{
+    if (!frame.data || !frame.width || !frame.height || !outWidth || !outHeight || !dst)
+    {
+        std::cerr << "Cannot preprocess a " << frame.width << "x" << frame.height << " frame to "
+                  << outWidth << "x" << outHeight << "\n";
+        return false;
+    }
+    static thread_local Scratch s;
+    const YuvKernels& k = *activeYuvKernels().load();
+    auto t = std::chrono::steady_clock::now();
+    PreprocessTimes spent;
+    spent.frames = 1;
+
+    prepare(s, frame.width, frame.height, outWidth, outHeight);
+    const uint8_t* chroma = frame.data + frame.width * frame.height;
+    const size_t chromaStride = 2 * ((frame.width + 1) / 2);
+    const bool uFirst = frame.layout == YuvLayout::NV12;
+    for (size_t r = 0; r < frame.height; ++r)
+    {
+        if (s.slot[r] < 0) continue;
+        k.toRgb(s.rgb.data() + s.rgbStride * s.slot[r], frame.data + frame.width * r,
+                chroma + chromaStride * (r / 2), frame.width, uFirst);
+    }
+    spent.convertMs = msSince(t);
+
+    // Resized rows go straight to dst when there is nothing to normalize
+    const bool identity = norm.identity();
+    float* resized = identity ? dst : s.image.data();
+    const size_t n = outWidth * 3;
+    s.resizedRow[0] = s.resizedRow[1] = -1;
+    for (size_t o = 0; o < outHeight; ++o)
+    {
+        const int32_t a = s.row0[o], b = s.row1[o];
+        const float* above = resizedRow(s, k, a, b);
+        const float* below = resizedRow(s, k, b, a);
+        k.vertical(resized + n * o, above, below, n, s.rowW[o]);
+    }
+    spent.resizeMs = msSince(t);
+
+    if (!identity)
+    {
+        k.normalize(dst, s.image.data(), outWidth * outHeight, norm.mean, norm.scale);
+        spent.normalizeMs = msSince(t);
+    }
+    if (times) *times += spent;
+    return true;
+}
+
+bool ParseYuvFormat(const std::string& spec, YuvFrame& frame)
+{
+    const char* p = spec.c_str();
+    char* end = nullptr;
+    const unsigned long width = std::strtoul(p, &end, 10);
+    if (end == p || *end != 'x') return false;
+    p = end + 1;
+    const unsigned long height = std::strtoul(p, &end, 10);
+    if (end == p || width == 0 || height == 0) return false;
+    const std::string layout(end);
+    if (layout.empty() || layout == ":nv21")
+        frame.layout = YuvLayout::NV21;
+    else if (layout == ":nv12")
+        frame.layout = YuvLayout::NV12;
+    else
+        return false;
+    frame.width = width;
+    frame.height = height;
+    return true;
+}
+
+bool ParsePixelNormalization(const std::string& spec, PixelNormalization& norm)
+{
+    PixelNormalization parsed;
+    const size_t colon = spec.find(':');
+    if (!parseFloats(spec.substr(0, colon), parsed.mean)) return false;
+    if (colon != std::string::npos && !parseFloats(spec.substr(colon + 1), parsed.scale)) return false;
+    norm = parsed;
+    return true;
+}
+
+std::vector<std::string> GetYuvKernels()
+{
+    std::vector<std::string> names;
+    for (const YuvKernels* k : supportedYuvKernels()) names.push_back(k->name);
+    return names;
+}
+
+std::string GetYuvKernel()
+{
+    return activeYuvKernels().load()->name;
+}
+
+bool SetYuvKernel(const std::string& name)
+{
+    for (const YuvKernels* k : supportedYuvKernels())
+    {
+        if (name == k->name)
+        {
+            activeYuvKernels() = k;
+            return true;
+        }
+    }
+    return false;
+}
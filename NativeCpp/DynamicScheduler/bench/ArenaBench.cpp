@@ -0,0 +1,243 @@
+// ArenaBench.cpp – application user buffers as heap vectors versus one UserBufferArena
+// build: make -C bench arena-bench   (plain Linux; only UserBufferArena.cpp is exercised)
+//
+// M models with S buffer sets each; a set is the tensors of -t, the first an input. A
+// pass over every model does what the sample does around execute(): the loader copies a
+// frame into the input, a stand-in for execute() reads the input and writes the outputs,
+// the saver reads the outputs. Layouts:
+//   heap         one std::vector per tensor, as createUserBuffer made them, allocated
+//                among other heap allocations the way a process interleaves them
+//   arena-small  one UserBufferArena on 4 KiB pages
+//   arena-huge   one UserBufferArena on 2 MiB pages
+// Per layout: setup (allocation and a first pass over every set, where the pages fault
+// in), then the steady passes. Counted with perf_event_open for this thread: page faults, and, when
+// the CPU exposes its PMU, dTLB load misses, L1D and last-level cache read misses. The
+// pages the buffers span are what the TLB has to cover.
+#include "UserBufferArena.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    int models = 8;
+    int sets = 2;
+    // MobileNet-like: a 224×224×3 float input, logits, and a few small detection heads
+    std::vector<size_t> tensors {224*224*3*4, 1001*4, 100*4*4, 100*4, 100*4, 4};
+    int passes = 200;
+    std::string csv = "arena_bench.csv";
+};
+static Options gOpt;
+
+/* counters of this thread, user space only (perf_event_paranoid 2 allows that) --------- */
+class Counter
+{
+public:
+    Counter(uint32_t type, uint64_t config)
+    {
+        perf_event_attr a;
+        std::memset(&a, 0, sizeof(a));
+        a.size = sizeof(a); a.type = type; a.config = config;
+        a.disabled = 1; a.exclude_kernel = 1; a.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &a, 0, -1, -1, 0));
+    }
+    ~Counter(){ if(m_fd >= 0) close(m_fd); }
+    bool ok() const { return m_fd >= 0; }
+    void start(){ if(m_fd >= 0){ ioctl(m_fd, PERF_EVENT_IOC_RESET, 0); ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0); } }
+    double stop()
+    {
+        if(m_fd < 0) return -1.0;
+        ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t v = 0;
+        return read(m_fd, &v, sizeof(v)) == sizeof(v) ? double(v) : -1.0;
+    }
+private:
+    int m_fd = -1;
+};
+static uint64_t cacheMiss(uint64_t cache){
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16); }
+
+struct Counters {
+    Counter faults{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+    Counter dtlb{PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB)};
+    Counter l1d{PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D)};
+    Counter llc{PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL)};
+    void start(){ faults.start(); dtlb.start(); l1d.start(); llc.start(); }
+    std::array<double,4> stop(){ return {{ faults.stop(), dtlb.stop(), l1d.stop(), llc.stop() }}; }
+};
+
+/* one layout of every model's buffers ------------------------------------------------- */
+struct Layout {
+    std::string name;
+    std::unique_ptr<UserBufferArena> arena;
+    std::vector<ApplicationBuffer> buffers;     // model, set, tensor
+    std::vector<std::vector<uint8_t>> clutter;  // heap: what else the process allocated
+};
+
+static size_t perModel(){ return size_t(gOpt.sets)*gOpt.tensors.size(); }
+
+static void allocate(Layout& l, int pages)     // 0 heap, 1 arena small, 2 arena huge
+{
+    const size_t n = size_t(gOpt.models)*perModel();
+    l.buffers.reserve(n);
+    if(pages == 0){
+        std::mt19937 gen(1);
+        std::uniform_int_distribution<size_t> other(16, 4096);
+        for(size_t i = 0; i < n; ++i){
+            for(int k = 0; k < 4; ++k) l.clutter.emplace_back(other(gen));
+            l.buffers.emplace_back(gOpt.tensors[i % gOpt.tensors.size()]);
+        }
+        return;
+    }
+    std::vector<size_t> sizes;
+    for(size_t i = 0; i < n; ++i) sizes.push_back(gOpt.tensors[i % gOpt.tensors.size()]);
+    l.arena.reset(new UserBufferArena(UserBufferArena::bytesFor(sizes), pages == 2));
+    if(!l.arena->valid()) throw std::runtime_error("cannot map the arena");
+    for(size_t s : sizes){
+        ApplicationBuffer b{ArenaAllocator<uint8_t>(l.arena.get())};
+        b.resize(s);
+        l.buffers.push_back(std::move(b));
+    }
+}
+
+// The loader, execute() and the saver over every model, set pass % sets
+static uint64_t pass(Layout& l, const std::vector<uint8_t>& frame, int p)
+{
+    uint64_t sum = 0;
+    const size_t t = gOpt.tensors.size();
+    for(int m = 0; m < gOpt.models; ++m){
+        ApplicationBuffer* set = &l.buffers[m*perModel() + size_t(p % gOpt.sets)*t];
+        std::memcpy(set[0].data(), frame.data(), set[0].size());
+        const float* in = reinterpret_cast<const float*>(set[0].data());
+        float acc = 0.0f;
+        for(size_t i = 0; i < set[0].size()/sizeof(float); ++i) acc += in[i];
+        for(size_t k = 1; k < t; ++k){
+            float* out = reinterpret_cast<float*>(set[k].data());
+            for(size_t i = 0; i < set[k].size()/sizeof(float); ++i) out[i] = acc + float(i);
+        }
+        for(size_t k = 1; k < t; ++k)
+            for(size_t i = 0; i < set[k].size(); i += 8) sum += set[k][i];
+    }
+    return sum;
+}
+
+static std::pair<size_t,size_t> pagesSpanned(const Layout& l)
+{
+    std::set<uintptr_t> small, huge;
+    for(const auto& b : l.buffers){
+        const uintptr_t a = reinterpret_cast<uintptr_t>(b.data()), e = a + b.size() - 1;
+        for(uintptr_t p = a >> 12; p <= e >> 12; ++p) small.insert(p);
+        for(uintptr_t p = a >> 21; p <= e >> 21; ++p) huge.insert(p);
+    }
+    return { small.size(), huge.size() };
+}
+
+static bool parseSizes(const char* s, std::vector<size_t>& v)
+{
+    v.clear();
+    std::stringstream ss(s);
+    for(std::string x; std::getline(ss, x, ','); ){
+        const long long n = std::atoll(x.c_str());
+        if(n <= 0) return false;
+        v.push_back(size_t(n));
+    }
+    return !v.empty();
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -m <N>      models (default "<<gOpt.models<<")\n"
+             <<"  -k <N>      buffer sets per model (default "<<gOpt.sets<<")\n"
+             <<"  -t <LIST>   tensor bytes of a set, comma separated, the input first (default MobileNet-like)\n"
+             <<"  -n <N>      steady passes over every model (default "<<gOpt.passes<<")\n"
+             <<"  -o <FILE>   CSV output (default "<<gOpt.csv<<")\n"
+             <<"Counts are per pass; n/a where the CPU's PMU is not available to this process.\n";
+}
+
+static std::string count(double v, double per){
+    if(v < 0.0) return "n/a";
+    std::ostringstream s; s<<std::fixed<<std::setprecision(1)<<v/per; return s.str(); }
+
+int main(int argc, char** argv)
+{
+    for(int opt; (opt = getopt(argc, argv, "hm:k:t:n:o:")) != -1; ){
+        switch(opt){
+            case 'm': gOpt.models = std::max(1, std::atoi(optarg)); break;
+            case 'k': gOpt.sets = std::max(1, std::atoi(optarg)); break;
+            case 't': if(!parseSizes(optarg, gOpt.tensors)){ usage(argv[0]); return 1; } break;
+            case 'n': gOpt.passes = std::max(1, std::atoi(optarg)); break;
+            case 'o': gOpt.csv = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+    std::vector<uint8_t> frame(gOpt.tensors[0]);
+    std::mt19937 gen(2);
+    for(auto& b : frame) b = static_cast<uint8_t>(gen() & 0x3f);      // small finite floats
+
+    size_t bytes = 0;
+    for(size_t t : gOpt.tensors) bytes += t;
+    std::cout<<gOpt.models<<" models × "<<gOpt.sets<<" sets × "<<gOpt.tensors.size()<<" tensors, "
+             <<std::fixed<<std::setprecision(2)<<bytes*gOpt.sets*gOpt.models/1048576.0<<" MiB of buffers\n\n";
+    std::cout<<std::left<<std::setw(12)<<"layout"<<std::right<<std::setw(18)<<"page kind"<<std::setw(10)<<"4K pages"
+             <<std::setw(10)<<"2M pages"<<std::setw(11)<<"setup ms"<<std::setw(13)<<"setup faults"
+             <<std::setw(11)<<"pass ms"<<std::setw(9)<<"faults"<<std::setw(11)<<"dTLB miss"
+             <<std::setw(11)<<"L1D miss"<<std::setw(11)<<"LLC miss"<<'\n';
+
+    std::ofstream csv(gOpt.csv);
+    csv<<"layout,page_kind,models,sets,pages_4k,pages_2m,setup_ms,setup_faults,pass_ms,"
+         "faults_per_pass,dtlb_miss_per_pass,l1d_miss_per_pass,llc_miss_per_pass\n";
+    uint64_t sink = 0;
+    const char* names[] = {"heap", "arena-small", "arena-huge"};
+    for(int pages = 0; pages < 3; ++pages){
+        Layout l; l.name = names[pages];
+        Counters c;
+        c.start();
+        const auto t0 = Clock::now();
+        allocate(l, pages);
+        for(int p = 0; p < gOpt.sets; ++p) sink += pass(l, frame, p);       // every set touched once
+        const double setupMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        const std::array<double,4> setup = c.stop();
+
+        c.start();
+        const auto t1 = Clock::now();
+        for(int p = 0; p < gOpt.passes; ++p) sink += pass(l, frame, p);
+        const double passMs = std::chrono::duration<double, std::milli>(Clock::now() - t1).count()/gOpt.passes;
+        const std::array<double,4> steady = c.stop();
+
+        const auto span = pagesSpanned(l);
+        const std::string kind = l.arena ? l.arena->pageKind() : "malloc";
+        std::cout<<std::left<<std::setw(12)<<l.name<<std::right<<std::setw(18)<<kind<<std::setw(10)<<span.first
+                 <<std::setw(10)<<span.second<<std::setw(11)<<std::setprecision(3)<<setupMs
+                 <<std::setw(13)<<count(setup[0], 1)<<std::setw(11)<<passMs
+                 <<std::setw(9)<<count(steady[0], gOpt.passes)<<std::setw(11)<<count(steady[1], gOpt.passes)
+                 <<std::setw(11)<<count(steady[2], gOpt.passes)<<std::setw(11)<<count(steady[3], gOpt.passes)<<'\n';
+        csv<<l.name<<','<<kind<<','<<gOpt.models<<','<<gOpt.sets<<','<<span.first<<','<<span.second<<','
+           <<setupMs<<','<<count(setup[0], 1)<<','<<passMs<<','<<count(steady[0], gOpt.passes)<<','
+           <<count(steady[1], gOpt.passes)<<','<<count(steady[2], gOpt.passes)<<','<<count(steady[3], gOpt.passes)<<'\n';
+    }
+    if(sink == 42) std::cout<<' ';        // keeps the passes from being optimized away
+    return 0;
+}
@@ -0,0 +1,288 @@
+// IoShareBench.cpp – memory and correctness of per‑runtime IO buffer sharing (planIo)
+// build: make -C ../SnpeStandIn && make -C bench io-share-bench   (plain Linux, stand‑in SNPE)
+//
+// The five models of the XRBench AR_Assistant scenario, with their input and output shapes,
+// are registered pipelined on CPU, GPU and DSP, once with their own user‑buffer sets and
+// once sharing one arena per runtime (small and huge pages), each in a forked child. The
+// buffers are prefaulted as in real‑time mode, so what is resident is what the sets take.
+// Then requests of every model run on randomly picked runtimes, window requests at a time:
+// the stand‑in executor reads the whole input, writes every output and marks the model the
+// frame belongs to, so a set another model's request overwrote before its outputs were
+// consumed shows as a wrong top‑1.
+#include "Scheduler.hpp"
+
+#include "StandIn/Executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using dsched::Clock;
+using dsched::Policy;
+using dsched::Runtime_t;
+using zdl::DlSystem::TensorShape;
+
+// Input and outputs of the XRBench models as the scheduler's scenario names them
+// (float user buffers, batch 1, NHWC)
+struct Net { std::string name; TensorShape in; std::vector<TensorShape> out; };
+static const std::vector<Net> kNets = {
+    { "KD_res8_narrow_quant",     { 1, 49, 40, 1 },   { { 1, 12 } } },                           // keyword spotting, MFCC
+    { "ASR_EM_24L_quant",         { 1, 160, 80 },     { { 1, 40, 4097 } } },                     // Emformer, fbank → wordpieces
+    { "SS_HRViT_b1_quant",        { 1, 512, 512, 3 }, { { 1, 128, 128, 19 } } },                 // segmentation, 19 classes
+    { "DE_midas_v21_small_quant", { 1, 256, 256, 3 }, { { 1, 256, 256, 1 } } },                  // depth
+    { "OD_D2go_FasterRCNN_quant", { 1, 320, 320, 3 }, { { 1, 100, 4 }, { 1, 100 }, { 1, 100 } } }  // boxes, scores, classes
+};
+
+struct Options {
+    uint64_t requests = 6000;                // measured requests per mode
+    int window = 12;                         // requests outstanding at a time
+    int execUs = 300;                        // execute() time on top of touching the buffers
+    std::vector<std::string> modes {"own", "small", "huge"};
+    std::string csv = "io_share.csv";
+};
+static Options gOpt;
+
+static size_t elements(const TensorShape& s)
+{
+    size_t n = 1;
+    for(size_t i = 0; i < s.rank(); ++i) n *= s[i];
+    return n;
+}
+
+/* reads every input, writes every output; 1 at the frame's value (model index + 1) ---- */
+class XrExecutor : public standin::Executor {
+public:
+    bool available(Runtime_t) override { return true; }
+    bool describe(const std::string& model, Runtime_t, standin::NetworkShape& shape) override
+    {
+        for(const Net& n : kNets){
+            if(n.name != model) continue;
+            shape.inputs = { { "input", n.in } };
+            for(size_t k = 0; k < n.out.size(); ++k) shape.outputs.push_back({ "output" + std::to_string(k), n.out[k] });
+            return true;
+        }
+        return false;
+    }
+    bool execute(const standin::Call& call) override
+    {
+        if(call.inputs.empty() || call.outputs.empty()) return false;
+        const float* in = static_cast<const float*>(call.inputs[0].data);
+        const size_t n = call.inputs[0].bytes/sizeof(float);
+        float lo = in[0], hi = in[0];
+        for(size_t i = 1; i < n; ++i){ lo = std::min(lo, in[i]); hi = std::max(hi, in[i]); }
+        for(const standin::Buffer& b : call.outputs) std::memset(b.data, 0, b.bytes);
+        float* out = static_cast<float*>(call.outputs[0].data);
+        if(lo == hi && size_t(lo) < call.outputs[0].bytes/sizeof(float)) out[size_t(lo)] = 1.0f;   // mixed: top‑1 0
+        std::this_thread::sleep_for(std::chrono::microseconds(gOpt.execUs));
+        return true;
+    }
+};
+
+static size_t residentBytes()
+{
+    size_t pages = 0, resident = 0;
+    std::ifstream("/proc/self/statm")>>pages>>resident;
+    return resident*size_t(sysconf(_SC_PAGESIZE));
+}
+
+/* one mode, in a child --------------------------------------------------------------- */
+struct Point {
+    double ownMiB, sharedMiB;                // user‑buffer sets, all runtimes
+    double loadedMiB, prefaultMiB, endMiB;   // resident after registering, prefault, the run
+    double peakMiB;                          // ru_maxrss
+    double reqPerSec, respP99Ms;
+    uint64_t wrong, failed, faults;
+};
+
+static Point drive(uint64_t n)
+{
+    std::mutex m; std::condition_variable cv;
+    int free = gOpt.window; uint64_t done = 0;
+    std::atomic<uint64_t> wrong{0}, failed{0};
+    std::vector<float> resp(n);
+    const auto t0 = Clock::now();
+    for(uint64_t i = 0; i < n; ++i){
+        { std::unique_lock<std::mutex> lk(m); cv.wait(lk, [&]{ return free > 0; }); --free; }
+        const int model = int(i % kNets.size());
+        dsched::submit(model, dsched::InputView(), Clock::now() + std::chrono::seconds(1),
+                       [&, i, model](dsched::Result&& r){
+                           resp[i] = float(std::chrono::duration<double,std::milli>(r.completed - r.released).count());
+                           if(r.status != dsched::Status::OK) failed++;
+                           else if(r.top1 != model+1) wrong++;
+                           { std::lock_guard<std::mutex> lk(m); ++free; ++done; }
+                           cv.notify_one();
+                       });
+    }
+    { std::unique_lock<std::mutex> lk(m); cv.wait(lk, [&]{ return done == n; }); }
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    std::sort(resp.begin(), resp.end());
+    Point p{};
+    p.reqPerSec = n/sec;
+    p.respP99Ms = resp[std::min(resp.size()-1, size_t(0.99*resp.size()))];
+    p.wrong = wrong; p.failed = failed;
+    return p;
+}
+
+static int runMode(const std::string& mode, const std::string& dir, int fd)
+{
+    standin::setExecutor(std::make_shared<XrExecutor>());
+    dsched::ServiceConfig sc; sc.pipeline = true;
+    dsched::init(sc);
+    for(size_t i = 0; i < kNets.size(); ++i){
+        dsched::ModelConfig mc;
+        mc.dlc = dir + "/" + kNets[i].name + ".dlc";
+        mc.inputList = dir + "/" + kNets[i].name + ".txt";
+        if(dsched::registerModel(mc) != int(i)){ std::cerr<<"cannot register "<<mc.dlc<<"\n"; return 1; }
+    }
+    const double MiB = 1048576.0;
+    const double loaded = residentBytes()/MiB;
+    double own = 0.0, shared = 0.0;
+    if(mode != "own"){
+        const dsched::IoPlan plan = dsched::planIo(mode == "huge");
+        for(const auto& f : plan.rt){ own += f.ownBytes/MiB; shared += f.sharedBytes/MiB; }
+    }
+    dsched::prefault();
+    const double prefaulted = residentBytes()/MiB;
+    dsched::setPolicy(Policy::RANDOM);
+    dsched::start();
+    drive(std::max<uint64_t>(1, gOpt.requests/10));            // warm‑up
+    Point p = drive(gOpt.requests);
+    dsched::stop();
+    rusage ru; getrusage(RUSAGE_SELF, &ru);
+    p.ownMiB = own; p.sharedMiB = shared;
+    p.loadedMiB = loaded; p.prefaultMiB = prefaulted; p.endMiB = residentBytes()/MiB;
+    p.peakMiB = ru.ru_maxrss/1024.0;
+    p.faults = dsched::ioLivenessFaults();
+
+    std::ostringstream out;
+    out<<mode<<','<<p.ownMiB<<','<<p.sharedMiB<<','<<p.loadedMiB<<','<<p.prefaultMiB<<','<<p.endMiB<<','
+       <<p.peakMiB<<','<<p.reqPerSec<<','<<p.respP99Ms<<','<<p.wrong<<','<<p.failed<<','<<p.faults<<'\n';
+    const std::string s = out.str();
+    return write(fd, s.data(), s.size()) == ssize_t(s.size()) ? 0 : 1;
+}
+
+/* containers, and a frame of value i+1 for model i, the input lists point at --------- */
+static bool makeFixtures(const std::string& dir)
+{
+    bool ok = true;
+    for(size_t i = 0; i < kNets.size(); ++i){
+        const std::string base = dir + "/" + kNets[i].name;
+        const std::vector<float> frame(elements(kNets[i].in), float(i+1));
+        std::ofstream raw(base + ".raw", std::ios::binary);
+        raw.write(reinterpret_cast<const char*>(frame.data()), frame.size()*sizeof(float));
+        std::ofstream list(base + ".txt");
+        list<<base<<".raw\n";
+        std::ofstream(base + ".dlc")<<"stand‑in\n";
+        ok = ok && raw.good() && list.good();
+    }
+    return ok;
+}
+static void removeFixtures(const std::string& dir)
+{
+    for(const Net& n : kNets)
+        for(const char* ext : { ".dlc", ".raw", ".txt" }) std::remove((dir + "/" + n.name + ext).c_str());
+    rmdir(dir.c_str());
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -n <N>      measured requests per mode (default "<<gOpt.requests<<"), after N/10 warm‑up\n"
+             <<"  -w <N>      requests outstanding at a time (default "<<gOpt.window<<")\n"
+             <<"  -e <US>     execute() time besides reading the input and writing the outputs (default "
+             <<gOpt.execUs<<")\n"
+             <<"  -m <LIST>   modes, comma separated: own (every model its own sets), small, huge (one\n"
+             <<"              arena per runtime on small / huge pages; default own,small,huge)\n"
+             <<"  -o <FILE>   CSV output (default "<<gOpt.csv<<")\n"
+             <<"Memory is MiB; a wrong top‑1 is a request whose buffers another model's request overwrote.\n";
+}
+
+int main(int argc, char** argv)
+{
+    for(int opt; (opt = getopt(argc, argv, "hn:w:e:m:o:")) != -1; ){
+        switch(opt){
+            case 'n': gOpt.requests = std::max(1ULL, std::strtoull(optarg, nullptr, 0)); break;
+            case 'w': gOpt.window = std::max(1, std::atoi(optarg)); break;
+            case 'e': gOpt.execUs = std::max(0, std::atoi(optarg)); break;
+            case 'm':{
+                gOpt.modes.clear();
+                std::stringstream ss(optarg);
+                for(std::string x; std::getline(ss, x, ','); ){
+                    if(x != "own" && x != "small" && x != "huge"){ usage(argv[0]); return 1; }
+                    gOpt.modes.push_back(x);
+                }
+                if(gOpt.modes.empty()){ usage(argv[0]); return 1; }
+                break;
+            }
+            case 'o': gOpt.csv = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+
+    char tmpl[] = "/tmp/io-share-bench.XXXXXX";
+    if(!mkdtemp(tmpl)){ std::perror("mkdtemp"); return 1; }
+    const std::string dir = tmpl;
+    if(!makeFixtures(dir)){ std::cerr<<"cannot write fixtures to "<<dir<<"\n"; removeFixtures(dir); return 1; }
+
+    std::ofstream csv(gOpt.csv);
+    csv<<"mode,own_mib,shared_mib,rss_loaded_mib,rss_prefault_mib,rss_end_mib,rss_peak_mib,"
+         "req_per_s,resp_p99_ms,wrong_top1,failed,liveness_faults\n";
+    std::cout<<kNets.size()<<" XRBench models pipelined on CPU, GPU and DSP; "<<gOpt.requests<<" requests per mode, "
+             <<gOpt.window<<" outstanding\n"<<std::fixed<<std::setprecision(2);
+    int rc = 0;
+    for(const std::string& mode : gOpt.modes){
+        int fds[2];
+        if(pipe2(fds, O_CLOEXEC) != 0){ std::perror("pipe"); rc = 1; break; }
+        std::cout.flush();
+        const pid_t pid = fork();
+        if(pid < 0){ std::perror("fork"); close(fds[0]); close(fds[1]); rc = 1; break; }
+        if(pid == 0){ close(fds[0]); _exit(runMode(mode, dir, fds[1])); }
+        close(fds[1]);
+        std::string line; char buf[1024];
+        for(ssize_t k; (k = read(fds[0], buf, sizeof buf)) > 0; ) line.append(buf, size_t(k));
+        close(fds[0]);
+        int st = 0; waitpid(pid, &st, 0);
+        if(!WIFEXITED(st) || WEXITSTATUS(st) != 0 || line.empty()){ std::cerr<<mode<<": failed\n"; rc = 1; continue; }
+        csv<<line;
+        line.pop_back();                                    // '\n'
+
+        std::vector<std::string> f;
+        std::stringstream fs(line);
+        for(std::string x; std::getline(fs, x, ','); ) f.push_back(x);
+        auto num = [&](int k){ return std::atof(f[k].c_str()); };
+        std::cout<<"  "<<std::left<<std::setw(6)<<mode<<std::right;
+        if(mode != "own") std::cout<<"  sets "<<std::setw(6)<<num(1)<<" → "<<std::setw(6)<<num(2)<<" MiB";
+        else              std::cout<<"  sets   (own)           ";
+        std::cout<<"  resident loaded "<<std::setw(7)<<num(3)<<"  prefaulted "<<std::setw(7)<<num(4)
+                 <<"  end "<<std::setw(7)<<num(5)<<"  peak "<<std::setw(7)<<num(6)<<" MiB  "
+                 <<std::setw(7)<<num(7)<<" req/s  p99 "<<num(8)<<" ms";
+        if(f[9] != "0" || f[10] != "0" || f[11] != "0"){
+            std::cout<<"  (wrong "<<f[9]<<", failed "<<f[10]<<", liveness faults "<<f[11]<<")";
+            rc = 1;
+        }
+        std::cout<<"\n";
+    }
+    removeFixtures(dir);
+    std::cout<<"\nAll modes written to "<<gOpt.csv<<"\n";
+    return rc;
+}
@@ -0,0 +1,208 @@
+// LoadBench.cpp – cost of getting .raw input files into an input buffer
+// build: make -C ../SnpeStandIn && make -C bench   (plain Linux; only Util.cpp is exercised)
+//
+// Three ways of filling the input of one batch, each followed by the same read of every
+// float (what the runtime does with its input):
+//   stream   the former loader: ifstream into a vector per file, appended to a batch
+//            vector, copied into the input buffer (three copies)
+//   mapped   MappedFile, copied straight into the input buffer (one copy)
+//   bound    MappedFile, read in place as a user buffer bound to it would be (no copy;
+//            batch 1 only, since a batch of files is not contiguous)
+// Warm runs read from the page cache; cold runs evict every file with
+// posix_fadvise(DONTNEED) first, so the device's read path is part of the time.
+#include "Util.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<int> sides   {224, 299};     // side × side × 3 float inputs (ImageNet sizes)
+    std::vector<int> batches {1, 4};
+    int files = 32;                          // files per size, cycled through by each pass
+    int reps  = 5;                           // passes per point, the fastest is kept
+    std::string csv = "load_bench.csv";
+};
+static Options gOpt;
+
+enum class Method { STREAM, MAPPED, BOUND };
+static const char* methodName(Method m){ return m == Method::STREAM ? "stream" : m == Method::MAPPED ? "mapped" : "bound"; }
+
+static volatile double gSink;                // keeps the consuming read alive
+
+static double consume(const float* p, size_t n)
+{
+    double s = 0.0;
+    for(size_t i = 0; i < n; ++i) s += p[i];
+    return s;
+}
+
+static void evict(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+static long minorFaults()
+{
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_minflt + ru.ru_majflt;
+}
+
+/* one pass over every file of a size: ms per file and page faults per file ------------ */
+static bool pass(Method m, const std::vector<std::string>& files, size_t batch, size_t floats, bool cold,
+                 std::vector<float>& input, double& msPerFile, double& faultsPerFile)
+{
+    if(cold) for(const auto& f : files) evict(f);
+    const long f0 = minorFaults();
+    const auto t0 = Clock::now();
+    double sum = 0.0;
+    std::vector<MappedFile> bound;
+    for(size_t b = 0; b + batch <= files.size(); b += batch){
+        if(m == Method::STREAM){
+            std::vector<float> batchVec;
+            for(size_t k = 0; k < batch; ++k){
+                std::vector<float> loaded;
+                if(!loadByteDataFile(files[b+k], loaded)) return false;
+                batchVec.insert(batchVec.end(), loaded.begin(), loaded.end());
+            }
+            if(batchVec.size() != input.size()) return false;
+            std::copy(batchVec.begin(), batchVec.end(), input.begin());
+            sum += consume(input.data(), input.size());
+        } else if(m == Method::MAPPED){
+            for(size_t k = 0; k < batch; ++k){
+                MappedFile f(files[b+k]);
+                if(!f.valid() || f.size() != floats*sizeof(float)) return false;
+                std::copy(f.as<float>(), f.as<float>() + floats, input.begin() + k*floats);
+            }
+            sum += consume(input.data(), input.size());
+        } else {
+            MappedFile f(files[b]);
+            if(!f.valid() || f.size() != floats*sizeof(float)) return false;
+            sum += consume(f.as<float>(), floats);
+            bound.clear(); bound.push_back(std::move(f));     // unmapped when the next file is bound
+        }
+    }
+    const size_t n = files.size()/batch*batch;
+    msPerFile = std::chrono::duration<double, std::milli>(Clock::now() - t0).count()/double(n);
+    faultsPerFile = double(minorFaults() - f0)/double(n);
+    gSink = sum;
+    return true;
+}
+
+static bool makeFiles(const std::string& dir, int side, std::vector<std::string>& files)
+{
+    const size_t floats = size_t(side)*side*3;
+    std::vector<float> v(floats);
+    std::mt19937 gen(static_cast<uint32_t>(side));
+    std::uniform_real_distribution<float> px(0.0f, 1.0f);
+    for(int i = 0; i < gOpt.files; ++i){
+        for(auto& x : v) x = px(gen);
+        const std::string path = dir + "/" + std::to_string(side) + "_" + std::to_string(i) + ".raw";
+        files.push_back(path);
+        std::ofstream out(path, std::ofstream::binary);
+        if(!out.write(reinterpret_cast<const char*>(v.data()), std::streamsize(v.size()*sizeof(float)))) return false;
+    }
+    return true;
+}
+
+static bool parseList(const char* s, std::vector<int>& v, int lo, int hi)
+{
+    v.clear();
+    std::stringstream ss(s);
+    for(std::string x; std::getline(ss, x, ','); ){
+        const int k = std::atoi(x.c_str());
+        if(k < lo || k > hi) return false;
+        v.push_back(k);
+    }
+    return !v.empty();
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -s <LIST>   input sides, comma separated: SIDE×SIDE×3 floats (default 224,299)\n"
+             <<"  -b <LIST>   batch sizes (default 1,4)\n"
+             <<"  -f <N>      files per size (default "<<gOpt.files<<")\n"
+             <<"  -n <N>      passes per point, the fastest is reported (default "<<gOpt.reps<<")\n"
+             <<"  -o <FILE>   CSV output (default "<<gOpt.csv<<")\n"
+             <<"Times are ms per input file, loading plus one read of the input; faults are page\n"
+             <<"faults per file. Cold passes evict the files from the page cache first.\n";
+}
+
+int main(int argc, char** argv)
+{
+    for(int opt; (opt = getopt(argc, argv, "hs:b:f:n:o:")) != -1; ){
+        switch(opt){
+            case 's': if(!parseList(optarg, gOpt.sides, 1, 4096)){ usage(argv[0]); return 1; }  break;
+            case 'b': if(!parseList(optarg, gOpt.batches, 1, 64)){ usage(argv[0]); return 1; }  break;
+            case 'f': gOpt.files = std::max(1, std::atoi(optarg)); break;
+            case 'n': gOpt.reps  = std::max(1, std::atoi(optarg)); break;
+            case 'o': gOpt.csv = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+
+    char tmpl[] = "/tmp/load-bench.XXXXXX";
+    if(!mkdtemp(tmpl)){ std::perror("mkdtemp"); return 1; }
+    const std::string dir = tmpl;
+
+    std::ofstream csv(gOpt.csv);
+    csv<<"side,bytes,batch,method,cache,ms_per_file,mib_per_s,faults_per_file\n";
+    std::cout<<std::fixed<<std::setprecision(3);
+    int rc = 0;
+    std::vector<std::string> all;
+    for(int side : gOpt.sides){
+        std::vector<std::string> files;
+        const bool made = makeFiles(dir, side, files);
+        all.insert(all.end(), files.begin(), files.end());
+        if(!made){ std::cerr<<"cannot write inputs to "<<dir<<"\n"; rc = 1; break; }
+        const size_t floats = size_t(side)*side*3, bytes = floats*sizeof(float);
+        std::cout<<"\n=== "<<side<<"×"<<side<<"×3 float ("<<bytes/1024.0<<" KiB), "<<files.size()<<" files ===\n";
+        for(int batch : gOpt.batches){
+            if(size_t(batch) > files.size()) continue;
+            std::vector<float> input(floats*size_t(batch), 1.0f);
+            for(bool cold : {false, true})
+                for(Method m : {Method::STREAM, Method::MAPPED, Method::BOUND}){
+                    if(m == Method::BOUND && batch > 1) continue;
+                    double best = 1e30, faults = 0.0;
+                    for(int r = 0; r < gOpt.reps; ++r){
+                        double ms, fl;
+                        if(!pass(m, files, size_t(batch), floats, cold, input, ms, fl)){
+                            std::cerr<<methodName(m)<<" failed\n"; rc = 1; break; }
+                        if(ms < best){ best = ms; faults = fl; }
+                    }
+                    const double mibs = bytes/1048576.0/(best/1000.0);
+                    std::cout<<"  batch "<<batch<<' '<<(cold ? "cold" : "warm")<<' '<<std::left<<std::setw(7)<<methodName(m)
+                             <<std::right<<std::setw(9)<<best<<" ms/file "<<std::setw(9)<<std::setprecision(0)<<mibs
+                             <<" MiB/s "<<std::setw(7)<<std::setprecision(1)<<faults<<" faults/file\n"<<std::setprecision(3);
+                    csv<<side<<','<<bytes<<','<<batch<<','<<methodName(m)<<','<<(cold ? "cold" : "warm")<<','
+                       <<best<<','<<mibs<<','<<faults<<'\n';
+                }
+        }
+    }
+    for(const auto& f : all) std::remove(f.c_str());
+    rmdir(dir.c_str());
+    return rc;
+}
@@ -0,0 +1,179 @@
+// QuantBench.cpp – FloatToTfN / TfNToFloat per kernel, checked bit for bit against scalar
+// build: make -C ../SnpeStandIn && make -C bench   (plain Linux; only Util.cpp is exercised)
+//
+// For every kernel this CPU runs (GetTfNKernels) and each of TF8 and TF16:
+//   quantize     FloatToTfN with the encoding computed from the data (min/max pass included)
+//   static       FloatToTfN with a given encoding, the quantization loop alone
+//   dequantize   TfNToFloat
+// Inputs are side × side × 3 floats: random pixels, plus values on exact rounding halves,
+// NaN, ±inf and out-of-range values, so the vector rounding and clamping are compared too.
+// Any output differing from the scalar kernel's fails the run.
+#include "Util.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<int> sides {224, 299};       // side × side × 3 float inputs (ImageNet sizes)
+    int reps = 20;                           // runs per point, the fastest is kept
+    std::string csv = "quant_bench.csv";
+};
+static Options gOpt;
+
+enum class Op { QUANTIZE, STATIC, DEQUANTIZE };
+static const char* opName(Op o){ return o == Op::QUANTIZE ? "quantize" : o == Op::STATIC ? "static" : "dequantize"; }
+
+// The static encoding: zero at step 128 of TF8 (of 32768 for TF16), steps of a power of two,
+// so (k + 0.5) steps is exactly representable and lands on a rounding half
+static const unsigned char kStep0 = 128;
+static float stepSize(int bitWidth){ return bitWidth == 8 ? 1.0f/64 : 1.0f/8192; }
+
+static std::vector<float> makeInput(int side, int bitWidth)
+{
+    const size_t n = size_t(side)*side*3;
+    std::vector<float> v(n);
+    std::mt19937 gen(static_cast<uint32_t>(side*bitWidth));
+    std::uniform_real_distribution<float> px(-1.0f, 3.0f);
+    for(auto& x : v) x = px(gen);
+    // Every few hundred elements, a value the rounding or clamping has to get right
+    const float step = stepSize(bitWidth);
+    const float edge[] = { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                           -std::numeric_limits<float>::infinity(), 1e30f, -1e30f, -0.0f };
+    std::uniform_int_distribution<int> k(0, bitWidth == 8 ? 255 : 65535);
+    for(size_t i = 0; i < n; i += 97) v[i] = (k(gen) + 0.5f)*step - kStep0*step;
+    for(size_t i = 0, e = 0; i < n; i += 1009, ++e) v[i] = edge[e % (sizeof(edge)/sizeof(edge[0]))];
+    return v;
+}
+
+// One run of op: output bytes, time in ms, elements converted
+static bool run(Op op, int bitWidth, std::vector<float>& in, std::vector<uint8_t>& q, std::vector<float>& f,
+                std::vector<uint8_t>& out, double& ms, size_t& elems)
+{
+    const size_t n = in.size(), elementSize = size_t(bitWidth/8);
+    unsigned char step0 = kStep0;
+    float step = stepSize(bitWidth);
+    const auto t0 = Clock::now();
+    bool ok = true;
+    elems = n;
+    if(op == Op::DEQUANTIZE){
+        TfNToFloat(f.data(), q.data(), kStep0, stepSize(bitWidth), n, bitWidth);
+    } else {
+        // With NaN and ±inf the data's own range is useless, so quantize runs on the finite
+        // stretches between the special values, the trailing partial one included
+        const size_t m = op == Op::QUANTIZE ? 1009 : n;
+        if(op == Op::QUANTIZE) elems = 0;
+        for(size_t i = 0; op == Op::QUANTIZE && i < n; i += m){
+            const size_t len = std::min(m, n - i) - 1;
+            if(!len) continue;
+            ok = ok && FloatToTfN(q.data() + (i + 1)*elementSize, step0, step, false, in.data() + i + 1, len, bitWidth);
+            elems += len;
+        }
+        if(op == Op::STATIC)
+            ok = FloatToTfN(q.data(), step0, step, true, in.data(), n, bitWidth);
+    }
+    ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    if(op == Op::DEQUANTIZE)
+        out.assign(reinterpret_cast<const uint8_t*>(f.data()), reinterpret_cast<const uint8_t*>(f.data() + n));
+    else
+        out = q;
+    return ok;
+}
+
+static bool parseList(const char* s, std::vector<int>& v, int lo, int hi)
+{
+    v.clear();
+    std::stringstream ss(s);
+    for(std::string x; std::getline(ss, x, ','); ){
+        const int k = std::atoi(x.c_str());
+        if(k < lo || k > hi) return false;
+        v.push_back(k);
+    }
+    return !v.empty();
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -s <LIST>   input sides, comma separated: SIDE×SIDE×3 floats (default 224,299)\n"
+             <<"  -n <N>      runs per point, the fastest is reported (default "<<gOpt.reps<<")\n"
+             <<"  -o <FILE>   CSV output (default "<<gOpt.csv<<")\n"
+             <<"Times are ms per input; every kernel's output is compared with the scalar one's.\n";
+}
+
+int main(int argc, char** argv)
+{
+    for(int opt; (opt = getopt(argc, argv, "hs:n:o:")) != -1; ){
+        switch(opt){
+            case 's': if(!parseList(optarg, gOpt.sides, 4, 4096)){ usage(argv[0]); return 1; }  break;
+            case 'n': gOpt.reps = std::max(1, std::atoi(optarg)); break;
+            case 'o': gOpt.csv = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+
+    const std::vector<std::string> kernels = GetTfNKernels();
+    std::cout<<"kernels: ";
+    for(const auto& k : kernels) std::cout<<k<<' ';
+    std::cout<<"(default "<<GetTfNKernel()<<")\n"<<std::fixed<<std::setprecision(3);
+
+    std::ofstream csv(gOpt.csv);
+    csv<<"side,elements,bits,op,kernel,ms,melem_per_s,speedup,identical\n";
+    int rc = 0;
+    for(int side : gOpt.sides)
+        for(int bitWidth : {8, 16}){
+            std::vector<float> in = makeInput(side, bitWidth);
+            const size_t n = in.size();
+            std::cout<<"\n=== "<<side<<"×"<<side<<"×3, TF"<<bitWidth<<" ("<<n<<" elements) ===\n";
+            // The dequantize input is the static quantization of the data
+            std::vector<uint8_t> codes(n*bitWidth/8), q(codes.size());
+            std::vector<float> f(n), scratch(n);
+            SetTfNKernel("scalar");
+            double unused;
+            size_t unusedElems;
+            std::vector<uint8_t> tmp;
+            run(Op::STATIC, bitWidth, in, codes, scratch, tmp, unused, unusedElems);
+            for(Op op : {Op::QUANTIZE, Op::STATIC, Op::DEQUANTIZE}){
+                std::vector<uint8_t> reference;
+                double scalarMs = 0.0;
+                for(auto it = kernels.rbegin(); it != kernels.rend(); ++it){     // scalar first
+                    SetTfNKernel(*it);
+                    double best = 1e30;
+                    size_t elems = n;
+                    std::vector<uint8_t> out;
+                    for(int r = 0; r < gOpt.reps; ++r){
+                        q = codes;
+                        double ms;
+                        if(!run(op, bitWidth, in, q, f, out, ms, elems)){ std::cerr<<opName(op)<<" failed\n"; rc = 1; }
+                        best = std::min(best, ms);
+                    }
+                    if(*it == "scalar"){ reference = out; scalarMs = best; }
+                    const bool same = out == reference;
+                    if(!same){ std::cerr<<*it<<' '<<opName(op)<<" TF"<<bitWidth<<" differs from scalar\n"; rc = 1; }
+                    const double melems = elems/1e6/(best/1000.0);
+                    std::cout<<"  "<<std::left<<std::setw(11)<<opName(op)<<std::setw(7)<<*it<<std::right
+                             <<std::setw(9)<<best<<" ms "<<std::setw(9)<<std::setprecision(1)<<melems<<" Melem/s "
+                             <<std::setw(6)<<scalarMs/best<<"x"<<(same ? "" : "  MISMATCH")<<'\n'<<std::setprecision(3);
+                    csv<<side<<','<<n<<','<<bitWidth<<','<<opName(op)<<','<<*it<<','<<best<<','<<melems<<','
+                       <<scalarMs/best<<','<<(same ? 1 : 0)<<'\n';
+                }
+            }
+        }
+    SetTfNKernel(kernels.front());
+    return rc;
+}
@@ -0,0 +1,279 @@
+// SchedBench.cpp – overhead of the scheduler itself: dsched on no‑op executors
+// build: make -C ../SnpeStandIn && make -C bench   (plain Linux, against the SNPE stand‑in)
+//
+// Every execute() returns at once, so what is measured is what dsched adds per request:
+// the policy decision, the queue push and pop, the map lookups, the hand‑off to the
+// runtime worker (and stager / poster when pipelined), the staging copy and top‑1 of the
+// small default frame, the completion callback and the stand‑in's own execute() path.
+// Each (mode, runtimes, models) point runs in a forked child, because the service
+// registers its models and starts its threads once per process.
+#include "Scheduler.hpp"
+
+#include "StandIn/Executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using dsched::Clock;
+using dsched::Policy;
+using dsched::Runtime_t;
+
+constexpr size_t kFrameFloats = 16;          // input and output of every bench network
+constexpr double kSlackMs     = 50.0;        // relative deadline of every request
+
+struct Options {
+    uint64_t requests = 20000;               // measured requests per point
+    std::vector<int> models   {1, 4, 16, 64};
+    std::vector<int> runtimes {1, 2, 3};
+    std::vector<int> windows  {1, 64};       // requests outstanding at a time
+    std::vector<bool> pipeline{false, true};
+    std::string csv = "sched_overhead.csv";
+};
+static Options gOpt;
+
+/* executes nothing on the first n of CPU, GPU, DSP ---------------------------------- */
+class NoopExecutor : public standin::Executor {
+public:
+    explicit NoopExecutor(int runtimes) : m_runtimes(runtimes) {}
+    bool available(Runtime_t rt) override { return index(rt) < m_runtimes; }
+    bool describe(const std::string&, Runtime_t rt, standin::NetworkShape& shape) override
+    {
+        if(!available(rt)) return false;
+        shape.inputs  = { { "input",  zdl::DlSystem::TensorShape{ 1, kFrameFloats } } };
+        shape.outputs = { { "output", zdl::DlSystem::TensorShape{ 1, kFrameFloats } } };
+        return true;
+    }
+    bool execute(const standin::Call&) override { return true; }
+private:
+    static int index(Runtime_t rt){ return rt==Runtime_t::CPU ? 0 : rt==Runtime_t::GPU ? 1 : rt==Runtime_t::DSP ? 2 : 3; }
+    int m_runtimes;
+};
+
+/* one measured point ----------------------------------------------------------------- */
+struct Point {
+    double wallUs, cpuUs, submitUs;          // per request
+    double respP50Us, respP99Us;             // release to completion
+    double vcsw, ivcsw;                      // context switches per request, all threads
+    uint64_t failed;
+};
+
+static double pct(std::vector<float> v, double p)
+{
+    if(v.empty()) return 0.0;
+    auto k = v.begin() + std::min(v.size()-1, size_t(p*v.size()));
+    std::nth_element(v.begin(), k, v.end());
+    return *k;
+}
+inline double usOf(const timeval& t){ return t.tv_sec*1e6 + t.tv_usec; }
+
+// Closed loop: at most `window` requests outstanding, a new one submitted as soon as a
+// completion frees its place, round robin over the models.
+static Point drive(int models, int window, uint64_t n)
+{
+    std::mutex m; std::condition_variable cv;
+    int free = window; uint64_t done = 0;
+    std::atomic<uint64_t> failed{0};
+    std::vector<float> resp(n);
+    double submitNs = 0.0;
+
+    rusage r0, r1; getrusage(RUSAGE_SELF, &r0);
+    const auto t0 = Clock::now();
+    for(uint64_t i = 0; i < n; ++i){
+        { std::unique_lock<std::mutex> lk(m); cv.wait(lk, [&]{ return free > 0; }); --free; }
+        const auto s0 = Clock::now();
+        dsched::submit(int(i % models), dsched::InputView(),
+                       s0 + std::chrono::microseconds(int64_t(kSlackMs*1000.0)),
+                       [&, i](dsched::Result&& r){
+                           resp[i] = float(std::chrono::duration<double,std::micro>(r.completed - r.released).count());
+                           if(r.status != dsched::Status::OK) failed++;
+                           { std::lock_guard<std::mutex> lk(m); ++free; ++done; }
+                           cv.notify_one();
+                       }, s0);
+        submitNs += std::chrono::duration<double,std::nano>(Clock::now() - s0).count();
+    }
+    { std::unique_lock<std::mutex> lk(m); cv.wait(lk, [&]{ return done == n; }); }
+    const auto t1 = Clock::now();
+    getrusage(RUSAGE_SELF, &r1);
+
+    Point p;
+    p.wallUs    = std::chrono::duration<double,std::micro>(t1 - t0).count()/n;
+    p.cpuUs     = (usOf(r1.ru_utime) + usOf(r1.ru_stime) - usOf(r0.ru_utime) - usOf(r0.ru_stime))/n;
+    p.submitUs  = submitNs/1000.0/n;
+    p.respP50Us = pct(resp, 0.5);
+    p.respP99Us = pct(resp, 0.99);
+    p.vcsw      = double(r1.ru_nvcsw  - r0.ru_nvcsw)/n;
+    p.ivcsw     = double(r1.ru_nivcsw - r0.ru_nivcsw)/n;
+    p.failed    = failed;
+    return p;
+}
+
+// Child process: bring the service up on no‑op executors, sweep policies and windows,
+// one CSV line per point to fd.
+static int runConfig(bool pipeline, int runtimes, int models, const std::string& dir, int fd)
+{
+    standin::setExecutor(std::make_shared<NoopExecutor>(runtimes));
+    dsched::ServiceConfig sc; sc.pipeline = pipeline;
+    dsched::init(sc);
+    for(int i = 0; i < models; ++i){
+        dsched::ModelConfig mc;
+        mc.dlc = dir + "/bench" + std::to_string(i) + ".dlc";
+        mc.inputList = dir + "/input_list.txt";
+        if(dsched::registerModel(mc) != i){ std::cerr<<"cannot register "<<mc.dlc<<"\n"; return 1; }
+        dsched::setStaticRuntime(i, i % runtimes);
+    }
+    dsched::start();
+    std::ostringstream out;
+    for(int p = int(Policy::CPU_ONLY); p <= int(Policy::BANDIT); ++p){
+        dsched::setPolicy(Policy(p));
+        for(int w : gOpt.windows){
+            dsched::resetLearning();
+            drive(models, w, std::max<uint64_t>(1, gOpt.requests/10));      // warm‑up
+            const Point r = drive(models, w, gOpt.requests);
+            out<<(pipeline ? "pipeline" : "serial")<<','<<runtimes<<','<<models<<','
+               <<dsched::policyName(Policy(p))<<','<<w<<','<<r.wallUs<<','<<r.cpuUs<<','<<r.submitUs<<','
+               <<r.respP50Us<<','<<r.respP99Us<<','<<r.vcsw<<','<<r.ivcsw<<','<<r.failed<<'\n';
+        }
+    }
+    dsched::stop();
+    const std::string s = out.str();
+    for(size_t k = 0; k < s.size(); ){
+        const ssize_t w = write(fd, s.data() + k, s.size() - k);
+        if(w <= 0) return 1;
+        k += size_t(w);
+    }
+    return 0;
+}
+
+/* dummy containers and one zero frame the input lists point at -------------------- */
+static bool makeFixtures(const std::string& dir, int models)
+{
+    const std::vector<float> frame(kFrameFloats, 0.0f);
+    std::ofstream raw(dir + "/frame.raw", std::ios::binary);
+    raw.write(reinterpret_cast<const char*>(frame.data()), frame.size()*sizeof(float));
+    std::ofstream list(dir + "/input_list.txt");
+    list<<dir<<"/frame.raw\n";
+    for(int i = 0; i < models; ++i) std::ofstream(dir + "/bench" + std::to_string(i) + ".dlc")<<"stand‑in\n";
+    return raw.good() && list.good();
+}
+static void removeFixtures(const std::string& dir, int models)
+{
+    for(int i = 0; i < models; ++i) std::remove((dir + "/bench" + std::to_string(i) + ".dlc").c_str());
+    std::remove((dir + "/frame.raw").c_str());
+    std::remove((dir + "/input_list.txt").c_str());
+    rmdir(dir.c_str());
+}
+
+static bool parseList(const char* s, std::vector<int>& v, int lo, int hi)
+{
+    v.clear();
+    std::stringstream ss(s);
+    for(std::string x; std::getline(ss, x, ','); ){
+        const int k = std::atoi(x.c_str());
+        if(k < lo || k > hi) return false;
+        v.push_back(k);
+    }
+    return !v.empty();
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -n <N>      measured requests per point (default "<<gOpt.requests<<"), after N/10 warm‑up\n"
+             <<"  -m <LIST>   registered models, comma separated (default 1,4,16,64; at most "<<dsched::kMaxModels<<")\n"
+             <<"  -r <LIST>   available runtimes, the first 1‑3 of CPU, GPU, DSP (default 1,2,3)\n"
+             <<"  -w <LIST>   requests outstanding at a time (default 1,64); 1 measures the round trip,\n"
+             <<"              larger windows the throughput cost of a request\n"
+             <<"  -x <MODE>   serial, pipeline or both (default both), as snpe-sample without and with -x\n"
+             <<"  -o <FILE>   CSV output (default "<<gOpt.csv<<")\n"
+             <<"Every policy is measured at every point; times are µs and context switches (voluntary /\n"
+             <<"involuntary, all threads) per request.\n";
+}
+
+int main(int argc, char** argv)
+{
+    for(int opt; (opt = getopt(argc, argv, "hn:m:r:w:x:o:")) != -1; ){
+        switch(opt){
+            case 'n': gOpt.requests = std::max(1ULL, std::strtoull(optarg, nullptr, 0)); break;
+            case 'm': if(!parseList(optarg, gOpt.models, 1, dsched::kMaxModels)){ usage(argv[0]); return 1; } break;
+            case 'r': if(!parseList(optarg, gOpt.runtimes, 1, 3)){ usage(argv[0]); return 1; }  break;
+            case 'w': if(!parseList(optarg, gOpt.windows, 1, 1<<20)){ usage(argv[0]); return 1; } break;
+            case 'x':
+                if     (!std::strcmp(optarg, "serial"))   gOpt.pipeline = { false };
+                else if(!std::strcmp(optarg, "pipeline")) gOpt.pipeline = { true };
+                else if(!std::strcmp(optarg, "both"))     gOpt.pipeline = { false, true };
+                else { usage(argv[0]); return 1; }
+                break;
+            case 'o': gOpt.csv = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+
+    char tmpl[] = "/tmp/dsched-bench.XXXXXX";
+    if(!mkdtemp(tmpl)){ std::perror("mkdtemp"); return 1; }
+    const std::string dir = tmpl;
+    const int maxModels = *std::max_element(gOpt.models.begin(), gOpt.models.end());
+    if(!makeFixtures(dir, maxModels)){ std::cerr<<"cannot write fixtures to "<<dir<<"\n"; removeFixtures(dir, maxModels); return 1; }
+
+    std::ofstream csv(gOpt.csv);
+    csv<<"mode,runtimes,models,policy,window,wall_us,cpu_us,submit_us,resp_p50_us,resp_p99_us,"
+         "vcsw_per_req,ivcsw_per_req,failed\n";
+    std::cout<<gOpt.requests<<" no‑op requests per point; µs per request (wall / CPU / in submit), "
+               "response p50 / p99 µs, context switches per request (vol / invol)\n"
+             <<std::fixed<<std::setprecision(2);
+    int rc = 0;
+    for(bool pipe : gOpt.pipeline) for(int rts : gOpt.runtimes) for(int models : gOpt.models){
+        int fds[2];
+        if(pipe2(fds, O_CLOEXEC) != 0){ std::perror("pipe"); rc = 1; break; }
+        std::cout.flush();
+        const pid_t pid = fork();
+        if(pid < 0){ std::perror("fork"); close(fds[0]); close(fds[1]); rc = 1; break; }
+        if(pid == 0){ close(fds[0]); _exit(runConfig(pipe, rts, models, dir, fds[1])); }
+        close(fds[1]);
+        std::string lines; char buf[4096];
+        for(ssize_t k; (k = read(fds[0], buf, sizeof buf)) > 0; ) lines.append(buf, size_t(k));
+        close(fds[0]);
+        int st = 0; waitpid(pid, &st, 0);
+        if(!WIFEXITED(st) || WEXITSTATUS(st) != 0){
+            std::cerr<<(pipe ? "pipeline" : "serial")<<' '<<rts<<" runtimes "<<models<<" models: failed\n";
+            rc = 1; continue;
+        }
+        csv<<lines;
+        std::cout<<"\n=== "<<(pipe ? "pipeline" : "serial")<<", "<<rts<<" runtime(s), "<<models<<" model(s) ===\n";
+        std::stringstream ls(lines);
+        for(std::string l; std::getline(ls, l); ){
+            std::vector<std::string> f;
+            std::stringstream fs(l);
+            for(std::string x; std::getline(fs, x, ','); ) f.push_back(x);
+            std::cout<<"  "<<std::left<<std::setw(10)<<f[3]<<" window "<<std::right<<std::setw(3)<<f[4]<<": "
+                     <<std::setw(7)<<std::atof(f[5].c_str())<<" / "<<std::setw(7)<<std::atof(f[6].c_str())<<" / "
+                     <<std::setw(5)<<std::atof(f[7].c_str())<<" µs,  resp "<<std::setw(7)<<std::atof(f[8].c_str())
+                     <<" / "<<std::setw(8)<<std::atof(f[9].c_str())<<" µs,  csw "<<std::atof(f[10].c_str())
+                     <<" / "<<std::atof(f[11].c_str());
+            if(f[12] != "0") std::cout<<"  ("<<f[12]<<" failed)";
+            std::cout<<"\n";
+        }
+    }
+    removeFixtures(dir, maxModels);
+    std::cout<<"\nAll points written to "<<gOpt.csv<<"\n";
+    return rc;
+}
@@ -0,0 +1,122 @@
+// YuvBench.cpp – camera-frame preprocessing per kernel and stage, checked against scalar
+// build: make -C bench yuv-bench   (plain Linux; only YuvPreprocess.cpp is exercised)
+//
+// For every kernel this CPU runs (GetYuvKernels), NV21 frames of each camera size are
+// preprocessed to each model input size, mean / scale normalized (-N): the time of the
+// convert, resize and normalize stages and of the whole frame. Frames are random bytes,
+// so every clamp of the colour conversion is hit. Any output differing from the scalar
+// kernel's is reported; the run fails if one is off by more than a float rounding.
+#include "YuvPreprocess.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <getopt.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Size { size_t w, h; };
+
+struct Options {
+    std::vector<Size> frames {{640, 480}, {1280, 720}, {1920, 1080}};   // camera frames
+    std::vector<Size> outs   {{224, 224}, {299, 299}};                  // model inputs
+    std::string norm = "127.5:0.0078125";    // to [-1, 1], as MobileNet / Inception take it
+    int reps = 20;                           // runs per point, the fastest is kept
+    std::string csv = "yuv_bench.csv";
+};
+static Options gOpt;
+
+static bool parseSizes(const char* s, std::vector<Size>& v)
+{
+    v.clear();
+    std::stringstream ss(s);
+    for(std::string x; std::getline(ss, x, ','); ){
+        YuvFrame f;
+        if(!ParseYuvFormat(x, f) || f.width > 16384 || f.height > 16384) return false;
+        v.push_back({ f.width, f.height });
+    }
+    return !v.empty();
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -f <LIST>   camera frames, comma separated WxH (default 640x480,1280x720,1920x1080)\n"
+             <<"  -s <LIST>   model input sizes, comma separated WxH (default 224x224,299x299)\n"
+             <<"  -N <M[:S]>  normalization (pixel - M) * S, one value or R,G,B (default "<<gOpt.norm<<")\n"
+             <<"  -n <N>      runs per point, the fastest is reported (default "<<gOpt.reps<<")\n"
+             <<"  -o <FILE>   CSV output (default "<<gOpt.csv<<")\n"
+             <<"Times are ms per frame; every kernel's output is compared with the scalar one's.\n";
+}
+
+int main(int argc, char** argv)
+{
+    for(int opt; (opt = getopt(argc, argv, "hf:s:N:n:o:")) != -1; ){
+        switch(opt){
+            case 'f': if(!parseSizes(optarg, gOpt.frames)){ usage(argv[0]); return 1; } break;
+            case 's': if(!parseSizes(optarg, gOpt.outs)){ usage(argv[0]); return 1; }   break;
+            case 'N': gOpt.norm = optarg; break;
+            case 'n': gOpt.reps = std::max(1, std::atoi(optarg)); break;
+            case 'o': gOpt.csv = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+    PixelNormalization norm;
+    if(!ParsePixelNormalization(gOpt.norm, norm)){ usage(argv[0]); return 1; }
+
+    const std::vector<std::string> kernels = GetYuvKernels();
+    std::cout<<"kernels: ";
+    for(const auto& k : kernels) std::cout<<k<<' ';
+    std::cout<<"(default "<<GetYuvKernel()<<")\n"<<std::fixed<<std::setprecision(3);
+
+    std::ofstream csv(gOpt.csv);
+    csv<<"frame,input,kernel,convert_ms,resize_ms,normalize_ms,total_ms,fps,speedup,max_diff\n";
+    int rc = 0;
+    std::mt19937 gen(1);
+    for(const Size& fs : gOpt.frames){
+        std::vector<uint8_t> bytes(YuvFrameBytes(fs.w, fs.h));
+        for(auto& b : bytes) b = static_cast<uint8_t>(gen());
+        YuvFrame frame;
+        frame.data = bytes.data(); frame.width = fs.w; frame.height = fs.h;
+        for(const Size& os : gOpt.outs){
+            std::cout<<"\n=== NV21 "<<fs.w<<"×"<<fs.h<<" → "<<os.w<<"×"<<os.h<<"×3 ===\n";
+            std::vector<float> reference, out(os.w*os.h*3);
+            double scalarMs = 0.0;
+            for(auto it = kernels.rbegin(); it != kernels.rend(); ++it){     // scalar first
+                SetYuvKernel(*it);
+                PreprocessTimes best;
+                double bestMs = 1e30;
+                for(int r = 0; r < gOpt.reps; ++r){
+                    PreprocessTimes t;
+                    const auto t0 = Clock::now();
+                    if(!PreprocessYuvFrame(frame, os.w, os.h, norm, out.data(), &t)){ rc = 1; break; }
+                    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+                    if(ms < bestMs){ bestMs = ms; best = t; }
+                }
+                if(*it == "scalar"){ reference = out; scalarMs = bestMs; }
+                double diff = 0.0;
+                for(size_t i = 0; i < out.size(); ++i) diff = std::max(diff, double(std::fabs(out[i] - reference[i])));
+                if(diff > 1e-5){ std::cerr<<*it<<" differs from scalar by "<<diff<<"\n"; rc = 1; }
+                std::cout<<"  "<<std::left<<std::setw(7)<<*it<<std::right
+                         <<" convert "<<std::setw(7)<<best.convertMs<<"  resize "<<std::setw(7)<<best.resizeMs
+                         <<"  normalize "<<std::setw(7)<<best.normalizeMs<<"  total "<<std::setw(7)<<bestMs<<" ms "
+                         <<std::setw(8)<<std::setprecision(1)<<1000.0/bestMs<<" fps "<<std::setw(5)<<scalarMs/bestMs<<"x"
+                         <<(diff > 0.0 ? "  (max diff " + std::to_string(diff) + ")" : "")<<'\n'<<std::setprecision(3);
+                csv<<fs.w<<'x'<<fs.h<<','<<os.w<<'x'<<os.h<<','<<*it<<','<<best.convertMs<<','<<best.resizeMs<<','
+                   <<best.normalizeMs<<','<<bestMs<<','<<1000.0/bestMs<<','<<scalarMs/bestMs<<','<<diff<<'\n';
+            }
+        }
+    }
+    SetYuvKernel(kernels.front());
+    return rc;
+}
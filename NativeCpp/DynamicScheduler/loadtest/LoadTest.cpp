@@ -0,0 +1,234 @@
+// LoadTest.cpp – load‑test client for the scheduler daemon (snpe-sample -D)
+// build: make -C loadtest   (plain Linux, no SNPE needed)
+#include "Arrivals.hpp"
+#include "DaemonClient.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <getopt.h>
+
+using Clock = std::chrono::steady_clock;
+
+/* one request stream = one connection, as a separate client process would open ---- */
+struct Stream {
+    std::string model;           // name the daemon serves
+    double fps = 30.0;
+    double deadlineMs = 0.0;     // 0 = one period
+    int    prio = 0;
+    /* results */
+    uint64_t sent = 0, ok = 0, late = 0, failed = 0;
+    uint64_t dropped = 0, copied = 0, frameBytes = 0;   // ring: no free slot, bytes the daemon copied
+    std::vector<float> resp, queue, exec;
+    std::array<uint64_t,3> perRt{{0,0,0}};
+    std::string error;
+};
+
+struct Options {
+    std::string socket = "/tmp/dsched.sock";
+    double durSec = 10.0;
+    int    clients = 1;          // connections per -m stream
+    ArrivalModel arrivals;
+    uint64_t seed = 1;
+    bool   payload = true;       // send a frame (false: the daemon's default frame)
+    bool   output  = false;      // ask for the output tensors
+    uint32_t ringSlots = 0;      // > 0: frames through a shared‑memory ring of that many slots
+    std::string csv;
+};
+static Options gOpt;
+
+// NAME[:FPS[:DEADLINE_MS[:PRIO]]]
+static bool parseStream(const std::string& spec, Stream& s)
+{
+    std::vector<std::string> f;
+    std::stringstream ss(spec);
+    for(std::string x; std::getline(ss, x, ':'); ) f.push_back(x);
+    if(f.empty() || f[0].empty() || f.size() > 4) return false;
+    s.model = f[0];
+    if(f.size() > 1) s.fps        = std::atof(f[1].c_str());
+    if(f.size() > 2) s.deadlineMs = std::atof(f[2].c_str());
+    if(f.size() > 3) s.prio       = std::atoi(f[3].c_str());
+    return s.fps > 0.0 && s.deadlineMs >= 0.0;
+}
+
+// Producer side of a shared‑memory ring: the frame is written straight into a slot, as a
+// camera would, and a second thread reaps the completions as they arrive.
+static void runRing(Stream& s, DaemonClient& cl, int id, const std::vector<float>& pattern,
+                    const std::vector<Arrival>& arr, std::chrono::microseconds dl)
+{
+    std::unique_ptr<FrameRing> ring = cl.attach(id, gOpt.ringSlots);
+    if(!ring){ s.error = "daemon refused a ring for "+s.model; return; }
+    s.frameBytes = ring->frameFloats()*sizeof(float);
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<bool> last{false};
+    std::thread reaper([&]{
+        uint64_t got = 0;
+        Clock::time_point giveUp = Clock::time_point::max();
+        while(!last || got < submitted){
+            if(last && giveUp == Clock::time_point::max()) giveUp = Clock::now() + std::chrono::seconds(5);
+            if(Clock::now() > giveUp) break;
+            DaemonReply r; size_t staged = 0;
+            if(!ring->next(r, &staged)) continue;
+            got++;
+            s.copied += staged;
+            if(r.status != DaemonStatus::OK){ s.failed++; continue; }
+            s.ok++; if(r.late) s.late++;
+            s.resp.push_back(float(r.respMs)); s.queue.push_back(float(r.queueMs)); s.exec.push_back(float(r.execMs));
+            if(r.runtime >= 0 && r.runtime < 3) s.perRt[r.runtime]++;
+        }
+        s.failed += submitted - got;                          // never completed
+    });
+    const auto start = Clock::now();
+    for(const auto& a : arr){
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(a.t)));
+        s.sent++;
+        const int k = ring->acquire();
+        if(k < 0){ s.dropped++; continue; }                    // every slot in flight: frame lost
+        std::copy(pattern.begin(), pattern.begin() + std::min<size_t>(pattern.size(), ring->frameFloats()),
+                  ring->frame(uint32_t(k)));
+        ring->submit(uint32_t(k), dl, s.prio);
+        submitted++;
+    }
+    last = true;
+    reaper.join();
+}
+
+static void runStream(Stream& s, uint64_t seed)
+{
+    DaemonClient cl;
+    if(!cl.connect(gOpt.socket)){ s.error = "cannot connect to "+gOpt.socket; return; }
+    uint32_t n = 0;
+    const int id = cl.open(s.model, &n);
+    if(id < 0){ s.error = "daemon does not serve "+s.model; return; }
+
+    std::vector<float> frame(gOpt.payload || gOpt.ringSlots ? n : 0);
+    std::mt19937 g(static_cast<uint32_t>(seed));
+    std::uniform_real_distribution<float> U(0.0f, 1.0f);
+    for(auto& v : frame) v = U(g);
+
+    const auto dl = std::chrono::microseconds(int64_t(1e3*(s.deadlineMs > 0.0 ? s.deadlineMs : 1e3/s.fps)));
+    const auto arr = makeArrivals({ { s.fps, 1.0 } }, gOpt.arrivals, gOpt.durSec, seed);
+    if(gOpt.ringSlots){ runRing(s, cl, id, frame, arr, dl); return; }
+    std::deque<std::future<DaemonReply>> pending;
+    const auto start = Clock::now();
+    for(const auto& a : arr){
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(a.t)));
+        pending.push_back(cl.submit(id, frame.data(), uint32_t(frame.size()), dl, s.prio, gOpt.output));
+        s.sent++;
+    }
+    for(auto& f : pending){
+        DaemonReply r = f.get();
+        if(r.status != DaemonStatus::OK){ s.failed++; continue; }
+        s.ok++; if(r.late) s.late++;
+        s.resp.push_back(float(r.respMs)); s.queue.push_back(float(r.queueMs)); s.exec.push_back(float(r.execMs));
+        if(r.runtime >= 0 && r.runtime < 3) s.perRt[r.runtime]++;
+    }
+}
+
+static double pct(std::vector<float> v, double p)
+{
+    if(v.empty()) return 0.0;
+    auto k = v.begin() + std::min(v.size()-1, size_t(p*v.size()));
+    std::nth_element(v.begin(), k, v.end());
+    return *k;
+}
+static double mean(const std::vector<float>& v)
+{
+    double s = 0.0; for(float x : v) s += x;
+    return v.empty() ? 0.0 : s/v.size();
+}
+
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" -m NAME[:FPS[:DEADLINE_MS[:PRIO]]] [-m …] [options]\n"
+             <<"  -m <STREAM> request stream: model name as served by the daemon, release rate\n"
+             <<"              (default 30), relative deadline (default one period) and priority\n"
+             <<"  -s <PATH>   daemon socket (default "<<gOpt.socket<<")\n"
+             <<"  -n <N>      connections per stream, like N client processes (default 1)\n"
+             <<"  -d <SEC>    duration (default "<<gOpt.durSec<<")\n"
+             <<"  -A <ARR>    arrival process, as snpe-sample -A (default periodic)\n"
+             <<"  -S <SEED>   seed of the arrivals and frames (default "<<gOpt.seed<<")\n"
+             <<"  -z          send no frame, the daemon runs the model's default input\n"
+             <<"  -o          request the output tensors with every result\n"
+             <<"  -R <SLOTS>  write the frames into a shared‑memory ring of SLOTS frames instead of\n"
+             <<"              sending them (zero‑copy with snpe-sample -D -x); reports the bytes saved\n"
+             <<"  -w <FILE>   also write the per‑connection results as CSV\n";
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<Stream> specs;
+    for(int opt; (opt = getopt(argc, argv, "hm:s:n:d:A:S:zoR:w:")) != -1; ){
+        switch(opt){
+            case 'm': { Stream s; if(!parseStream(optarg, s)){ usage(argv[0]); return 1; } specs.push_back(s); } break;
+            case 's': gOpt.socket  = optarg;                              break;
+            case 'n': gOpt.clients = std::max(1, std::atoi(optarg));      break;
+            case 'd': gOpt.durSec  = std::max(0.1, std::atof(optarg));    break;
+            case 'A': if(!parseArrivalModel(optarg, gOpt.arrivals)){ usage(argv[0]); return 1; } break;
+            case 'S': gOpt.seed    = std::strtoull(optarg, nullptr, 0);   break;
+            case 'z': gOpt.payload = false;                               break;
+            case 'o': gOpt.output  = true;                                break;
+            case 'R': gOpt.ringSlots = uint32_t(std::max(1, std::atoi(optarg)));   break;
+            case 'w': gOpt.csv     = optarg;                              break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+    if(specs.empty()){ usage(argv[0]); return 1; }
+
+    std::vector<Stream> streams;
+    for(const auto& s : specs) for(int c=0;c<gOpt.clients;++c) streams.push_back(s);
+    std::cout<<streams.size()<<" connections to "<<gOpt.socket<<" for "<<gOpt.durSec<<" s, arrivals "
+             <<arrivalModelName(gOpt.arrivals);
+    if(gOpt.ringSlots) std::cout<<", shared‑memory rings of "<<gOpt.ringSlots<<" slots";
+    std::cout<<"\n";
+    std::vector<std::thread> th;
+    for(size_t i=0;i<streams.size();++i) th.emplace_back(runStream, std::ref(streams[i]), gOpt.seed + i);
+    for(auto& t : th) t.join();
+
+    std::ofstream csv;
+    if(!gOpt.csv.empty()){
+        csv.open(gOpt.csv);
+        csv<<"client,model,fps,deadline_ms,priority,sent,ok,late,failed,resp_mean_ms,resp_p50_ms,resp_p99_ms,"
+             "queue_mean_ms,exec_mean_ms,cpu,gpu,dsp,dropped,copied_bytes,saved_bytes\n";
+    }
+    // Over the socket every frame is copied into the kernel, out of it into the daemon and
+    // once more into an input set; through a ring only what the daemon reports as staged.
+    int rc = 0;
+    uint64_t saved = 0, copied = 0;
+    for(size_t i=0;i<streams.size();++i){
+        const Stream& s = streams[i];
+        if(!s.error.empty()){ std::cerr<<"client "<<i<<": "<<s.error<<"\n"; rc = 1; continue; }
+        const double miss = s.sent ? 100.0*double(s.late + s.failed + s.dropped)/s.sent : 0.0;
+        const uint64_t sv = gOpt.ringSlots ? 3*s.frameBytes*(s.ok + s.failed) - s.copied : 0;
+        saved += sv; copied += s.copied;
+        std::cout<<"client "<<i<<" "<<s.model<<" prio "<<s.prio<<": "<<s.sent<<" sent, "<<s.ok<<" ok, "
+                 <<miss<<"% late or failed, response mean "<<mean(s.resp)<<" / p50 "<<pct(s.resp,0.5)
+                 <<" / p99 "<<pct(s.resp,0.99)<<" ms (queue "<<mean(s.queue)<<", execute "<<mean(s.exec)
+                 <<"), CPU/GPU/DSP "<<s.perRt[0]<<'/'<<s.perRt[1]<<'/'<<s.perRt[2];
+        if(gOpt.ringSlots) std::cout<<", "<<s.dropped<<" dropped (no free slot)";
+        std::cout<<"\n";
+        if(csv.is_open())
+            csv<<i<<','<<s.model<<','<<s.fps<<','<<s.deadlineMs<<','<<s.prio<<','<<s.sent<<','<<s.ok<<','
+               <<s.late<<','<<s.failed<<','<<mean(s.resp)<<','<<pct(s.resp,0.5)<<','<<pct(s.resp,0.99)<<','
+               <<mean(s.queue)<<','<<mean(s.exec)<<','<<s.perRt[0]<<','<<s.perRt[1]<<','<<s.perRt[2]<<','
+               <<s.dropped<<','<<s.copied<<','<<sv<<'\n';
+    }
+    if(gOpt.ringSlots)
+        std::cout<<"copies: "<<copied/1048576.0<<" MiB staged by the daemon, "<<saved/1048576.0
+                 <<" MiB saved against the socket path\n";
+    return rc;
+}
@@ -1,310 +1,1038 @@
 // realtime_scheduler.cpp
 // build: g++ -std=c++14 -pthread … -lsnpe_*
-#include <SNPE/SNPE.hpp>
 #include <SNPE/SNPEFactory.hpp>
 
-#include "DlContainer/IDlContainer.hpp"
-#include "DlSystem/SNPEPerfProfile.h"
-#include "LoadContainer.hpp"
-#include "LoadInputTensor.hpp"
-#include "PreprocessInput.hpp"
-#include "SetBuilderOptions.hpp"
+#include "Arrivals.hpp"
+#include "Daemon.hpp"
+#include "RealTime.hpp"
+#include "Scheduler.hpp"
+#include "StaticAssign.hpp"
+#include "Topology.hpp"
+#include "Util.hpp"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
+#include <cmath>
+#include <csignal>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <mutex>
-#include <queue>
 #include <random>
 #include <set>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
-#include <pthread.h>
-#include <sched.h>
-#include <sys/syscall.h>
+#include <getopt.h>
 #include <unistd.h>
 
 using zdl::DlSystem::Runtime_t;
 using Clock = std::chrono::steady_clock;
+using dsched::Policy;
+using dsched::policyName;
+using dsched::runtimeName;
 
 /* ───────────────────────────────── workload definitions ────────────────────────── */
-struct ModelSpec { std::string dlc; double fps, prob; std::string list; };
+// prio  : models with the highest prio of their scenario are critical, all others are
+//         best‑effort and may be slowed down by the adaptive frame‑rate controller (-a)
+// weight: share of runtime time a model is guaranteed under weighted fair queuing (-q)
+struct ModelSpec { std::string dlc; double fps, prob; std::string list; int prio; double weight; };
 using Scenario   = std::vector<ModelSpec>;
 
 /* add / edit scenarios here ------------------------------------------------------- */
 static const std::unordered_map<std::string, Scenario> kScenarios = {
     { "AR_Assistant", {
-        { "models/KD_res8_narrow_quant.dlc",     3.0, 1.00, "input_lists/KD_res8_narrow.txt" },
-        { "models/ASR_EM_24L_quant.dlc",        3.0, 0.50, "input_lists/ASR_EM_24L.txt"     },
-        { "models/SS_HRViT_b1_quant.dlc",      10.0, 1.00, "input_lists/SS_HRViT_b1_quant.txt" },
-        { "models/DE_midas_v21_small_quant.dlc",30.0, 1.00, "input_lists/DE_midas_v21_small.txt" },
-        { "models/OD_D2go_FasterRCNN_quant.dlc",10.0, 1.00, "input_lists/OD_D2go_FasterRCNN.txt"}
+        { "models/KD_res8_narrow_quant.dlc",     3.0, 1.00, "input_lists/KD_res8_narrow.txt",      1, 1.0 },
+        { "models/ASR_EM_24L_quant.dlc",        3.0, 0.50, "input_lists/ASR_EM_24L.txt",          1, 1.0 },
+        { "models/SS_HRViT_b1_quant.dlc",      10.0, 1.00, "input_lists/SS_HRViT_b1_quant.txt",   0, 1.0 },
+        { "models/DE_midas_v21_small_quant.dlc",30.0, 1.00, "input_lists/DE_midas_v21_small.txt",  0, 1.0 },
+        { "models/OD_D2go_FasterRCNN_quant.dlc",10.0, 1.00, "input_lists/OD_D2go_FasterRCNN.txt", 1, 1.0 }
     }}
 };
 
 static const std::vector<double> kScales = {0.5, 1.0, 1.5, 2.0};
 
-/* ───────────────────────────────── scheduling policies ─────────────────────────── */
-enum class Policy : int { CPU_ONLY, GPU_ONLY, DSP_ONLY, RANDOM, JSQ, DYNAMIC };
-static const char* kPolName[] = { "CPU_ONLY","GPU_ONLY","DSP_ONLY","RANDOM","JSQ","DYNAMIC" };
+/* capacity search (-c): bracket by doubling from scale 1, then bisect */
+static constexpr double kCapMaxScale = 16.0;   // stop doubling here
+static constexpr double kCapTol      = 0.05;   // relative width of the final bracket
+static constexpr int    kCapProbes   = 12;     // hard limit of probed scales per policy
 
-/* ───────────────────────────────── global containers ───────────────────────────── */
-static std::atomic<bool> gStop{false};
-static std::atomic<int > gInFlight{0};
-
-struct RtCtx  { std::unique_ptr<zdl::SNPE::SNPE> snpe;
-                std::unique_ptr<zdl::DlSystem::ITensor> input; };
-struct ModelCtx { std::array<RtCtx,3> rt; };                // 0=CPU 1=GPU 2=DSP
-
-static std::unordered_map<std::string, ModelCtx>               gModelCtx;
-static std::unordered_map<std::string, std::vector<Runtime_t>> gAvailRt;
+/* ───────────────────────────────── run options (command line) ──────────────────── */
+struct Options {
+    int    simSec      = 15;     // measured seconds per scenario / scale / policy
+    double warmupSec   = 1.0;    // load before the measured window (kernel compile, DSP power‑up)
+    double cooldownSec = 1.0;    // load after it, so the last measured requests queue as usual
+    int    reps        = 1;      // repetitions per point, each on its own arrival trace
+    bool   afc         = false;  // adaptive frame‑rate control of best‑effort models
+    double afcTarget   = 1.0;    // critical miss‑rate target [%]
+    int    afcPeriodMs = 250;    // control (and fps‑log) interval
+    AssignObjective staticObj = AssignObjective::MAX_UTIL;   // STATIC_OPT solver objective
+    bool   fifo        = true;   // sweep every policy with FIFO runtime queues …
+    bool   wfq         = false;  // … and/or with weighted fair queuing
+    std::vector<std::string> placements;   // thread placements to sweep (default "auto")
+    bool   pipeline    = false;  // double‑buffered stage / execute / post threads per runtime
+    ArrivalModel arrivals;       // release process of every model (-A)
+    uint64_t seed      = 0;      // arrival seed, drawn from random_device unless -S is given
+    bool   seedSet     = false;
+    std::string traceIn, traceOut;         // replay / capture arrival traces
+    int    sampleMs    = 100;    // runtime time‑series interval, 0 = off
+    double capTarget   = -1.0;   // capacity search: miss‑rate target [%], < 0 = sweep kScales
+    std::string daemonPath;      // serve local clients on this UNIX socket instead (-D)
+    std::vector<ModelSpec> daemonModels;   // models the daemon serves, default every scenario model
+    Policy daemonPolicy = Policy::DYNAMIC;
+    RtConfig realtime;           // SCHED_FIFO / SCHED_RR per thread role (-R), off by default
+    int    hogs        = 0;      // also run every point against this many CPU‑hog threads (-H)
+    size_t cacheEntries = 0;     // result cache per model (-K), 0 = off
+    float  cacheTol    = 0.0f;   // 0 = identical frames only, else per‑slice mean tolerance
+    double stillProb   = -1.0;   // synthetic scene frames (-I): P(scene unchanged), < 0 = off
+    float  sceneNoise  = 0.0f;   // ± uniform sensor noise between captures of one scene
+    YuvFrame camera;             // -Y: scene frames are camera frames of this size, width 0 = off
+    PixelNormalization cameraNorm;   // -N: applied after the resize
+    std::string shareIo;         // -B: the models of a runtime share one IO arena, "small" / "huge" pages
+};
+static Options gOpt;
 
-/* ───────────────────────────────── lock‑free queues per runtime ─────────────────── */
-struct Request { const ModelSpec* ms; Runtime_t rt; Clock::time_point dl; };
+/* ───────────────────────────────── per‑run statistics ──────────────────────────── */
+/* per‑model counters of the current run, indexed by position in the scenario; rel … dropped
+   cover requests released in the measured window, allDone / allLate every request (AFC) */
+struct ModelStat { std::atomic<uint64_t> rel{0}, done{0}, late{0}, dropped{0}, busyUs{0}, allDone{0}, allLate{0};
+                   void reset(){ rel=0; done=0; late=0; dropped=0; busyUs=0; allDone=0; allLate=0; } };
+static std::array<ModelStat,16> gStat;
 
-struct TSQueue {
-    std::queue<Request> q; std::mutex m; std::condition_variable cv;
-    void push(const Request& r){ { std::lock_guard<std::mutex> lk(m); q.push(r);} cv.notify_one(); }
-    bool pop(Request& r){
-        std::unique_lock<std::mutex> lk(m);
-        cv.wait(lk,[&]{ return !q.empty() || gStop.load(); });
-        if(q.empty()) return false;
-        r = q.front(); q.pop(); return true;
-    }
-    void clear(){ std::lock_guard<std::mutex> lk(m); std::queue<Request>().swap(q); }
-    size_t size(){ std::lock_guard<std::mutex> lk(m); return q.size(); }
+/* ───────────────────────────────── per‑runtime latency samples of the current run ── */
+struct LatLog {
+    std::mutex m; std::vector<float> exec, resp, host;     // ms: execute() / release→done / stage+post
+    PreprocessTimes prep;                                  // camera frames, summed (part of host)
+    void add(float e,float r,float h,const PreprocessTimes& p){ std::lock_guard<std::mutex> lk(m);
+                                       exec.push_back(e); resp.push_back(r); host.push_back(h); prep += p; }
+    void reset(){ std::lock_guard<std::mutex> lk(m); exec.clear(); resp.clear(); host.clear(); prep = PreprocessTimes(); }
 };
-static TSQueue queues[3];
+static LatLog gLatLog[3];
+
+/* model ids of every scenario, in scenario order (-1 = not loaded) */
+static std::unordered_map<std::string, std::vector<int>> gIds;
 
-/* ───────────────────────────────── latency tracker for DYNAMIC ─────────────────── */
-struct LatRec { double avg = 1.0; void upd(double v){ avg = 0.9*avg + 0.1*v; } };
-static std::unordered_map<std::string, std::array<LatRec,3>> gLat;
+/* ───────────────────────────────── synthetic scene frames (-I) ─────────────────── */
+/* a camera that mostly looks at the same thing: kScenes scenes of kVariants noisy captures
+   per model; every release keeps the current scene with probability STILL, else moves on.
+   The frames never change, so a request may execute straight from them. With -Y they are
+   NV21 / NV12 camera frames instead, preprocessed to the model input by every request. */
+static constexpr int kScenes = 4, kVariants = 4;
+struct SceneSource { std::vector<std::vector<float>> frames; std::vector<std::vector<uint8_t>> yuv;
+                     std::mt19937_64 rng; int scene = 0; };
+static std::unordered_map<int, SceneSource> gScenes;          // by model id
 
 /* ───────────────────────────────── helpers ─────────────────────────────────────── */
-inline const char* rtName(Runtime_t r){ return r==Runtime_t::CPU?"CPU":r==Runtime_t::GPU?"GPU":"DSP"; }
-inline void pin(int core){ cpu_set_t s; CPU_ZERO(&s); CPU_SET(core,&s);
-                           sched_setaffinity(static_cast<pid_t>(syscall(SYS_gettid)),sizeof(s),&s); }
 inline bool exists(const std::string& p){ return access(p.c_str(),F_OK)==0; }
+inline double msBetween(Clock::time_point a, Clock::time_point b){
+    return std::chrono::duration<double,std::milli>(b-a).count(); }
+inline std::string modelName(const std::string& dlc){
+    auto b = dlc.find_last_of('/'); auto e = dlc.rfind(".dlc");
+    b = (b==std::string::npos) ? 0 : b+1;
+    return dlc.substr(b, e==std::string::npos||e<b ? std::string::npos : e-b); }
 
-/* prepare one ITensor (robust) ---------------------------------------------------- */
-static std::unique_ptr<zdl::DlSystem::ITensor>
-prepInput(std::unique_ptr<zdl::SNPE::SNPE>& snpe, const std::string& list)
+/* runtimes and profiled latency of a registered model ----------------------------- */
+static void printLoaded(const std::string& dlc, int id)
 {
-    auto batches = preprocessInput(list.c_str(),1);
-    if(batches.empty()) throw std::runtime_error("empty input list "+list);
+    std::cout<<"• "<<dlc<<": ";
+    if(id < 0){ std::cout<<(exists(dlc) ? "<no runtime>" : "<file missing>")<<"\n"; return; }
+    const auto& rts  = dsched::availableRuntimes(id);
+    const auto  prof = dsched::profiledLatency(id);
+    for(size_t i=0;i<rts.size();++i)
+        std::cout<<runtimeName(rts[i])<<'('<<prof[int(rts[i])]<<" ms)"<<(i+1==rts.size()?"":",");
+    std::cout<<"\n";
+}
 
-    const auto& namesOpt = snpe->getInputTensorNames();
-    if(!namesOpt) throw std::runtime_error("null input‑name ptr");
-    const auto& names = *namesOpt;
-    if(names.size()!=1)
-        throw std::runtime_error("model declares "+std::to_string(names.size())+" inputs");
+/* frames of the scene source of a model ------------------------------------------- */
+static void makeScenes(int id)
+{
+    const size_t n = dsched::inputSize(id);
+    if(!n) return;
+    SceneSource& s = gScenes[id];
+    std::mt19937_64 gen(gOpt.seed ^ uint64_t(id));
+    if(gOpt.camera.width && dsched::cameraInput(id)){     // noise in pixel steps
+        std::uniform_int_distribution<int> px(0, 255);
+        const int amp = int(gOpt.sceneNoise*255.0f + 0.5f);
+        std::uniform_int_distribution<int> noise(-amp, amp);
+        std::vector<uint8_t> base(YuvFrameBytes(gOpt.camera.width, gOpt.camera.height));
+        for(int sc=0;sc<kScenes;++sc){
+            for(auto& x:base) x = uint8_t(px(gen));
+            for(int v=0;v<kVariants;++v){
+                std::vector<uint8_t> f(base);
+                if(amp) for(auto& x:f) x = uint8_t(std::min(255, std::max(0, x + noise(gen))));
+                s.yuv.push_back(std::move(f));
+            }
+        }
+        return;
+    }
+    std::uniform_real_distribution<float> px(0.0f, 1.0f), noise(-gOpt.sceneNoise, gOpt.sceneNoise);
+    std::vector<float> base(n);
+    for(int sc=0;sc<kScenes;++sc){
+        for(auto& x:base) x = px(gen) + 0.5f*sc;
+        for(int v=0;v<kVariants;++v){
+            std::vector<float> f(base);
+            if(gOpt.sceneNoise > 0.0f) for(auto& x:f) x += noise(gen);
+            s.frames.push_back(std::move(f));
+        }
+    }
+}
+/* the next frame of a model: its default input unless -I gave it a scene source */
+static dsched::InputView sceneFrame(int id)
+{
+    auto it = gScenes.find(id);
+    if(it == gScenes.end()) return dsched::InputView();
+    SceneSource& s = it->second;
+    if(std::uniform_real_distribution<double>(0.0, 1.0)(s.rng) >= gOpt.stillProb) s.scene = (s.scene+1) % kScenes;
+    const int k = s.scene*kVariants + std::uniform_int_distribution<int>(0, kVariants-1)(s.rng);
+    dsched::InputView v;
+    if(!s.yuv.empty()){ v.camera = gOpt.camera; v.camera.data = s.yuv[k].data(); return v; }
+    v.data = s.frames[k].data(); v.count = s.frames[k].size();
+    return v;
+}
 
-    return loadInputTensor(snpe, batches[0], names);
+/* -B: lay the user-buffer sets of every runtime's models over one arena, print the saving */
+static void shareIo()
+{
+    if(gOpt.shareIo.empty()) return;
+    if(!gOpt.pipeline){ std::cerr<<"-B needs the user buffers of -x; the models keep their own\n"; return; }
+    const dsched::IoPlan plan = dsched::planIo(gOpt.shareIo == "huge");
+    auto size = [](size_t b){ std::ostringstream s; s<<std::fixed<<std::setprecision(1);
+                              if(b < 1048576) s<<b/1024.0<<" KiB"; else s<<b/1048576.0<<" MiB";
+                              return s.str(); };
+    size_t own = 0, shared = 0;
+    std::cout<<"\n=== IO buffers shared per runtime ===\n";
+    for(int r=0;r<3;++r){
+        const dsched::IoFootprint& f = plan.rt[r];
+        if(!f.models) continue;
+        own += f.ownBytes; shared += f.sharedBytes;
+        std::cout<<"• "<<runtimeName(static_cast<Runtime_t>(r))<<": "<<f.models<<" models, own sets "
+                 <<size(f.ownBytes)<<" → "<<size(f.sharedBytes)
+                 <<(f.sharedBytes < f.ownBytes ? std::string(" arena, ")+f.pages+" pages" : std::string(" (not shared)"))<<"\n";
+    }
+    std::cout<<"• total "<<size(own)<<" → "<<size(shared)<<" ("<<int(own ? 100.0*(own-shared)/own + 0.5 : 0.0)
+             <<" % less); process resident "<<size(plan.residentBefore)<<" → "<<size(plan.residentAfter)<<"\n";
+}
+// A request that found its shared IO set held by another one was failed instead of
+// corrupting it: a scheduling bug, so a run that had any fails.
+static bool ioLive()
+{
+    if(gOpt.shareIo.empty() || !gOpt.pipeline) return true;
+    const uint64_t n = dsched::ioLivenessFaults();
+    std::cout<<"\n=== IO buffers shared per runtime: "<<n<<" liveness fault"<<(n == 1 ? "" : "s")<<" ===\n";
+    return n == 0;
 }
 
-/* preload DLCs once (with Init‑Caching) ------------------------------------------ */
+/* register every scenario model; the service loads each container once ------------ */
 static void preload()
 {
     std::set<std::string> dlcs;
     for(auto& kv:kScenarios) for(auto& m:kv.second) dlcs.insert(m.dlc);
 
     std::cout<<"\n=== Pre‑loading "<<dlcs.size()<<" unique DLCs ===\n";
-    for(const auto& dlc:dlcs)
-    {
-        std::cout<<"• "<<dlc<<": ";
-        const ModelSpec* anySpec=nullptr;
-        for(auto& kv:kScenarios) for(const auto& m:kv.second)
-            if(m.dlc==dlc){ anySpec=&m; break; }
-        if(!anySpec || !exists(dlc)){ std::cout<<"<file missing>\n"; continue; }
-
-        auto& mc = gModelCtx[dlc];
-        std::vector<const char*> ok;
-
-        for(Runtime_t rt:{Runtime_t::CPU,Runtime_t::GPU,Runtime_t::DSP}){
-            if(!zdl::SNPE::SNPEFactory::isRuntimeAvailable(rt)) continue;
-
-            RtCtx ctx;
-            if(auto cont = loadContainerFromFile(dlc)){
-                zdl::DlSystem::PlatformConfig pc;
-                ctx.snpe = setBuilderOptions(cont, rt, {}, false, pc,
-                                             /*InitCache*/true,false,
-                                             zdl::DlSystem::PerformanceProfile_t::HIGH_PERFORMANCE);
-                if(ctx.snpe){
-                    cont->save(dlc.c_str());               // create / update cache
-                    try{ ctx.input = prepInput(ctx.snpe, anySpec->list); }
-                    catch(...){ ctx.snpe.reset(); }
-                }
-            }
-            if(ctx.snpe){
-                mc.rt[int(rt)] = std::move(ctx);
-                gAvailRt[dlc].push_back(rt);
-                ok.push_back(rtName(rt));
-            }
+    std::set<std::string> shown;
+    for(auto& kv:kScenarios)
+        for(const auto& m:kv.second){
+            dsched::ModelConfig mc;
+            mc.dlc = m.dlc; mc.inputList = m.list; mc.weight = m.weight;
+            mc.cacheEntries = gOpt.cacheEntries; mc.cacheTolerance = gOpt.cacheTol;
+            mc.norm = gOpt.cameraNorm;
+            const int id = dsched::registerModel(mc);
+            gIds[kv.first].push_back(id);
+            if(gOpt.stillProb >= 0.0 && id >= 0 && !gScenes.count(id)) makeScenes(id);
+            if(shown.insert(m.dlc).second) printLoaded(m.dlc, id);
         }
-        if(ok.empty()) std::cout<<"<no runtime>";
-        else           for(size_t i=0;i<ok.size();++i) std::cout<<ok[i]<<(i+1==ok.size()?"":",");
-        std::cout<<"\n";
-    }
     std::cout<<"===========================================\n";
 }
 
-/* worker thread ------------------------------------------------------------------ */
-static void worker(Runtime_t rt,int core)
+/* bookkeeping for one completed request ------------------------------------------- */
+static void record(size_t mi, bool measured, const dsched::Result& r)
 {
-    pin(core);
-    for(Request rq; !gStop && queues[int(rt)].pop(rq); ){
-        const RtCtx& ctx = gModelCtx[rq.ms->dlc].rt[int(rt)];
-        if(!ctx.snpe){                            // runtime not available after all
-            if(Clock::now()>rq.dl) ;              // miss counted in drain
-            continue;
-        }
-        gInFlight++;
-        auto t0 = Clock::now();
-        zdl::DlSystem::TensorMap om;
-        ctx.snpe->execute(ctx.input.get(), om);
-        auto t1 = Clock::now();
-        gInFlight--;
-        gLat[rq.ms->dlc][int(rt)].upd(
-            std::chrono::duration<double,std::milli>(t1-t0).count());
+    ModelStat& st = gStat[mi];
+    if(r.status == dsched::Status::CANCELLED){       // left in a queue at the end of the run
+        if(measured && r.late()) st.dropped++;
+        return;
     }
+    if(r.status != dsched::Status::OK) return;
+    st.allDone++; if(r.late()) st.allLate++;
+    if(!measured) return;
+    if(r.cached){ st.done++; if(r.late()) st.late++; return; }    // no runtime time, no latency sample
+    st.busyUs += std::chrono::duration_cast<std::chrono::microseconds>(r.finished-r.started).count();
+    st.done++; if(r.late()) st.late++;
+    gLatLog[int(r.runtime)].add(float(msBetween(r.started, r.finished)),
+                                float(msBetween(r.released, r.completed)), float(r.hostMs), r.prep);
 }
-
-/* selectors ---------------------------------------------------------------------- */
-static Runtime_t pickJSQ(const std::vector<Runtime_t>& rts)
+static size_t queuedAll()
 {
-    Runtime_t best=rts[0]; size_t bq=queues[int(best)].size();
-    auto pref = {Runtime_t::DSP,Runtime_t::GPU,Runtime_t::CPU};
-    for(Runtime_t rt:rts){
-        size_t q=queues[int(rt)].size();
-        if(q<bq || (q==bq &&
-           std::find(pref.begin(),pref.end(),rt)<std::find(pref.begin(),pref.end(),best)))
-        { best=rt; bq=q; }
-    }
-    return best;
+    size_t n = 0;
+    for(Runtime_t rt:{Runtime_t::CPU,Runtime_t::GPU,Runtime_t::DSP}) n += dsched::gauge(rt).queued;
+    return n;
 }
-static Runtime_t pickDyn(const ModelSpec& m,const std::vector<Runtime_t>&rts,double slack)
+
+/* adaptive frame‑rate control --------------------------------------------------- */
+// Every afcPeriodMs the critical models' miss rate over the last window is compared
+// with the target: above it the release rate of every best‑effort model is cut
+// multiplicatively, well below it the rate is ramped back up additively (AIMD).
+static constexpr double kAfcDecrease = 0.7, kAfcIncrease = 0.1, kAfcMinRate = 0.1;
+
+/* runtime time series: busy fraction, queue depth, in‑flight and inferences/s ----- */
+struct RtSample { double t; std::array<double,3> busy, ips; std::array<size_t,3> depth; std::array<int,3> inFlight; };
+
+static void sampler(const std::atomic<bool>& stop, Clock::time_point start, std::vector<RtSample>& out)
 {
-    for(Runtime_t pref:{Runtime_t::DSP,Runtime_t::GPU,Runtime_t::CPU}){
-        if(std::find(rts.begin(),rts.end(),pref)==rts.end()) continue;
-        double qLat = queues[int(pref)].size()*gLat[m.dlc][int(pref)].avg;
-        if(qLat <= slack) return pref;
+    const auto per = std::chrono::milliseconds(gOpt.sampleMs);
+    auto last = Clock::now();
+    std::array<int64_t,3> lastBusy; std::array<uint64_t,3> lastDone;
+    for(int r=0;r<3;++r){ auto g = dsched::gauge(static_cast<Runtime_t>(r), last);
+                          lastBusy[r] = g.busyNs; lastDone[r] = g.done; }
+    for(auto next = Clock::now()+per; !stop; next += per){
+        std::this_thread::sleep_until(next);
+        const auto now = Clock::now();
+        const double dt = std::max(1e-9, std::chrono::duration<double>(now-last).count());
+        RtSample x; x.t = std::chrono::duration<double>(now-start).count();
+        for(int r=0;r<3;++r){
+            auto g = dsched::gauge(static_cast<Runtime_t>(r), now);
+            x.busy[r]     = std::min(1.0, std::max(0.0, (g.busyNs-lastBusy[r])*1e-9/dt));
+            x.ips[r]      = (g.done-lastDone[r])/dt;
+            x.depth[r]    = g.queued;
+            x.inFlight[r] = g.inFlight;
+            lastBusy[r] = g.busyNs; lastDone[r] = g.done;
+        }
+        last = now;
+        out.push_back(x);
     }
-    return pickJSQ(rts);
 }
 
 /* run one scenario / scale / policy ---------------------------------------------- */
-static double runOne(const Scenario& S, Policy pol, double scale,
-                     std::chrono::seconds dur, std::mt19937& rng)
+struct ModelRes { std::string name; double weight; uint64_t rel, done;
+                  double tputShare, timeShare, miss;       // shares of all completions / busy time
+                  dsched::CacheStats cache; };
+struct RtRes { size_t n; double execMean, execP99, respMean, respP99,   // ms
+               util, hostMean;                // % of the measured window spent in execute(), ms stage+post
+               PreprocessTimes prep; };       // camera frames (-Y), summed
+struct RunRes { double miss;       // % of releases still queued past their deadline
+                double lateMiss;   // % of releases finished late or never (capacity search)
+                std::array<double,3> utilMean, utilMax;   // sampled busy fraction in the window [%]
+                double critMiss;   // % of critical releases finished late or never
+                double regretMs;   // see banditRegret()
+                double relLateMeanUs, relLateP99Us, relLateMaxUs;   // release jitter: submit − nominal release
+                double respP99Ms;  // release → completion, all runtimes
+                dsched::CacheStats cache;                 // every model of the run, warm‑up included
+                std::vector<ModelRes> models;
+                std::array<RtRes,3> rt;
+                int stuck;         // requests still executing kBarrierSec after the drain: run aborted
+              };
+
+static void meanP99(std::vector<float>& v, double& mean, double& p99)
+{
+    mean = p99 = 0.0;
+    if(v.empty()) return;
+    for(float x:v) mean += x;
+    mean /= v.size();
+    auto k = v.begin() + std::min(v.size()-1, size_t(0.99*v.size()));
+    std::nth_element(v.begin(), k, v.end());
+    p99 = *k;
+}
+/* mean and half width of the 95 % Student‑t confidence interval ------------------- */
+static void meanCi95(const std::vector<double>& v, double& mean, double& half)
 {
-    for(auto& q:queues) q.clear();
+    static const double t975[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    mean = half = 0.0;
+    if(v.empty()) return;
+    for(double x:v) mean += x;
+    mean /= v.size();
+    if(v.size() < 2) return;
+    double ss = 0.0;
+    for(double x:v) ss += (x-mean)*(x-mean);
+    size_t df = v.size()-1;
+    half = (df <= 30 ? t975[df-1] : 1.96) * std::sqrt(ss/df/v.size());
+}
+
+static constexpr int kBarrierSec = 10;     // longest wait for executions still running after the drain
 
-    struct St{ const ModelSpec* ms; Clock::duration per; Clock::time_point next;
-               std::bernoulli_distribution bern; };
+static RunRes runOne(const Scenario& S, const std::vector<int>& ids, const std::vector<Arrival>& arr,
+                     Policy pol, bool wfq, double scale, std::chrono::seconds dur,
+                     const std::string& tag, std::ostream& fpsLog)
+{
+    if(S.size() > gStat.size())
+        throw std::runtime_error("scenario has more than "+std::to_string(gStat.size())+" models");
+    for(auto& c:gStat) c.reset();
+    for(auto& l:gLatLog) l.reset();
+    dsched::setPolicy(pol);
+    dsched::setFairQueuing(wfq);
+    dsched::resetRegret();
+    dsched::resetCaches();
+    for(auto& kv:gScenes){ kv.second.rng.seed(gOpt.seed ^ uint64_t(kv.first)); kv.second.scene = 0; }
+
+    struct St{ const ModelSpec* ms; Clock::duration per;        // per = relative deadline
+               bool crit; double rate; uint64_t lastDone, lastLate; };
     std::vector<St> st;
-    auto start = Clock::now();
+    int topPrio = S.empty() ? 0 : std::max_element(S.begin(),S.end(),
+                  [](const ModelSpec& a,const ModelSpec& b){ return a.prio<b.prio; })->prio;
     for(auto& m:S){
         st.push_back({ &m,
                        std::chrono::duration_cast<Clock::duration>(
                            std::chrono::duration<double>(1.0/(m.fps*scale))),
-                       start,
-                       std::bernoulli_distribution(m.prob) });
+                       m.prio==topPrio, 1.0, 0, 0 });
     }
-    const auto endTime = start + dur;
-    uint64_t total=0, miss=0;
-
-    std::uniform_int_distribution<int> randPick;  // re‑set per use
-
-    while(Clock::now() < endTime){
-        auto now = Clock::now();
-        for(auto& s : st){
-            if(now >= s.next){
-                s.next += s.per;
-                if(!s.bern(rng)) continue;
-
-                const auto& rts = gAvailRt[s.ms->dlc];
-                if(rts.empty()) continue;
-
-                Runtime_t tgt = Runtime_t::CPU;
-                switch(pol){
-                    case Policy::CPU_ONLY:
-                        tgt = (std::find(rts.begin(),rts.end(),Runtime_t::CPU)!=rts.end())
-                              ? Runtime_t::CPU : rts[0]; break;
-                    case Policy::GPU_ONLY:
-                        tgt = (std::find(rts.begin(),rts.end(),Runtime_t::GPU)!=rts.end())
-                              ? Runtime_t::GPU : rts[0]; break;
-                    case Policy::DSP_ONLY:
-                        tgt = (std::find(rts.begin(),rts.end(),Runtime_t::DSP)!=rts.end())
-                              ? Runtime_t::DSP : rts[0]; break;
-                    case Policy::RANDOM:
-                        randPick.param(std::uniform_int_distribution<int>::param_type(0,int(rts.size())-1));
-                        tgt = rts[randPick(rng)]; break;
-                    case Policy::JSQ:
-                        tgt = pickJSQ(rts); break;
-                    case Policy::DYNAMIC:{
-                        double slack = std::chrono::duration<double,std::milli>(s.per).count();
-                        tgt = pickDyn(*s.ms, rts, slack);
-                    } break;
-                }
-                queues[int(tgt)].push({s.ms,tgt,now+s.per});
-                ++total;
-            }
+    auto secs = [](double v){ return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(v)); };
+    const auto start   = Clock::now();
+    const auto measFrom = start + secs(gOpt.warmupSec);           // warm‑up | measured | cool‑down
+    const auto measTo   = measFrom + dur;
+    const auto endTime  = measTo + secs(gOpt.cooldownSec);
+
+    std::atomic<bool> sampStop{false};
+    std::vector<RtSample> samples;
+    std::thread samp;
+    if(gOpt.sampleMs > 0) samp = std::thread(sampler, std::cref(sampStop), start, std::ref(samples));
+    const auto ctlPer  = std::chrono::milliseconds(gOpt.afcPeriodMs);
+    auto nextCtl = start + ctlPer;
+    std::array<int64_t,3> busyFrom{}, busyTo{};    // runtime busy time at the window's edges
+    Clock::time_point winFrom, winTo;
+    int edge = 0;                                  // window edges passed so far
+    auto busyAt = [&](std::array<int64_t,3>& b, Clock::time_point& t){
+        t = Clock::now();
+        for(int r=0;r<3;++r) b[r] = dsched::gauge(static_cast<Runtime_t>(r), t).busyNs;
+        ++edge;
+    };
+    uint64_t total=0;
+    std::vector<float> relLate;                    // µs the dispatcher released each measured request late
+
+    /* close one control window: log achieved fps, then adapt best‑effort rates */
+    auto control = [&](Clock::time_point now){
+        double win = std::chrono::duration<double>(ctlPer).count();
+        uint64_t cDone=0, cLate=0;
+        std::vector<double> fps(st.size());
+        for(size_t i=0;i<st.size();++i){
+            uint64_t d = gStat[i].allDone, l = gStat[i].allLate;
+            fps[i] = (d-st[i].lastDone)/win;
+            if(st[i].crit){ cDone += d-st[i].lastDone; cLate += l-st[i].lastLate; }
+            st[i].lastDone = d; st[i].lastLate = l;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        double critMiss = cDone ? 100.0*double(cLate)/double(cDone) : 0.0;
+        double t = std::chrono::duration<double>(now-start).count();
+        for(size_t i=0;i<st.size();++i)
+            fpsLog<<tag<<','<<t<<','<<modelName(st[i].ms->dlc)<<','<<(st[i].crit?"crit":"best_effort")<<','
+                  <<st[i].ms->fps*scale*st[i].ms->prob<<','<<st[i].rate<<','<<fps[i]<<','<<critMiss<<'\n';
+        if(!gOpt.afc) return;
+        for(auto& s:st){
+            if(s.crit) continue;
+            if(critMiss > gOpt.afcTarget)           s.rate = std::max(kAfcMinRate, s.rate*kAfcDecrease);
+            else if(critMiss < 0.5*gOpt.afcTarget)  s.rate = std::min(1.0, s.rate+kAfcIncrease);
+        }
+    };
+
+    Assignment fixed;                              // STATIC_OPT placement for this scale
+    if(pol == Policy::STATIC_OPT){
+        std::vector<AssignLoad> loads;
+        for(auto& s:st){
+            AssignLoad l{ s.ms->fps*scale*s.ms->prob,
+                          std::chrono::duration<double,std::milli>(s.per).count(), {-1,-1,-1} };
+            l.latMs = dsched::profiledLatency(ids[loads.size()]);
+            loads.push_back(l);
+        }
+        fixed = solveStaticAssignment(loads, gOpt.staticObj);
+        for(size_t i=0;i<st.size();++i) dsched::setStaticRuntime(ids[i], fixed.rt[i]);
+        std::cout<<"["<<(fixed.exact?"optimal":"local search")<<" cost="<<fixed.cost;
+        for(size_t i=0;i<st.size();++i)
+            std::cout<<' '<<modelName(st[i].ms->dlc)<<"→"
+                     <<(fixed.rt[i]<0 ? "-" : runtimeName(static_cast<Runtime_t>(fixed.rt[i])));
+        std::cout<<"] "<<std::flush;
     }
 
+    /* release the trace: an arrival is dropped while u ≥ the model's AFC rate */
+    auto at = [&](const Arrival& a){ return start + secs(a.t); };
+    size_t ai = 0;
+    for(auto now = Clock::now(); now < endTime; now = Clock::now()){
+        if(now >= nextCtl){ control(now); nextCtl += ctlPer; }
+        if(edge == 0 && now >= measFrom) busyAt(busyFrom, winFrom);
+        if(edge == 1 && now >= measTo)   busyAt(busyTo, winTo);
+        for(; ai<arr.size() && at(arr[ai])<=now; ++ai){
+            const Arrival& a = arr[ai];
+            if(a.model < 0 || size_t(a.model) >= st.size()) continue;
+            const size_t i = size_t(a.model);
+            auto& s = st[i];
+            if(a.u >= s.rate) continue;
+            const auto rel = at(a);
+            const bool meas = rel >= measFrom && rel < measTo;
+            if(dsched::availableRuntimes(ids[i]).empty()) continue;
+            if(meas){ ++total; gStat[i].rel++;
+                      relLate.push_back(float(std::chrono::duration<double,std::micro>(Clock::now()-rel).count())); }
+            dsched::submit(ids[i], sceneFrame(ids[i]), rel+s.per,
+                           [i,meas](dsched::Result&& r){ record(i, meas, r); }, rel);
+        }
+        auto wake = std::min(nextCtl, endTime);
+        if(edge < 2) wake = std::min(wake, edge ? measTo : measFrom);
+        if(ai < arr.size()) wake = std::min(wake, at(arr[ai]));
+        std::this_thread::sleep_until(wake);
+    }
+    if(edge == 1) busyAt(busyTo, winTo);           // no cool‑down: the window closed the loop
+
+    /* cool‑down arrivals only kept the load up: drop the ones still queued */
+    dsched::cancelQueued([&](int, Clock::time_point rel){ return rel < measFrom || rel >= measTo; });
+
     /* drain with watchdog (max 3 s) */
     auto wdEnd = Clock::now() + std::chrono::seconds(3);
-    while((gInFlight.load()>0 ||
-           std::any_of(std::begin(queues),std::end(queues),
-                       [](TSQueue&q){return q.size();}))
-           && Clock::now() < wdEnd)
+    while((dsched::inFlight()>0 || queuedAll()>0) && Clock::now() < wdEnd)
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
-    /* anything still sitting in queues is an automatic miss */
-    for(auto& q:queues){
-        std::lock_guard<std::mutex> lk(q.m);
-        while(!q.q.empty()){ if(Clock::now()>q.q.front().dl) ++miss; q.q.pop(); }
+    /* a measured request still sitting in a queue is an automatic miss (see record()) */
+    dsched::cancelQueued([](int, Clock::time_point){ return true; });
+    /* barrier: whatever is still executing finishes (and is counted) before the next run;
+       a runtime that hangs past it would feed its completions into the next run */
+    const auto barEnd = Clock::now() + std::chrono::seconds(kBarrierSec);
+    while(dsched::inFlight() > 0 && Clock::now() < barEnd)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if(samp.joinable()){ sampStop = true; samp.join(); }
+    uint64_t cRel=0, cMiss=0;
+    for(size_t i=0;i<st.size();++i)
+        if(st[i].crit){ cRel += gStat[i].rel; cMiss += gStat[i].late + gStat[i].dropped; }
+    uint64_t miss=0, aMiss=0;
+    for(size_t i=0;i<st.size();++i){ miss += gStat[i].dropped; aMiss += gStat[i].late + gStat[i].dropped; }
+    RunRes res{};
+    res.stuck    = dsched::inFlight();
+    res.miss     = total ? 100.0*double(miss)/double(total) : 0.0;
+    res.lateMiss = total ? 100.0*double(aMiss)/double(total) : 0.0;
+    res.critMiss = cRel  ? 100.0*double(cMiss)/double(cRel) : 0.0;
+    res.regretMs = dsched::banditRegret(ids);
+    meanP99(relLate, res.relLateMeanUs, res.relLateP99Us);
+    res.relLateMaxUs = relLate.empty() ? 0.0 : *std::max_element(relLate.begin(), relLate.end());
+    uint64_t allDone=0, allBusy=0;
+    for(size_t i=0;i<st.size();++i){ allDone += gStat[i].done; allBusy += gStat[i].busyUs; }
+    for(size_t i=0;i<st.size();++i){
+        uint64_t rel = gStat[i].rel, done = gStat[i].done;
+        const dsched::CacheStats c = dsched::cacheStats(ids[i]);
+        res.models.push_back({ modelName(st[i].ms->dlc), st[i].ms->weight, rel, done,
+                               allDone ? double(done)/allDone : 0.0,
+                               allBusy ? double(gStat[i].busyUs)/allBusy : 0.0,
+                               rel ? 100.0*double(gStat[i].late+gStat[i].dropped)/rel : 0.0, c });
+        res.cache.lookups += c.lookups; res.cache.hits += c.hits;
+        res.cache.savedMs += c.savedMs; res.cache.freedMs += c.freedMs; res.cache.keyMs += c.keyMs;
+    }
+    /* time series of this run, and its utilization summary over the measured window */
+    const double wFrom = gOpt.warmupSec, wTo = gOpt.warmupSec + dur.count();
+    if(!samples.empty()){
+        std::string file = "timeseries/" + tag + ".csv";
+        std::replace(file.begin(), file.end(), ',', '_');
+        std::ofstream ts(file);
+        ts<<"t,phase,runtime,busy,queue_depth,in_flight,inf_per_s\n";
+        for(const auto& x : samples)
+            for(int r=0;r<3;++r)
+                ts<<x.t<<','<<(x.t<=wFrom ? "warmup" : x.t<=wTo ? "measure" : "cooldown")<<','
+                  <<runtimeName(static_cast<Runtime_t>(r))<<','<<x.busy[r]<<','<<x.depth[r]<<','
+                  <<x.inFlight[r]<<','<<x.ips[r]<<'\n';
+    }
+    for(int r=0;r<3;++r){
+        double sum = 0.0, mx = 0.0; size_t n = 0;
+        for(const auto& x : samples)
+            if(x.t > wFrom && x.t <= wTo){ sum += x.busy[r]; mx = std::max(mx, x.busy[r]); ++n; }
+        res.utilMean[r] = n ? 100.0*sum/n : 0.0;
+        res.utilMax[r]  = 100.0*mx;
     }
-    return total ? 100.0*double(miss)/double(total) : 0.0;
+    const double winNs = std::chrono::duration<double,std::nano>(winTo-winFrom).count();
+    std::vector<float> resp;
+    double respMean;
+    for(auto& l : gLatLog){ std::lock_guard<std::mutex> lk(l.m); resp.insert(resp.end(), l.resp.begin(), l.resp.end()); }
+    meanP99(resp, respMean, res.respP99Ms);
+    for(int r=0;r<3;++r){
+        std::lock_guard<std::mutex> lk(gLatLog[r].m);
+        double hostP99;
+        res.rt[r].n = gLatLog[r].exec.size();
+        meanP99(gLatLog[r].exec, res.rt[r].execMean, res.rt[r].execP99);
+        meanP99(gLatLog[r].resp, res.rt[r].respMean, res.rt[r].respP99);
+        meanP99(gLatLog[r].host, res.rt[r].hostMean, hostP99);
+        res.rt[r].prep = gLatLog[r].prep;
+        res.rt[r].util = winNs>0 ? 100.0*double(busyTo[r]-busyFrom[r])/winNs : 0.0;
+    }
+    return res;
+}
+
+/* real‑time mode (-R) ------------------------------------------------------------ */
+// Memory is locked and prefaulted before the service threads start, so they are created
+// with resident stacks; then every thread role gets its policy and what the kernel
+// granted is read back. Without CAP_SYS_NICE (or ulimit -r) the request is refused and
+// those threads stay under CFS, which the results then say.
+static constexpr size_t kStackPrefault = 256*1024;   // bytes of stack every thread touches
+static std::string gRtLabel = "off";                 // realtime column of results.csv
+
+static void prepareRealtime()                        // before dsched::start()
+{
+    const size_t bytes = dsched::prefault();
+    std::string err;
+    const bool locked = lockMemory(err);
+    prefaultStack(kStackPrefault);
+    std::cout<<"\n=== real‑time mode "<<gOpt.realtime.name<<" ===\n"
+             <<"  memory      "<<(locked ? "locked (mlockall)" : "NOT locked: "+err)<<"; "<<bytes/1048576.0
+             <<" MiB of buffers and "<<kStackPrefault/1024<<" KiB of stack per thread prefaulted\n";
+}
+static void applyRealtime()                          // after dsched::start(), on the dispatcher
+{
+    struct Role { std::string name; pid_t tid; RtPrio want; };
+    std::vector<Role> roles{ { "dispatcher", currentTid(), gOpt.realtime.dispatcher } };
+    for(int r=0;r<3;++r){
+        const std::vector<pid_t> tids = dsched::threadIds(static_cast<Runtime_t>(r));
+        const std::string rn = runtimeName(static_cast<Runtime_t>(r));
+        roles.push_back({ rn+" worker", tids[0], gOpt.realtime.worker[r] });
+        for(size_t k=1;k<tids.size();++k) roles.push_back({ rn+(k==1 ? " stager" : " poster"), tids[k], gOpt.realtime.host });
+    }
+    int denied = 0;
+    for(const auto& x : roles){
+        setThreadRt(x.tid, x.want);
+        const RtPrio got = threadRt(x.tid);
+        const bool ok = got.policy == x.want.policy && got.prio == x.want.prio;
+        denied += !ok;
+        std::cout<<"  "<<std::left<<std::setw(11)<<x.name<<" tid "<<std::setw(7)<<x.tid<<std::setw(8)<<rtPrioStr(x.want)
+                 <<std::right<<(ok ? " granted" : " DENIED, runs "+rtPrioStr(got))<<"\n";
+    }
+    long rtRuntime = -1, rtPeriod = 0;
+    std::ifstream("/proc/sys/kernel/sched_rt_runtime_us")>>rtRuntime;
+    std::ifstream("/proc/sys/kernel/sched_rt_period_us")>>rtPeriod;
+    if(rtRuntime >= 0 && rtPeriod > 0)
+        std::cout<<"  kernel      real‑time threads get at most "<<100.0*rtRuntime/rtPeriod<<" % of a CPU (sched_rt_runtime_us)\n";
+    if(denied)
+        std::cerr<<"warning: "<<denied<<" thread(s) refused their real‑time policy; run as root or raise ulimit -r\n";
+    gRtLabel = gOpt.realtime.name + (denied ? " (partial)" : "");
+}
+
+/* daemon mode (-D): own the runtimes and models, schedule the requests of local clients */
+static std::atomic<bool> gDaemonStop{false};
+static void onSignal(int){ gDaemonStop = true; }
+
+static int serveDaemon(const std::vector<CpuInfo>& cpus, const Placement& pl)
+{
+    std::vector<ModelSpec> specs = gOpt.daemonModels;
+    if(specs.empty()){
+        std::set<std::string> seen;
+        for(auto& kv:kScenarios) for(auto& m:kv.second) if(seen.insert(m.dlc).second) specs.push_back(m);
+    }
+    std::cout<<"\n=== Loading "<<specs.size()<<" models ===\n";
+    std::vector<DaemonModel> served;
+    for(const auto& m : specs){
+        dsched::ModelConfig mc;
+        mc.dlc = m.dlc; mc.inputList = m.list; mc.weight = m.weight; mc.keepOutput = true;
+        mc.cacheEntries = gOpt.cacheEntries; mc.cacheTolerance = gOpt.cacheTol;
+        const int id = dsched::registerModel(mc);
+        printLoaded(m.dlc, id);
+        served.push_back({ modelName(m.dlc), id });
+    }
+    std::cout<<"===========================================\n";
+
+    shareIo();
+    if(gOpt.realtime.on()) prepareRealtime();
+    dsched::start();
+    if(gOpt.realtime.on()) applyRealtime();             // the connection threads inherit the dispatcher's
+    bool pinned = true;
+    for(int r=0;r<3;++r)
+        for(pid_t t : dsched::threadIds(static_cast<Runtime_t>(r))) pinned &= pinThread(t, pl.worker[r], cpus);
+    if(!pinned) std::cerr<<"warning: sched_setaffinity failed for placement "<<pl.name<<"\n";
+    dsched::setPolicy(gOpt.daemonPolicy);
+    dsched::setFairQueuing(gOpt.wfq);
+    std::cout<<"Policy "<<policyName(gOpt.daemonPolicy)<<'/'<<(gOpt.wfq ? "WFQ" : "FIFO")
+             <<", placement "<<pl.name<<"; SIGINT or SIGTERM stops the daemon\n";
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    const bool ok = runDaemon(gOpt.daemonPath, served, gDaemonStop);
+    dsched::stop();
+    const bool live = ioLive();
+    return ok && live ? 0 : 1;
 }
 
 /* main --------------------------------------------------------------------------- */
-int main()
+static void usage(const char* prog)
+{
+    std::cout<<"usage: "<<prog<<" [options]\n"
+             <<"  -d <SEC>   measured seconds per scenario / scale / policy (default "<<gOpt.simSec<<")\n"
+             <<"  -W <SEC>   warm‑up seconds before the measured window (default "<<gOpt.warmupSec<<")\n"
+             <<"  -C <SEC>   cool‑down seconds after it; only requests released inside the window\n"
+             <<"             are counted (default "<<gOpt.cooldownSec<<")\n"
+             <<"  -n <N>     repetitions per point on fresh arrivals, with 95 % confidence\n"
+             <<"             intervals in summary.csv (default "<<gOpt.reps<<")\n"
+             <<"  -a         adaptive frame‑rate control: throttle best‑effort models while\n"
+             <<"             critical models miss more than the target\n"
+             <<"  -t <PCT>   critical miss‑rate target for -a (default "<<gOpt.afcTarget<<")\n"
+             <<"  -o <OBJ>   STATIC_OPT objective [util, miss]: minimize the maximum runtime\n"
+             <<"             utilization (default) or the expected deadline misses\n"
+             <<"  -q <MODE>  runtime queue discipline [fifo, wfq, both] (default fifo); wfq\n"
+             <<"             shares runtime time between models by their scenario weight\n"
+             <<"  -P <PLACE> thread placement, repeat to compare several (default auto):\n"
+             <<"               auto    CPU runtime on big cores, GPU/DSP workers on little cores,\n"
+             <<"                       dispatcher on an isolated core (from /sys/devices/system/cpu)\n"
+             <<"               legacy  CPU/GPU/DSP workers on cores 0/1/2, dispatcher unpinned\n"
+             <<"               cpu=4-7:gpu=0-1:dsp=0-1:disp=3   explicit CPU lists per role\n"
+             <<"  -A <ARR>   arrival process of every model (default periodic):\n"
+             <<"               periodic            one release per period, kept with the model's probability\n"
+             <<"               jitter[:FRAC]       periodic ± FRAC·period uniform jitter (default 0.1)\n"
+             <<"               poisson             exponential inter‑arrival times at the same mean rate\n"
+             <<"               bursty[:ON:OFF]     Poisson during exponential ON/OFF phases of mean ON/OFF ms\n"
+             <<"                                   (default 500:500), same mean rate\n"
+             <<"  -S <SEED>  arrival seed (default: random, printed at start)\n"
+             <<"  -w <FILE>  write the generated arrival traces to FILE\n"
+             <<"  -r <FILE>  replay arrival traces from FILE (written by -w) instead of generating them\n"
+             <<"  -c <PCT>   capacity search: per scenario, policy and queue, find the largest scale\n"
+             <<"             whose miss rate (late or dropped, all models) stays ≤ PCT; written to\n"
+             <<"             capacity.csv instead of sweeping the fixed scales\n"
+             <<"  -s <MS>    sample runtime busy fraction, queue depth, in‑flight count and\n"
+             <<"             inferences/s every MS ms into timeseries/<run>.csv (default "<<gOpt.sampleMs<<", 0 = off)\n"
+             <<"  -x         pipelined runtimes: stage the next input and post‑process the previous\n"
+             <<"             output on two user‑buffer sets while the current request executes\n"
+             <<"  -B <PAGES> with -x, the models of a runtime share its two input and two output sets,\n"
+             <<"             one arena as large as its largest model's, on small or huge PAGES; the\n"
+             <<"             memory before and after is printed and the daemon applies it too; a\n"
+             <<"             request that finds its set still held is a liveness fault and fails the run\n"
+             <<"  -D <PATH>  daemon mode: serve inference requests of local clients on the UNIX socket\n"
+             <<"             PATH (see loadtest/) instead of running the benchmark; -q wfq, -x and the\n"
+             <<"             first -P apply, and with -x frames of shared‑memory rings execute in place\n"
+             <<"  -M <DLC:LIST[:WEIGHT]>  model the daemon serves, repeat for several (default every\n"
+             <<"             scenario model); clients open it by the dlc file name without extension\n"
+             <<"  -p <POL>   daemon runtime selection: CPU_ONLY, GPU_ONLY, DSP_ONLY, RANDOM, JSQ, DYNAMIC\n"
+             <<"             (default) or BANDIT\n"
+             <<"  -R <RT>    real‑time mode: lock and prefault memory and run the thread roles with\n"
+             <<"             SCHED_FIFO / SCHED_RR (needs root or CAP_SYS_NICE; what was granted is printed):\n"
+             <<"               fifo | rr   dispatcher 80, GPU/DSP workers 70, CPU worker 60, stager/poster 50\n"
+             <<"               disp=fifo/80:cpu=rr/60:gpu=fifo/70:dsp=fifo/70:host=rr/50   explicit, omitted\n"
+             <<"                           roles stay under CFS\n"
+             <<"  -H <N>     also run every point against N CPU‑hog threads (placement \"<name>+hogN\");\n"
+             <<"             results.csv gets release jitter and p99 response time of both\n"
+             <<"  -K <N[:TOL]>  cache the results of the last N distinct input frames per model; a\n"
+             <<"             frame equal to a cached one completes at submit without executing. TOL > 0\n"
+             <<"             matches frames whose 64 slice means all differ by at most TOL (default:\n"
+             <<"             identical frames only). The daemon applies it too\n"
+             <<"  -I <STILL[:NOISE]>  submit synthetic scene frames instead of the default input: 4\n"
+             <<"             scenes per model, each release keeps the scene with probability STILL and\n"
+             <<"             adds ± NOISE uniform noise per capture (4 captures per scene)\n"
+             <<"  -Y <W>x<H>[:nv12]  the scene frames are NV21 (or NV12) camera frames of this size,\n"
+             <<"             converted, resized and normalized into the input buffer by every request\n"
+             <<"             (models without an H×W×3 input keep float frames; NOISE is in pixel\n"
+             <<"             steps of 1/255). Without -I a new scene every release. The stage times\n"
+             <<"             are printed and in latency.csv\n"
+             <<"  -N <MEAN>[:<SCALE>]  camera frame normalization (pixel − MEAN) · SCALE, one value or\n"
+             <<"             R,G,B (default 0:1, pixels 0…255)\n"
+             <<"  -h         show this help\n";
+}
+
+int main(int argc, char** argv)
 {
-    const std::chrono::seconds simDur(15);
-    std::mt19937 rng{std::random_device{}()};
+    for(int opt; (opt = getopt(argc, argv, "hd:at:o:q:P:xA:S:w:r:W:C:n:s:c:D:M:p:R:H:K:I:Y:N:B:")) != -1; ){
+        switch(opt){
+            case 'd': gOpt.simSec    = std::max(1, atoi(optarg)); break;
+            case 'W': gOpt.warmupSec   = std::max(0.0, atof(optarg)); break;
+            case 'C': gOpt.cooldownSec = std::max(0.0, atof(optarg)); break;
+            case 'n': gOpt.reps        = std::max(1, atoi(optarg));   break;
+            case 's': gOpt.sampleMs    = std::max(0, atoi(optarg));   break;
+            case 'c': gOpt.capTarget   = std::max(0.0, atof(optarg)); break;
+            case 'a': gOpt.afc       = true;                      break;
+            case 't': gOpt.afcTarget = atof(optarg);              break;
+            case 'o':
+                if     (!strcmp(optarg,"util")) gOpt.staticObj = AssignObjective::MAX_UTIL;
+                else if(!strcmp(optarg,"miss")) gOpt.staticObj = AssignObjective::EXP_MISS;
+                else { usage(argv[0]); return 1; }
+                break;
+            case 'q':
+                gOpt.fifo = strcmp(optarg,"wfq")  != 0;
+                gOpt.wfq  = strcmp(optarg,"fifo") != 0;
+                if(strcmp(optarg,"fifo") && strcmp(optarg,"wfq") && strcmp(optarg,"both")){
+                    usage(argv[0]); return 1; }
+                break;
+            case 'P': gOpt.placements.push_back(optarg);           break;
+            case 'x': gOpt.pipeline  = true;                      break;
+            case 'A':
+                if(!parseArrivalModel(optarg, gOpt.arrivals)){ usage(argv[0]); return 1; }
+                break;
+            case 'S': gOpt.seed = strtoull(optarg,nullptr,0); gOpt.seedSet = true; break;
+            case 'w': gOpt.traceOut = optarg;                      break;
+            case 'r': gOpt.traceIn  = optarg;                      break;
+            case 'D': gOpt.daemonPath = optarg;                    break;
+            case 'M':{
+                std::stringstream ss(optarg); std::vector<std::string> f;
+                for(std::string x; std::getline(ss, x, ':'); ) f.push_back(x);
+                if(f.size() < 2 || f.size() > 3){ usage(argv[0]); return 1; }
+                gOpt.daemonModels.push_back({ f[0], 0.0, 1.0, f[1], 0, f.size() > 2 ? atof(f[2].c_str()) : 1.0 });
+            } break;
+            case 'p':{
+                int k = 0;
+                while(k <= int(Policy::BANDIT) && strcmp(optarg, policyName(Policy(k)))) ++k;
+                if(k > int(Policy::BANDIT) || Policy(k) == Policy::STATIC_OPT){ usage(argv[0]); return 1; }
+                gOpt.daemonPolicy = Policy(k);
+            } break;
+            case 'R': if(!makeRtConfig(optarg, gOpt.realtime)){ usage(argv[0]); return 1; } break;
+            case 'H': gOpt.hogs = std::max(0, atoi(optarg));      break;
+            case 'K':{
+                char* end = nullptr;
+                gOpt.cacheEntries = size_t(std::max(0L, strtol(optarg, &end, 10)));
+                if(*end == ':') gOpt.cacheTol = std::max(0.0f, strtof(end+1, &end));
+                if(*end){ usage(argv[0]); return 1; }
+            } break;
+            case 'I':{
+                char* end = nullptr;
+                gOpt.stillProb = strtod(optarg, &end);
+                if(*end == ':') gOpt.sceneNoise = std::max(0.0f, strtof(end+1, &end));
+                if(*end || gOpt.stillProb < 0.0 || gOpt.stillProb > 1.0){ usage(argv[0]); return 1; }
+            } break;
+            case 'Y': if(!ParseYuvFormat(optarg, gOpt.camera)){ usage(argv[0]); return 1; } break;
+            case 'N': if(!ParsePixelNormalization(optarg, gOpt.cameraNorm)){ usage(argv[0]); return 1; } break;
+            case 'B':
+                gOpt.shareIo = optarg;
+                if(gOpt.shareIo != "small" && gOpt.shareIo != "huge"){ usage(argv[0]); return 1; }
+                break;
+            case 'h': usage(argv[0]); return 0;
+            default : usage(argv[0]); return 1;
+        }
+    }
+    if(gOpt.camera.width && gOpt.stillProb < 0.0) gOpt.stillProb = 0.0;
+    if(!gOpt.daemonPath.empty()){
+        const std::vector<CpuInfo> cpus = readCpuTopology();
+        Placement pl;
+        const std::string spec = gOpt.placements.empty() ? "auto" : gOpt.placements[0];
+        if(!makePlacement(spec, cpus, pl)){ std::cerr<<"invalid placement \""<<spec<<"\"\n"; return 1; }
+        zdl::SNPE::SNPEFactory::initializeLogging(zdl::DlSystem::LogLevel_t::LOG_ERROR);
+        dsched::ServiceConfig cfg;
+        cfg.pipeline = gOpt.pipeline;
+        if(gOpt.realtime.on()) cfg.threadStart = []{ prefaultStack(kStackPrefault); };
+        dsched::init(cfg);
+        return serveDaemon(cpus, pl);
+    }
+    const std::chrono::seconds simDur(gOpt.simSec);
+    if(!gOpt.seedSet) gOpt.seed = (uint64_t(std::random_device{}())<<32) | std::random_device{}();
+
+    if(gOpt.capTarget >= 0.0 && !gOpt.traceIn.empty()){
+        std::cerr<<"-c probes arbitrary scales and generates its own arrivals; it cannot replay -r\n"; return 1; }
+
+    /* one arrival trace per scenario / scale / repetition, shared by every placement,
+       policy and queue; it spans warm‑up, measured window and cool‑down */
+    std::map<std::string, std::vector<Arrival>> traces;
+    auto traceKey = [](const std::string& sc, double scf, int rep){
+        std::ostringstream k; k<<sc<<'@'<<scf<<'#'<<rep; return k.str(); };
+    const double traceSec = gOpt.warmupSec + gOpt.simSec + gOpt.cooldownSec;
+    auto makeTrace = [&](const std::string& sc, const Scenario& S, double scf, int rp){
+        std::vector<ArrivalSource> src;
+        for(const auto& m : S) src.push_back({ m.fps*scf, m.prob });
+        uint64_t h = 1469598103934665603ULL;                 // FNV‑1a of the key, mixed into the seed
+        for(char c : traceKey(sc,scf,rp)){ h ^= uint8_t(c); h *= 1099511628211ULL; }
+        return makeArrivals(src, gOpt.arrivals, traceSec, gOpt.seed ^ h);
+    };
+    if(!gOpt.traceIn.empty()){
+        if(!readTraces(gOpt.traceIn, traces)){ std::cerr<<"cannot read arrival trace "<<gOpt.traceIn<<"\n"; return 1; }
+        std::cout<<"Replaying arrivals from "<<gOpt.traceIn<<"\n";
+    } else {
+        if(gOpt.capTarget < 0.0)
+            for(const auto& sc : kScenarios)
+                for(double scf : kScales)
+                    for(int rp=0;rp<gOpt.reps;++rp)
+                        traces[traceKey(sc.first,scf,rp)] = makeTrace(sc.first, sc.second, scf, rp);
+        std::cout<<"Arrivals "<<arrivalModelName(gOpt.arrivals)<<", seed "<<gOpt.seed
+                 <<" (-S "<<gOpt.seed<<" repeats them)\n";
+    }
+    if(!gOpt.traceOut.empty()){
+        std::ofstream tr(gOpt.traceOut);
+        tr<<"key,t_s,model,u\n";
+        for(const auto& kv : traces) writeTrace(tr, kv.first, kv.second);
+        if(!tr){ std::cerr<<"cannot write arrival trace "<<gOpt.traceOut<<"\n"; return 1; }
+    }
+
+    const std::vector<CpuInfo> cpus = readCpuTopology();
+    printCpuTopology(cpus);
+    if(gOpt.placements.empty()) gOpt.placements.push_back("auto");
+    std::vector<Placement> places;
+    for(const auto& spec : gOpt.placements){
+        Placement pl;
+        if(!makePlacement(spec, cpus, pl)){ std::cerr<<"invalid placement \""<<spec<<"\"\n"; return 1; }
+        std::replace(pl.name.begin(), pl.name.end(), ',', '+');          // keep the CSVs parseable
+        places.push_back(pl);
+    }
 
     zdl::SNPE::SNPEFactory::initializeLogging(zdl::DlSystem::LogLevel_t::LOG_ERROR);
+    dsched::ServiceConfig cfg;
+    cfg.pipeline = gOpt.pipeline;
+    cfg.seed     = uint32_t(gOpt.seed);
+    if(gOpt.realtime.on()) cfg.threadStart = []{ prefaultStack(kStackPrefault); };
+    dsched::init(cfg);
     preload();
-
-    std::thread cpuT(worker, Runtime_t::CPU, 0);
-    std::thread gpuT(worker, Runtime_t::GPU, 1);
-    std::thread dspT(worker, Runtime_t::DSP, 2);
+    shareIo();
+    if(gOpt.realtime.on()) prepareRealtime();
+    dsched::start();
+    if(gOpt.realtime.on()) applyRealtime();
 
     std::ofstream csv("results.csv"); csv<<std::unitbuf;
-    csv<<"scenario,scale,policy,miss_rate\n";
-
-    for(const auto& sc : kScenarios){
-        for(double scf : kScales){
-            std::cout<<"\n>>> Scenario \""<<sc.first<<"\"   scale="<<scf<<"\n";
-            for(Policy p : {Policy::CPU_ONLY,Policy::GPU_ONLY,Policy::DSP_ONLY,
-                            Policy::RANDOM,Policy::JSQ,Policy::DYNAMIC})
-            {
-                std::cout<<"   "<<kPolName[int(p)]<<" ... "<<std::flush;
-                double miss = runOne(sc.second, p, scf, simDur, rng);
-                std::cout<<miss<<"%\n";
-                csv<<sc.first<<','<<scf<<','<<kPolName[int(p)]<<','<<miss<<'\n';
+    csv<<"scenario,scale,policy,queue,placement,rep,miss_rate,crit_miss_rate,regret_ms,"
+         "cpu_util_mean,cpu_util_max,gpu_util_mean,gpu_util_max,dsp_util_mean,dsp_util_max,arrivals,"
+         "realtime,release_late_mean_us,release_late_p99_us,release_late_max_us,resp_p99_ms,"
+         "cache_hit_pct,cache_saved_ms,cache_freed_ms\n";
+    if(gOpt.sampleMs > 0 && !EnsureDirectory("timeseries")){ std::cerr<<"cannot create timeseries/\n"; return 1; }
+    std::ofstream sumCsv("summary.csv");
+    sumCsv<<"scenario,scale,policy,queue,placement,reps,miss_mean,miss_ci95,crit_miss_mean,crit_miss_ci95,"
+            "regret_mean_ms,regret_ci95_ms\n";
+    const std::string arrName = gOpt.traceIn.empty() ? arrivalModelName(gOpt.arrivals) : "trace:"+gOpt.traceIn;
+    std::ofstream fpsLog("fps_log.csv");
+    fpsLog<<"scenario,scale,policy,queue,placement,rep,t,model,class,target_fps,rate,achieved_fps,crit_miss_rate\n";
+    std::ofstream modelCsv("per_model.csv");
+    modelCsv<<"scenario,scale,policy,queue,placement,rep,model,weight,released,completed,"
+              "throughput_share,time_share,miss_rate,cache_lookups,cache_hits,cache_saved_ms,cache_freed_ms\n";
+    std::ofstream latCsv("latency.csv");
+    latCsv<<"scenario,scale,policy,queue,placement,rep,runtime,io,n,exec_mean_ms,exec_p99_ms,"
+            "resp_mean_ms,resp_p99_ms,util_pct,host_mean_ms,prep_frames,convert_ms,resize_ms,normalize_ms\n";
+    std::ofstream capCsv;
+    if(gOpt.capTarget >= 0.0){
+        capCsv.open("capacity.csv"); capCsv<<std::unitbuf;
+        capCsv<<"scenario,policy,queue,placement,target_pct,capacity_scale,bracket_hi,probes\n";
+    }
+    std::vector<bool> disciplines;
+    if(gOpt.fifo) disciplines.push_back(false);
+    if(gOpt.wfq)  disciplines.push_back(true);
+    const std::vector<Policy> policies = { Policy::CPU_ONLY,Policy::GPU_ONLY,Policy::DSP_ONLY,
+                                           Policy::RANDOM,Policy::JSQ,Policy::DYNAMIC,Policy::STATIC_OPT,
+                                           Policy::BANDIT };
+
+    /* one measured run, echoed to the console and every per‑run CSV */
+    auto runLogged = [&](const Placement& pl, int hogs, const std::string& scName, const Scenario& S, double scf,
+                         int rp, const std::vector<Arrival>& arr, Policy p, bool wfq){
+        const char* qn = wfq ? "WFQ" : "FIFO";
+        std::cout<<"   "<<policyName(p)<<'/'<<qn<<" ... "<<std::flush;
+        std::ostringstream tag; tag<<scName<<','<<scf<<','<<policyName(p)<<','<<qn<<','<<pl.name<<','<<rp;
+        CpuHog hog;
+        if(hogs) hog.start(hogs, cpus);
+        RunRes r = runOne(S, gIds[scName], arr, p, wfq, scf, simDur, tag.str(), fpsLog);
+        hog.stop();
+        std::cout<<r.miss<<"%  (critical "<<r.critMiss<<"%, regret "<<r.regretMs<<" ms, util";
+        for(int rt=0;rt<3;++rt)
+            std::cout<<' '<<runtimeName(static_cast<Runtime_t>(rt))<<' '<<int(r.rt[rt].util+0.5)<<'%';
+        std::cout<<", release p99 "<<r.relLateP99Us<<" µs, response p99 "<<r.respP99Ms<<" ms";
+        if(!gOpt.shareIo.empty() && gOpt.pipeline) std::cout<<", IO faults "<<dsched::ioLivenessFaults();
+        if(gOpt.cacheEntries)
+            std::cout<<", cache hits "<<(r.cache.lookups ? 100.0*r.cache.hits/r.cache.lookups : 0.0)<<"% (saved "
+                     <<r.cache.savedMs<<" ms, freed "<<r.cache.freedMs<<" ms)";
+        PreprocessTimes pt;
+        for(int rt=0;rt<3;++rt) pt += r.rt[rt].prep;
+        if(pt.frames)
+            std::cout<<", preprocess convert/resize/normalize "<<pt.convertMs/pt.frames<<'/'
+                     <<pt.resizeMs/pt.frames<<'/'<<pt.normalizeMs/pt.frames<<" ms";
+        std::cout<<")\n";
+        csv<<tag.str()<<','<<r.miss<<','<<r.critMiss<<','<<r.regretMs;
+        for(int rt=0;rt<3;++rt) csv<<','<<r.utilMean[rt]<<','<<r.utilMax[rt];
+        csv<<','<<arrName<<','<<gRtLabel<<','<<r.relLateMeanUs<<','<<r.relLateP99Us<<','<<r.relLateMaxUs
+           <<','<<r.respP99Ms<<','<<(r.cache.lookups ? 100.0*r.cache.hits/r.cache.lookups : 0.0)
+           <<','<<r.cache.savedMs<<','<<r.cache.freedMs<<'\n';
+        for(const auto& m:r.models)
+            modelCsv<<tag.str()<<','<<m.name<<','<<m.weight<<','<<m.rel<<','<<m.done<<','
+                    <<m.tputShare<<','<<m.timeShare<<','<<m.miss<<','<<m.cache.lookups<<','
+                    <<m.cache.hits<<','<<m.cache.savedMs<<','<<m.cache.freedMs<<'\n';
+        for(int rt=0;rt<3;++rt)
+            if(r.rt[rt].n){
+                latCsv<<tag.str()<<','<<runtimeName(static_cast<Runtime_t>(rt))<<','
+                      <<(gOpt.pipeline?"pipelined":"serial")<<','<<r.rt[rt].n<<','
+                      <<r.rt[rt].execMean<<','<<r.rt[rt].execP99<<','
+                      <<r.rt[rt].respMean<<','<<r.rt[rt].respP99<<','
+                      <<r.rt[rt].util<<','<<r.rt[rt].hostMean<<','<<r.rt[rt].prep.frames;
+                const PreprocessTimes& pt = r.rt[rt].prep;
+                const double nf = pt.frames ? double(pt.frames) : 1.0;
+                latCsv<<','<<pt.convertMs/nf<<','<<pt.resizeMs/nf<<','<<pt.normalizeMs/nf<<'\n';
+            }
+        if(r.stuck)                                 // its completions would land in the next run
+            throw std::runtime_error("run "+tag.str()+" aborted: "+std::to_string(r.stuck)+" request(s) still "
+                                     "executing "+std::to_string(kBarrierSec)+" s after the drain");
+        return r;
+    };
+
+    /* largest scale whose mean miss rate over the repetitions stays within the target */
+    auto searchCapacity = [&](const Placement& pl, int hogs, const std::string& scName, const Scenario& S,
+                              Policy p, bool wfq){
+        int probes = 0;
+        auto ok = [&](double scf){
+            ++probes;
+            std::cout<<"  scale "<<scf<<"\n";
+            double sum = 0.0;
+            for(int rp=0;rp<gOpt.reps;++rp)
+                sum += runLogged(pl, hogs, scName, S, scf, rp, makeTrace(scName, S, scf, rp), p, wfq).lateMiss;
+            double m = sum/gOpt.reps;
+            std::cout<<"   → miss "<<m<<"% "<<(m <= gOpt.capTarget ? "≤" : ">")<<" target\n";
+            return m <= gOpt.capTarget;
+        };
+        double lo = 0.0, hi = 1.0;
+        while(probes < kCapProbes && hi <= kCapMaxScale && ok(hi)){ lo = hi; hi *= 2.0; }
+        while(probes < kCapProbes && hi <= kCapMaxScale && hi-lo > kCapTol*hi){
+            double mid = 0.5*(lo+hi);
+            if(ok(mid)) lo = mid; else hi = mid;
+        }
+        const char* qn = wfq ? "WFQ" : "FIFO";
+        std::cout<<"  ⇒ "<<policyName(p)<<'/'<<qn<<" sustains scale "<<lo
+                 <<(hi > kCapMaxScale ? " (search limit)" : "")<<"\n";
+        capCsv<<scName<<','<<policyName(p)<<','<<qn<<','<<pl.name<<','<<gOpt.capTarget<<','
+              <<lo<<','<<std::min(hi, kCapMaxScale)<<','<<probes<<'\n';
+    };
+
+    std::vector<int> loads{ 0 };
+    if(gOpt.hogs > 0) loads.push_back(gOpt.hogs);
+    bool aborted = false;
+    try{
+        for(const auto& base : places){
+            std::cout<<"\n=== placement "<<base.name<<": CPU worker "<<cpuListStr(base.worker[0])
+                     <<", GPU worker "<<cpuListStr(base.worker[1])<<", DSP worker "<<cpuListStr(base.worker[2])
+                     <<", dispatcher "<<cpuListStr(base.dispatcher)<<" ===\n";
+            bool pinned = pinThread(0, base.dispatcher, cpus);
+            for(int r=0;r<3;++r)                       // host stages share their runtime's cores
+                for(pid_t t : dsched::threadIds(static_cast<Runtime_t>(r))) pinned &= pinThread(t, base.worker[r], cpus);
+            if(!pinned) std::cerr<<"warning: sched_setaffinity failed for placement "<<base.name<<"\n";
+            for(int hogs : loads){                      // without, then with the background load
+                Placement pl = base;
+                if(hogs){ pl.name += "+hog"+std::to_string(hogs);
+                          std::cout<<"\n=== background load: "<<hogs<<" CPU‑hog threads ===\n"; }
+
+                for(const auto& sc : kScenarios){
+                    if(gOpt.capTarget >= 0.0){
+                        std::cout<<"\n>>> Scenario \""<<sc.first<<"\"   capacity at ≤ "<<gOpt.capTarget<<"% misses\n";
+                        for(Policy p : policies)
+                            for(bool wfq : disciplines) searchCapacity(pl, hogs, sc.first, sc.second, p, wfq);
+                        continue;
+                    }
+                    for(double scf : kScales){
+                        std::cout<<"\n>>> Scenario \""<<sc.first<<"\"   scale="<<scf<<"\n";
+                        std::map<std::pair<int,bool>, std::array<std::vector<double>,3>> runs;  // miss, crit, regret
+                        for(int rp=0;rp<gOpt.reps;++rp){
+                            auto tr = traces.find(traceKey(sc.first,scf,rp));
+                            if(tr == traces.end()){
+                                std::cerr<<"no arrivals for "<<traceKey(sc.first,scf,rp)<<" in "<<gOpt.traceIn<<", skipped\n";
+                                continue;
+                            }
+                            std::cout<<"  rep "<<rp<<" ("<<tr->second.size()<<" arrivals)\n";
+                            for(Policy p : policies)
+                                for(bool wfq : disciplines){
+                                    RunRes r = runLogged(pl, hogs, sc.first, sc.second, scf, rp, tr->second, p, wfq);
+                                    auto& acc = runs[std::make_pair(int(p),wfq)];
+                                    acc[0].push_back(r.miss); acc[1].push_back(r.critMiss); acc[2].push_back(r.regretMs);
+                                }
+                        }
+                        if(gOpt.reps > 1) std::cout<<"  mean ± 95 % CI over "<<gOpt.reps<<" reps:\n";
+                        for(const auto& kv : runs){
+                            double m[3], h[3];
+                            for(int k=0;k<3;++k) meanCi95(kv.second[k], m[k], h[k]);
+                            const char* qn = kv.first.second ? "WFQ" : "FIFO";
+                            sumCsv<<sc.first<<','<<scf<<','<<policyName(Policy(kv.first.first))<<','<<qn<<','<<pl.name<<','
+                                  <<kv.second[0].size()<<','<<m[0]<<','<<h[0]<<','<<m[1]<<','<<h[1]<<','<<m[2]<<','<<h[2]<<'\n';
+                            if(gOpt.reps > 1)
+                                std::cout<<"   "<<policyName(Policy(kv.first.first))<<'/'<<qn<<"  "<<m[0]<<" ± "<<h[0]
+                                         <<"%  (critical "<<m[1]<<" ± "<<h[1]<<"%)\n";
+                        }
+                    }
+                }
             }
         }
     }
+    catch(const std::runtime_error& e){ std::cerr<<"\n"<<e.what()<<"; the sweep stops here\n"; aborted = true; }
 
-    gStop = true; for(auto& q:queues) q.cv.notify_all();
-    cpuT.join(); gpuT.join(); dspT.join();
+    dsched::stop();
+    const bool live = ioLive();
 
-    std::cout<<"\nAll results written to results.csv\n";
-    return 0;
+    if(gOpt.capTarget >= 0.0) std::cout<<"\nSustainable scale per policy written to capacity.csv";
+    std::cout<<(aborted ? "\nResults measured so far" : "\nAll results")
+             <<" written to results.csv (means and 95 % CIs over repetitions in summary.csv,"
+               " per‑model shares in per_model.csv, fps over time in fps_log.csv, latency per placement"
+               " in latency.csv)\n";
+    return live && !aborted ? 0 : 1;
 }
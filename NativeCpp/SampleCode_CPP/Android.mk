@@ -18,7 +18,7 @@ SNPE_INCLUDE_DIR := $(SNPE_ROOT)/include/SNPE
 
 include $(CLEAR_VARS)
 LOCAL_MODULE := snpe-sample
-LOCAL_SRC_FILES := main.cpp CheckRuntime.cpp LoadContainer.cpp LoadUDOPackage.cpp LoadInputTensor.cpp SetBuilderOptions.cpp Util.cpp NV21Load.cpp CreateUserBuffer.cpp PreprocessInput.cpp SaveOutputTensor.cpp CreateGLBuffer.cpp CreateGLContext.cpp
+LOCAL_SRC_FILES := main.cpp CheckRuntime.cpp LoadContainer.cpp LoadUDOPackage.cpp LoadInputTensor.cpp SetBuilderOptions.cpp Util.cpp NV21Load.cpp CreateUserBuffer.cpp PreprocessInput.cpp SaveOutputTensor.cpp CreateGLBuffer.cpp CreateGLContext.cpp Pipeline.cpp OutputWriter.cpp InputPack.cpp YuvPreprocess.cpp UserBufferArena.cpp
 LOCAL_CFLAGS := -DENABLE_GL_BUFFER
 LOCAL_SHARED_LIBRARIES := libSNPE
 LOCAL_LDLIBS     := -lGLESv2 -lEGL
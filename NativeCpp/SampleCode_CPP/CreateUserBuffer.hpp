@@ -13,35 +13,46 @@
 #include "SNPE/SNPE.hpp"
 #include "DlSystem/IUserBuffer.hpp"
 #include "DlSystem/UserBufferMap.hpp"
+#include "UserBufferArena.hpp"
 
 typedef unsigned int GLuint;
 
-// Helper function to fill a single entry of the UserBufferMap with the given user-backed buffer
+// Helper function to fill a single entry of the UserBufferMap with the given user-backed buffer.
+// With an arena the application storage is carved out of it instead of the heap.
 void createUserBuffer(zdl::DlSystem::UserBufferMap& userBufferMap,
-                      std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                      std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                       std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
                       std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                       const char * name,
                       const bool isTfNBuffer,
                       bool staticQuantization,
-                      int bitWidth);
+                      int bitWidth,
+                      UserBufferArena* arena = nullptr);
 
 // Create a UserBufferMap of the SNPE network inputs
 void createInputBufferMap(zdl::DlSystem::UserBufferMap& inputMap,
-                          std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                          std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                           std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
                           std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                           const bool isTfNBuffer,
                           bool staticQuantization,
-                          int bitWidth);
+                          int bitWidth,
+                          UserBufferArena* arena = nullptr);
 
 // Create a UserBufferMap of the SNPE network outputs
 void createOutputBufferMap(zdl::DlSystem::UserBufferMap& outputMap,
-                           std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+                           std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                            std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>>& snpeUserBackedBuffers,
                            std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                            const bool isTfNBuffer,
-                           int bitWidth);
+                           int bitWidth,
+                           UserBufferArena* arena = nullptr);
+
+// Size of an arena for sets sets of the network's input and output buffers
+size_t userBufferArenaBytes(std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                            const bool isTfNBuffer,
+                            int bitWidth,
+                            size_t sets = 1);
 
 void createUserBuffer(zdl::DlSystem::UserBufferMap& userBufferMap,
                       std::unordered_map<std::string, GLuint>& applicationBuffers,
@@ -0,0 +1,340 @@
+// InputPack.cpp – every input of an input list in one mapped file, ready for the user buffers
+#include "InputPack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "CreateUserBuffer.hpp"
+#include "DlSystem/IUserBuffer.hpp"
+
+namespace
+{
+const char kMagic[8] = {'S', 'N', 'P', 'E', 'I', 'N', 'P', 'K'};
+const uint32_t kVersion = 1;
+const size_t kHeaderBytes = 64;
+
+void putLe(std::string& out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+// Bounds-checked little-endian reads over the mapped metadata
+class Reader
+{
+public:
+    Reader(const uint8_t* p, size_t n) : m_p(p), m_end(p + n) {}
+    bool get(uint64_t& v, int bytes)
+    {
+        if (m_end - m_p < bytes) return false;
+        v = 0;
+        for (int i = 0; i < bytes; ++i) v |= uint64_t(m_p[i]) << (8 * i);
+        m_p += bytes;
+        return true;
+    }
+    bool get(std::string& s)
+    {
+        uint64_t n;
+        if (!get(n, 4) || uint64_t(m_end - m_p) < n) return false;
+        s.assign(reinterpret_cast<const char*>(m_p), size_t(n));
+        m_p += n;
+        return true;
+    }
+private:
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+};
+
+// The file of every network input on an input list line: "<file> <file> ..." in input
+// order, or "<inputname>:=<file> ..."
+bool inputFilePaths(const std::string& fileLine, const std::vector<std::string>& inputNames, std::vector<std::string>& paths)
+{
+    std::vector<std::string> filePaths;
+    split(filePaths, fileLine, ' ');
+    std::unordered_map<std::string, std::string> nameToFilePathMap;
+    if (fileLine.find(":=") != std::string::npos) {
+        for (auto& entry : filePaths) {
+            if (entry.empty()) continue;
+            std::vector<std::string> lineContents;
+            split(lineContents, entry, '=');
+            std::string name = lineContents[0];
+            name.erase(name.length() - 1);
+            nameToFilePathMap.emplace(name, lineContents.size() > 1 ? lineContents[1] : "");
+        }
+    }
+    paths.clear();
+    for (size_t j = 0; j < inputNames.size(); ++j) {
+        auto it = nameToFilePathMap.find(inputNames[j]);
+        if (it == nameToFilePathMap.end() && j >= filePaths.size()) {
+            std::cerr << "No input file for " << inputNames[j] << " on line: " << fileLine << "\n";
+            return false;
+        }
+        paths.push_back(it != nameToFilePathMap.end() ? it->second : filePaths[j]);
+    }
+    return true;
+}
+
+// What a pack for the network holds: the input buffers of a run, the input names and the
+// bytes of one line of each input
+struct Layout
+{
+    zdl::DlSystem::UserBufferMap inputMap;
+    std::unordered_map<std::string, ApplicationBuffer> applicationBuffers;
+    std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> snpeBuffers;
+    std::vector<std::string> names;
+    std::vector<uint64_t> bytes;
+    uint32_t elementBits;
+    uint32_t flags;
+
+    Layout(std::unique_ptr<zdl::SNPE::SNPE>& snpe, bool isTfNBuffer, bool staticQuantization, int bitWidth,
+           bool useNativeInputFiles, size_t batchSize)
+        : elementBits(isTfNBuffer ? uint32_t(bitWidth) : 32u),
+          flags((staticQuantization ? 1u : 0u) | (useNativeInputFiles ? 2u : 0u))
+    {
+        createInputBufferMap(inputMap, applicationBuffers, snpeBuffers, snpe, isTfNBuffer, staticQuantization, bitWidth);
+        const auto& inputNamesOpt = snpe->getInputTensorNames();
+        if (!inputNamesOpt) throw std::runtime_error("Error obtaining input tensor names");
+        for (size_t j = 0; j < (*inputNamesOpt).size(); ++j) {
+            names.push_back((*inputNamesOpt).at(j));
+            bytes.push_back(applicationBuffers.at(names.back()).size() / batchSize);
+        }
+    }
+};
+
+uint64_t fileSize(const std::string& path)
+{
+    std::ifstream in(path, std::ifstream::binary | std::ifstream::ate);
+    return in ? static_cast<uint64_t>(in.tellg()) : 0;
+}
+
+bool pad(std::ofstream& out, uint64_t& pos, size_t alignment)
+{
+    static const char zeros[InputPack::kPackAlignment] = {};
+    const size_t n = (alignment - pos % alignment) % alignment;
+    pos += n;
+    return static_cast<bool>(out.write(zeros, static_cast<std::streamsize>(n)));
+}
+}
+
+bool InputPack::open(const std::string& path)
+{
+    MappedFile file(path);
+    if (!file.valid()) return false;
+    const uint8_t* p = file.as<uint8_t>();
+    uint64_t magic = 0, version = 0, elementBits = 0, flags = 0, inputs = 0, lines = 0, batchSize = 0, metaOffset = 0, metaBytes = 0;
+    Reader header(p, std::min(file.size(), kHeaderBytes));
+    if (file.size() < kHeaderBytes || std::memcmp(p, kMagic, sizeof(kMagic)) != 0) {
+        std::cerr << path << " is not a packed input file\n";
+        return false;
+    }
+    header.get(magic, 8);
+    header.get(version, 4); header.get(elementBits, 4); header.get(flags, 4); header.get(inputs, 4);
+    header.get(lines, 8); header.get(batchSize, 8); header.get(metaOffset, 8); header.get(metaBytes, 8);
+    if (version != kVersion || metaOffset > file.size() || metaBytes > file.size() - metaOffset || batchSize == 0
+        || inputs == 0 || lines > metaBytes / 16 / inputs) {
+        std::cerr << path << " is damaged or of another version; delete it to recreate it\n";
+        return false;
+    }
+
+    Reader meta(p + metaOffset, size_t(metaBytes));
+    std::vector<std::string> names(static_cast<size_t>(inputs)), text(static_cast<size_t>(lines));
+    std::vector<uint64_t> bytes(names.size()), offsets(static_cast<size_t>(lines * inputs));
+    std::vector<unsigned char> steps0(offsets.size());
+    std::vector<float> stepSizes(offsets.size());
+    bool ok = true;
+    for (size_t j = 0; ok && j < names.size(); ++j)
+        ok = meta.get(names[j]) && meta.get(bytes[j], 8);
+    for (size_t l = 0; ok && l < text.size(); ++l)
+        ok = meta.get(text[l]);
+    for (size_t e = 0; ok && e < offsets.size(); ++e) {
+        uint64_t step0 = 0, stepBits = 0;
+        ok = meta.get(offsets[e], 8) && meta.get(step0, 4) && meta.get(stepBits, 4)
+          && offsets[e] <= metaOffset && bytes[e % names.size()] <= metaOffset - offsets[e];
+        steps0[e] = static_cast<unsigned char>(step0);
+        const uint32_t bits = static_cast<uint32_t>(stepBits);
+        std::memcpy(&stepSizes[e], &bits, sizeof(float));
+    }
+    if (!ok) {
+        std::cerr << path << " is damaged; delete it to recreate it\n";
+        return false;
+    }
+
+    m_file = std::move(file);
+    m_elementBits = static_cast<uint32_t>(elementBits);
+    m_flags = static_cast<uint32_t>(flags);
+    m_batchSize = size_t(batchSize);
+    m_names.swap(names);
+    m_bytes.swap(bytes);
+    m_lineText.swap(text);
+    m_offsets.swap(offsets);
+    m_steps0.swap(steps0);
+    m_stepSizes.swap(stepSizes);
+    m_lines.clear();
+    for (size_t l = 0; l < m_lineText.size(); ++l) m_lines.emplace(m_lineText[l], l);
+    return true;
+}
+
+bool InputPack::fits(std::unique_ptr<zdl::SNPE::SNPE>& snpe, bool isTfNBuffer, bool staticQuantization,
+                     int bitWidth, bool useNativeInputFiles, size_t batchSize) const
+{
+    const Layout layout(snpe, isTfNBuffer, staticQuantization, bitWidth, useNativeInputFiles, batchSize);
+    return layout.elementBits == m_elementBits && layout.flags == m_flags && batchSize == m_batchSize
+        && layout.names == m_names && layout.bytes == m_bytes;
+}
+
+size_t InputPack::find(const std::string& line) const
+{
+    auto it = m_lines.find(line);
+    return it == m_lines.end() ? lines() : it->second;
+}
+
+bool createInputPack(const std::string& path,
+                     std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                     const std::vector<std::vector<std::string>>& inputs,
+                     bool isTfNBuffer,
+                     bool staticQuantization,
+                     int bitWidth,
+                     bool useNativeInputFiles,
+                     size_t batchSize)
+{
+    // The static encodings come from the input buffers as a run creates them
+    Layout layout(snpe, isTfNBuffer, staticQuantization, bitWidth, useNativeInputFiles, batchSize);
+    const std::vector<std::string>& names = layout.names;
+    const std::vector<uint64_t>& bytes = layout.bytes;
+    std::string meta;
+    for (size_t j = 0; j < names.size(); ++j) {
+        putLe(meta, names[j].size(), 4);
+        meta += names[j];
+        putLe(meta, bytes[j], 8);
+    }
+    size_t lines = 0;
+    for (const auto& batch : inputs) {
+        for (const auto& line : batch) {
+            putLe(meta, line.size(), 4);
+            meta += line;
+            ++lines;
+        }
+    }
+
+    // the header is written last, over these zeros, once the metadata offset is known
+    std::ofstream out(path, std::ofstream::binary | std::ofstream::trunc);
+    const std::string placeholder(kHeaderBytes, '\0');
+    uint64_t pos = kHeaderBytes;
+    if (!out || !out.write(placeholder.data(), static_cast<std::streamsize>(placeholder.size()))) {
+        std::cerr << "Failed to open output file for writing: " << path << "\n";
+        return false;
+    }
+    // The index entries of a batch, (line, input) in line order, written once the batch is done
+    std::vector<std::string> index(names.size());
+    std::vector<std::string> paths;
+    ApplicationBuffer entry;
+    for (const auto& batch : inputs) {
+        for (auto& e : index) e.clear();
+        for (size_t j = 0; j < names.size(); ++j) {
+            if (!pad(out, pos, InputPack::kPackAlignment)) break;
+            for (const auto& line : batch) {
+                if (!inputFilePaths(line, names, paths)) return false;
+                const std::string& filePath = paths[j];
+                // the size a run would read, in the elements of the input list files
+                const uint64_t expected = isTfNBuffer && !useNativeInputFiles ? bytes[j] / (bitWidth / 8) * sizeof(float) : bytes[j];
+                if (fileSize(filePath) != expected) {
+                    std::cerr << "Size of input file " << filePath << " does not match network.\n"
+                              << "Expecting: " << expected << " bytes\n"
+                              << "Got: " << fileSize(filePath) << " bytes\n";
+                    return false;
+                }
+                entry.assign(bytes[j], 0);
+                unsigned char stepEquivalentTo0 = 0;
+                float quantizedStepSize = 0.0f;
+                if (isTfNBuffer) {
+                    if (staticQuantization) {
+                        auto encoding = dynamic_cast<zdl::DlSystem::UserBufferEncodingTfN *>(&layout.inputMap.getUserBuffer(names[j].c_str())->getEncoding());
+                        stepEquivalentTo0 = encoding->getStepExactly0();
+                        quantizedStepSize = encoding->getQuantizedStepSize();
+                    }
+                    if (!loadByteDataFileBatchedTfN(filePath, entry, 0, stepEquivalentTo0, quantizedStepSize, staticQuantization, bitWidth, useNativeInputFiles))
+                        return false;
+                } else if (!loadByteDataFileBatched(filePath, entry, 0)) {
+                    return false;
+                }
+                putLe(index[j], pos, 8);
+                putLe(index[j], stepEquivalentTo0, 4);
+                uint32_t stepBits;
+                std::memcpy(&stepBits, &quantizedStepSize, sizeof(stepBits));
+                putLe(index[j], stepBits, 4);
+                if (!out.write(reinterpret_cast<const char*>(entry.data()), static_cast<std::streamsize>(entry.size()))) break;
+                pos += entry.size();
+            }
+        }
+        // interleave the per-input index entries into line-major order
+        for (size_t k = 0; k < batch.size(); ++k)
+            for (size_t j = 0; j < names.size(); ++j)
+                meta.append(index[j], k * 16, 16);
+    }
+
+    std::string header(kMagic, sizeof(kMagic));
+    putLe(header, kVersion, 4);
+    putLe(header, layout.elementBits, 4);
+    putLe(header, layout.flags, 4);
+    putLe(header, names.size(), 4);
+    putLe(header, lines, 8);
+    putLe(header, batchSize, 8);
+    putLe(header, pos, 8);
+    putLe(header, meta.size(), 8);
+    putLe(header, 0, 8);
+    if (!out || !out.write(meta.data(), static_cast<std::streamsize>(meta.size()))
+        || !out.seekp(0) || !out.write(header.data(), static_cast<std::streamsize>(header.size())) || !out.flush()) {
+        std::cerr << "Failed to write data to: " << path << "\n";
+        return false;
+    }
+    std::cout << "Packed " << lines << " input list lines into " << path << " (" << (pos + meta.size()) / 1048576.0 << " MiB)" << std::endl;
+    return true;
+}
+
+bool loadInputUserBufferPacked(const InputPack& pack,
+                               std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               const std::vector<std::string>& fileLines,
+                               bool isTfNBuffer)
+{
+    // where every line of the batch is in the pack
+    std::vector<size_t> lines;
+    for (const auto& line : fileLines) {
+        lines.push_back(pack.find(line));
+        if (lines.back() == pack.lines()) {
+            std::cerr << "Input list line is not in the packed input file, delete the pack to recreate it: " << line << "\n";
+            return false;
+        }
+    }
+    // a full batch stored as one: the first line starts a batch of the pack and the rest follow
+    const size_t base = lines[0];
+    bool inPlace = fileLines.size() == pack.batchSize() && base % pack.batchSize() == 0 && base + fileLines.size() <= pack.lines();
+    for (size_t k = 1; inPlace && k < fileLines.size(); ++k)
+        inPlace = pack.line(base + k) == fileLines[k];
+
+    const auto& names = pack.inputNames();
+    for (size_t j = 0; j < names.size(); ++j) {
+        const char* name = names[j].c_str();
+        zdl::DlSystem::IUserBuffer* buffer = inputMap.getUserBuffer(name);
+        uint8_t* address = pack.data(base, j);
+        if (!inPlace) {
+            ApplicationBuffer& storage = applicationBuffers.at(name);
+            for (size_t k = 0; k < lines.size(); ++k)
+                std::memcpy(storage.data() + k * pack.bytes(j), pack.data(lines[k], j), pack.bytes(j));
+            address = storage.data();
+        }
+        if (!buffer->setBufferAddress(address)) {
+            std::cerr << "Failed to point the user buffer of " << name << " at its packed input\n";
+            return false;
+        }
+        // Like the file loaders, a batch ends up with the encoding of its last line
+        if (isTfNBuffer && !pack.staticQuantization()) {
+            auto encoding = dynamic_cast<zdl::DlSystem::UserBufferEncodingTfN *>(&buffer->getEncoding());
+            encoding->setStepExactly0(pack.stepEquivalentTo0(inPlace ? base + lines.size() - 1 : lines.back(), j));
+            encoding->setQuantizedStepSize(pack.quantizedStepSize(inPlace ? base + lines.size() - 1 : lines.back(), j));
+        }
+    }
+    return true;
+}
@@ -0,0 +1,88 @@
+// InputPack.hpp – every input of an input list in one mapped file, ready for the user buffers
+#ifndef INPUTPACK_H
+#define INPUTPACK_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SNPE/SNPE.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+#include "Util.hpp"
+
+// A packed input file holds the inputs of every input list line as the user buffers take
+// them: already quantized to TF8/TF16 with their encoding, or as floats. Layout, with
+// little-endian integers:
+//
+//   header (64 bytes)   "SNPEINPK", uint32 version, uint32 element bits (8, 16 or 32),
+//                       uint32 flags (1 static quantization, 2 native input files),
+//                       uint32 inputs, uint64 lines, uint64 batch size,
+//                       uint64 metadata offset, uint64 metadata bytes, uint64 0
+//   data                per batch of lines, per input: the batch's inputs back to back,
+//                       starting on a kPackAlignment boundary
+//   metadata            per input: uint32 name length, name, uint64 bytes per line;
+//                       per line: uint32 length, the input list line;
+//                       per line, per input: uint64 offset, uint32 stepEquivalentTo0,
+//                       float quantizedStepSize
+//
+// A full batch of consecutive lines is therefore one aligned, contiguous block per input
+// that a user buffer can point at directly.
+class InputPack
+{
+public:
+    static const size_t kPackAlignment = 4096;
+
+    // Map a pack; false, with the reason on stderr, if it is missing or damaged.
+    bool open(const std::string& path);
+    // Whether the pack was made for the network's inputs with these buffer settings.
+    bool fits(std::unique_ptr<zdl::SNPE::SNPE>& snpe, bool isTfNBuffer, bool staticQuantization,
+              int bitWidth, bool useNativeInputFiles, size_t batchSize) const;
+
+    size_t lines() const { return m_lineText.size(); }
+    // Index of the first occurrence of an input list line, or lines() if it is not in the pack.
+    size_t find(const std::string& line) const;
+    const std::string& line(size_t line) const { return m_lineText[line]; }
+    size_t batchSize() const { return m_batchSize; }
+    uint8_t* data(size_t line, size_t input) const { return m_file.data() + m_offsets[line * m_names.size() + input]; }
+    unsigned char stepEquivalentTo0(size_t line, size_t input) const { return m_steps0[line * m_names.size() + input]; }
+    float quantizedStepSize(size_t line, size_t input) const { return m_stepSizes[line * m_names.size() + input]; }
+    bool staticQuantization() const { return m_flags & 1; }
+    const std::vector<std::string>& inputNames() const { return m_names; }
+    size_t bytes(size_t input) const { return m_bytes[input]; }
+
+private:
+    MappedFile m_file;
+    uint32_t m_elementBits = 0;
+    uint32_t m_flags = 0;
+    size_t m_batchSize = 0;
+    std::vector<std::string> m_names;
+    std::vector<uint64_t> m_bytes;
+    std::vector<std::string> m_lineText;
+    std::unordered_map<std::string, size_t> m_lines;
+    std::vector<uint64_t> m_offsets;
+    std::vector<unsigned char> m_steps0;
+    std::vector<float> m_stepSizes;
+};
+
+// Convert every input list line of inputs into a pack at path, through the same loaders
+// (and quantization) a run without a pack uses.
+bool createInputPack(const std::string& path,
+                     std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                     const std::vector<std::vector<std::string>>& inputs,
+                     bool isTfNBuffer,
+                     bool staticQuantization,
+                     int bitWidth,
+                     bool useNativeInputFiles,
+                     size_t batchSize);
+
+// Fill the input user buffers of a batch from the pack. A full batch of lines stored
+// together is bound in place, with no copy or conversion; any other batch is copied into
+// applicationBuffers. With dynamic quantization the buffers get the stored encodings.
+bool loadInputUserBufferPacked(const InputPack& pack,
+                               std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               const std::vector<std::string>& fileLines,
+                               bool isTfNBuffer);
+
+#endif
@@ -13,6 +13,8 @@
 #include <unordered_map>
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
+#include <chrono>
 
 #include "LoadInputTensor.hpp"
 #include "Util.hpp"
@@ -34,15 +36,6 @@ std::unique_ptr<zdl::DlSystem::ITensor> loadInputTensor (std::unique_ptr<zdl::SN
     // Make sure the network requires only a single input
     assert (inputTensorNames.size() == 1);
 
-    // If the network has a single input, each line represents the input file to be loaded for that input
-    std::vector<float> inputVec;
-    for(size_t i=0; i<fileLines.size(); i++) {
-        std::string filePath(fileLines[i]);
-        std::cout << "Processing DNN Input: " << filePath << "\n";
-        std::vector<float> loadedFile = loadFloatDataFile(filePath);
-        inputVec.insert(inputVec.end(), loadedFile.begin(), loadedFile.end());
-    }
-
     /* Create an input tensor that is correctly sized to hold the input of the network. Dimensions that have no fixed size will be represented with a value of 0. */
     const auto &inputDims_opt = snpe->getInputDimensions(inputTensorNames.at(0));
     const auto &inputShape = *inputDims_opt;
@@ -50,25 +43,43 @@ std::unique_ptr<zdl::DlSystem::ITensor> loadInputTensor (std::unique_ptr<zdl::SN
     /* Calculate the total number of elements that can be stored in the tensor so that we can check that the input contains the expected number of elements.
        With the input dimensions computed create a tensor to convey the input into the network. */
     input = zdl::SNPE::SNPEFactory::getTensorFactory().createTensor(inputShape);
-    //Padding the input vector so as to make the size of the vector to equal to an integer multiple of the batch size
     zdl::DlSystem::TensorShape tensorShape= snpe->getInputDimensions();
     size_t batchSize = tensorShape.getDimensions()[0];
+
+    // If the network has a single input, each line represents the input file to be loaded for that input.
+    // Each file is mapped and copied straight into its place in the tensor, the only copy of its data.
+    size_t filled = 0;
+    for(size_t i=0; i<fileLines.size(); i++) {
+        std::string filePath(fileLines[i]);
+        std::cout << "Processing DNN Input: " << filePath << "\n";
+        MappedFile file(filePath);
+        if (!file.valid()) {
+            return nullptr;
+        }
+        const size_t count = file.size() / sizeof(float);
+        if (filled + count > input->getSize()) {
+            std::cerr << "Size of input does not match network.\n"
+                      << "Expecting: " << input->getSize() << "\n"
+                      << "Got: " << filled + count << "\n";
+            return nullptr;
+        }
+        std::copy(file.as<float>(), file.as<float>() + count, input->begin() + filled);
+        filled += count;
+    }
+
+    //Padding the input with zeros so as to make it an integer multiple of the batch size
     if(fileLines.size()<batchSize) {
-           for(size_t j=0; j<batchSize-fileLines.size(); j++) {
-                std::vector<float> padding(input->getSize()/batchSize,0);
-                inputVec.insert(inputVec.end(),padding.begin(),padding.end());
-           }
+        const size_t padding = (batchSize-fileLines.size()) * (input->getSize()/batchSize);
+        std::fill(input->begin() + filled, input->begin() + std::min(filled + padding, input->getSize()), 0.0f);
+        filled += padding;
     }
 
-    if (input->getSize() != inputVec.size()) {
+    if (input->getSize() != filled) {
         std::cerr << "Size of input does not match network.\n"
                   << "Expecting: " << input->getSize() << "\n"
-                  << "Got: " << inputVec.size() << "\n";
+                  << "Got: " << filled << "\n";
         return nullptr;
     }
-
-    /* Copy the loaded input file contents into the networks input tensor. SNPE's ITensor supports C++ STL functions like std::copy() */
-    std::copy(inputVec.begin(), inputVec.end(), input->begin());
     return input;
 }
 
@@ -118,20 +129,25 @@ std::tuple<zdl::DlSystem::TensorMap, bool> loadMultipleInput (std::unique_ptr<zd
             // print out which file is being processed
             std::cout << "\t" << j + 1 << ") " << filePath << std::endl;
 
-            std::vector<float> inputVec = loadFloatDataFile(filePath);
+            MappedFile file(filePath);
+            if (!file.valid()) {
+                return std::make_tuple(dummy, false);
+            }
+            const size_t count = file.size() / sizeof(float);
 
             const auto &inputShape_opt = snpe->getInputDimensions(inputTensorNames.at(j));
             const auto &inputShape = *inputShape_opt;
             inputs[j] = zdl::SNPE::SNPEFactory::getTensorFactory().createTensor(inputShape);
 
-            if (inputs[j]->getSize() != inputVec.size()) {
+            if (inputs[j]->getSize() != count) {
                 std::cerr << "Size of input does not match network.\n"
                           << "Expecting: " << inputs[j]->getSize() << "\n"
-                          << "Got: " << inputVec.size() << "\n";
+                          << "Got: " << count << "\n";
                 return std::make_tuple(dummy, false);
             }
 
-            std::copy(inputVec.begin(), inputVec.end(), inputs[j]->begin());
+            // Copy straight from the mapped file into the tensor
+            std::copy(file.as<float>(), file.as<float>() + count, inputs[j]->begin());
             inputTensorMap.add(inputName.c_str(), inputs[j].get());
         }
     }
@@ -139,7 +155,7 @@ std::tuple<zdl::DlSystem::TensorMap, bool> loadMultipleInput (std::unique_ptr<zd
     return std::make_tuple(inputTensorMap, true);
 }
 
-bool loadInputUserBufferTfN(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+bool loadInputUserBufferTfN(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                          std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                          std::vector<std::string>& fileLines,
                          zdl::DlSystem::UserBufferMap& inputMap,
@@ -219,7 +235,7 @@ bool loadInputUserBufferTfN(std::unordered_map<std::string, std::vector<uint8_t>
 }
 
 // Load multiple batched input user buffers
-bool loadInputUserBufferFloat(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+bool loadInputUserBufferFloat(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                          std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                          std::vector<std::string>& fileLines)
 {
@@ -276,6 +292,166 @@ bool loadInputUserBufferFloat(std::unordered_map<std::string, std::vector<uint8_
     return true;
 }
 
+// Preprocess one camera frame file per input per line into the input user buffers
+bool loadInputUserBufferCamera(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
+                               std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                               std::vector<std::string>& fileLines,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               const CameraInput& camera,
+                               bool isTfNBuffer,
+                               bool staticQuantization,
+                               int bitWidth,
+                               PreprocessTimes& times)
+{
+    // get input tensor names of the network that need to be populated
+    const auto& inputNamesOpt = snpe->getInputTensorNames();
+    if (!inputNamesOpt) throw std::runtime_error("Error obtaining input tensor names");
+    const zdl::DlSystem::StringList& inputNames = *inputNamesOpt;
+    assert(inputNames.size() > 0);
+
+    // a TfN buffer is quantized from a float image of one line
+    static thread_local std::vector<float> image;
+    const size_t elementSize = isTfNBuffer ? static_cast<size_t>(bitWidth / 8) : sizeof(float);
+
+    std::cout << "Preprocessing camera frames: " << std::endl;
+
+    for (size_t i = 0; i < fileLines.size(); i++) {
+        // treat each line as a space-separated list of frame files, or of <inputname>:=<filepath>
+        std::vector<std::string> filePaths;
+        split(filePaths, fileLines[i], ' ');
+        std::unordered_map<std::string, std::string> nameToFilePathMap;
+        if (fileLines[i].find(":=") != std::string::npos) {
+            for (auto &line : filePaths) {
+                std::vector<std::string> lineContents;
+                split(lineContents, line, '=');
+                std::string name = lineContents[0];
+                name.erase(name.length()-1);
+                nameToFilePathMap.emplace(name, lineContents[1]);
+            }
+        }
+
+        for (size_t j = 0; j < inputNames.size(); j++) {
+            const char *name = inputNames.at(j);
+            if (nameToFilePathMap.find(name) == nameToFilePathMap.end() && j >= filePaths.size()) {
+                std::cerr << "No input file for " << name << "\n";
+                return false;
+            }
+            std::string filePath(nameToFilePathMap.find(name) != nameToFilePathMap.end() ? nameToFilePathMap.at(name) : filePaths[j]);
+            std::cout << "\t" << j + 1 << ") " << filePath << std::endl;
+
+            // the input has to be an image: [batch,] height, width, 3 channels
+            const zdl::DlSystem::TensorShape shape = *snpe->getInputDimensions(name);
+            const size_t rank = shape.rank();
+            if (rank < 3 || shape[rank - 1] != 3) {
+                std::cerr << "Input " << name << " is not an NHWC image with 3 channels.\n";
+                return false;
+            }
+            const size_t height = shape[rank - 3], width = shape[rank - 2], elements = height * width * 3;
+            ApplicationBuffer& buffer = applicationBuffers.at(name);
+            if (buffer.size() < (i + 1) * elements * elementSize) {
+                std::cerr << "Input user buffer of " << name << " is too small for " << i + 1 << " images.\n";
+                return false;
+            }
+
+            MappedFile file(filePath);
+            if (!file.valid()) return false;
+            YuvFrame frame = camera.format;
+            frame.data = file.data();
+            if (file.size() != YuvFrameBytes(frame.width, frame.height)) {
+                std::cerr << "Size of camera frame does not match " << frame.width << "x" << frame.height << ".\n"
+                          << "Expecting: " << YuvFrameBytes(frame.width, frame.height) << " bytes\n"
+                          << "Got: " << file.size() << " bytes\n";
+                return false;
+            }
+
+            if (!isTfNBuffer) {
+                float* dst = reinterpret_cast<float*>(buffer.data()) + i * elements;
+                if (!PreprocessYuvFrame(frame, width, height, camera.norm, dst, &times)) return false;
+                continue;
+            }
+            image.resize(elements);
+            if (!PreprocessYuvFrame(frame, width, height, camera.norm, image.data(), &times)) return false;
+            const auto start = std::chrono::steady_clock::now();
+            auto userBufferEncoding = dynamic_cast<zdl::DlSystem::UserBufferEncodingTfN *>(&inputMap.getUserBuffer(name)->getEncoding());
+            unsigned char stepEquivalentTo0 = staticQuantization ? userBufferEncoding->getStepExactly0() : 0;
+            float quantizedStepSize = staticQuantization ? userBufferEncoding->getQuantizedStepSize() : 0.0f;
+            if (!FloatToTfN(buffer.data() + i * elements * elementSize, stepEquivalentTo0, quantizedStepSize,
+                            staticQuantization, image.data(), elements, bitWidth))
+                return false;
+            if (!staticQuantization) {
+                userBufferEncoding->setStepExactly0(stepEquivalentTo0);
+                userBufferEncoding->setQuantizedStepSize(quantizedStepSize);
+            }
+            times.normalizeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    return true;
+}
+
+// Point the float input user buffers of a one-file batch straight at the mapped input files
+bool bindInputUserBufferMapped(std::vector<MappedFile>& mappedFiles,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                               std::vector<std::string>& fileLines)
+{
+    // get input tensor names of the network that need to be populated
+    const auto& inputNamesOpt = snpe->getInputTensorNames();
+    if (!inputNamesOpt) throw std::runtime_error("Error obtaining input tensor names");
+    const zdl::DlSystem::StringList& inputNames = *inputNamesOpt;
+    assert(inputNames.size() > 0);
+
+    // a batch of several files has to be contiguous, which only a copy can make it
+    if (fileLines.size() != 1) {
+        std::cerr << "Mapped input files need a batch size of 1, got " << fileLines.size() << " files per batch.\n";
+        return false;
+    }
+
+    std::cout << "Mapping DNN Input: " << std::endl;
+
+    // treat the line as a space-separated list of input files, or of <inputname>:=<filepath>
+    std::vector<std::string> filePaths;
+    split(filePaths, fileLines[0], ' ');
+    std::unordered_map<std::string, std::string> nameToFilePathMap;
+    if (fileLines[0].find(":=") != std::string::npos) {
+        for (auto &line : filePaths) {
+            std::vector<std::string> lineContents;
+            split(lineContents, line, '=');
+            std::string name = lineContents[0];
+            name.erase(name.length()-1);
+            nameToFilePathMap.emplace(name, lineContents[1]);
+        }
+    }
+
+    // the previous batch's files stay mapped until their buffers are rebound below
+    std::vector<MappedFile> files;
+    for (size_t j = 0; j < inputNames.size(); j++) {
+        const char *name = inputNames.at(j);
+        if (nameToFilePathMap.find(name) == nameToFilePathMap.end() && j >= filePaths.size()) {
+            std::cerr << "No input file for " << name << "\n";
+            return false;
+        }
+        std::string filePath(nameToFilePathMap.find(name) != nameToFilePathMap.end() ? nameToFilePathMap.at(name) : filePaths[j]);
+        std::cout << "\t" << j + 1 << ") " << filePath << std::endl;
+
+        MappedFile file(filePath);
+        if (!file.valid()) return false;
+        zdl::DlSystem::IUserBuffer* buffer = inputMap.getUserBuffer(name);
+        if (buffer == nullptr || file.size() != buffer->getSize()) {
+            std::cerr << "Size of input does not match network.\n"
+                      << "Expecting: " << (buffer ? buffer->getSize() : 0) << " bytes\n"
+                      << "Got: " << file.size() << " bytes\n";
+            return false;
+        }
+        if (!buffer->setBufferAddress(file.data())) {
+            std::cerr << "Failed to bind the user buffer of " << name << " to " << filePath << "\n";
+            return false;
+        }
+        files.push_back(std::move(file));
+    }
+    mappedFiles.swap(files);
+    return true;
+}
+
 void loadInputUserBuffer(std::unordered_map<std::string, GLuint>& applicationBuffers,
                                std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                                const GLuint inputglbuffer)
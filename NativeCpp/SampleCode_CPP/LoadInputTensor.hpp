@@ -16,6 +16,9 @@
 #include "SNPE/SNPE.hpp"
 #include "DlSystem/ITensorFactory.hpp"
 #include "DlSystem/TensorMap.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+#include "Util.hpp"
+#include "YuvPreprocess.hpp"
 
 typedef unsigned int GLuint;
 std::unique_ptr<zdl::DlSystem::ITensor> loadInputTensor (std::unique_ptr<zdl::SNPE::SNPE>& snpe,
@@ -27,11 +30,11 @@ std::tuple<zdl::DlSystem::TensorMap, bool> loadMultipleInput (std::unique_ptr<zd
                                                                 const zdl::DlSystem::StringList& inputTensorNames,
                                                                 std::vector<std::unique_ptr<zdl::DlSystem::ITensor>>& inputs);
 
-bool loadInputUserBufferFloat(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+bool loadInputUserBufferFloat(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                                 std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                                 std::vector<std::string>& fileLines);
 
-bool loadInputUserBufferTfN(std::unordered_map<std::string, std::vector<uint8_t>>& applicationBuffers,
+bool loadInputUserBufferTfN(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
                          std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                          std::vector<std::string>& fileLines,
                          zdl::DlSystem::UserBufferMap& inputMap,
@@ -39,6 +42,37 @@ bool loadInputUserBufferTfN(std::unordered_map<std::string, std::vector<uint8_t>
                          int bitWidth,
                          bool useNativeInputFiles=false);
 
+// Zero-copy alternative to loadInputUserBufferFloat for a batch of one file line: maps
+// every input file and points the input's user buffer at the mapping instead of copying
+// into application storage. The mappings are kept in mappedFiles, replacing the previous
+// batch's, so the buffers stay valid until the next call; call it only once the previous
+// execute() has returned. Fails if a file's size is not the buffer's.
+// Camera frames in place of input files: the size and layout of the frame files and the
+// normalization the network takes
+struct CameraInput
+{
+    YuvFrame format;
+    PixelNormalization norm;
+};
+
+// Preprocess the camera frame files of a batch into the input user buffers, every input
+// being an NHWC RGB image; TF8 / TF16 buffers get the quantized image. Adds the stage times
+// to times, quantization counting as normalization.
+bool loadInputUserBufferCamera(std::unordered_map<std::string, ApplicationBuffer>& applicationBuffers,
+                               std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                               std::vector<std::string>& fileLines,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               const CameraInput& camera,
+                               bool isTfNBuffer,
+                               bool staticQuantization,
+                               int bitWidth,
+                               PreprocessTimes& times);
+
+bool bindInputUserBufferMapped(std::vector<MappedFile>& mappedFiles,
+                               zdl::DlSystem::UserBufferMap& inputMap,
+                               std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                               std::vector<std::string>& fileLines);
+
 void loadInputUserBuffer(std::unordered_map<std::string, GLuint>& applicationBuffers,
                                 std::unique_ptr<zdl::SNPE::SNPE>& snpe,
                                 const GLuint inputglbuffer);
@@ -0,0 +1,147 @@
+// OutputWriter.cpp – Result_N/ tree or packed results file, written by a thread pool
+#include "OutputWriter.hpp"
+
+#include <iostream>
+#include <sstream>
+
+#include "Util.hpp"
+
+namespace
+{
+const char kPackMagic[8]  = {'S', 'N', 'P', 'E', 'P', 'A', 'C', 'K'};
+const char kIndexMagic[8] = {'S', 'N', 'P', 'E', 'I', 'D', 'X', '1'};
+const size_t kMaxQueuedBytes = 64u << 20;    // results waiting for the pool at most
+
+void putLe(std::string& out, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+}
+
+OutputWriter::OutputWriter(const std::string& outputDir, size_t threads, bool packed)
+    : m_dir(outputDir), m_packed(packed)
+{
+    if (m_packed)
+    {
+        const std::string path = m_dir + "/results.pack";
+        if (!EnsureDirectory(m_dir))
+        {
+            std::cerr << "Failed to create output directory: " << m_dir << "\n";
+            m_failed = true;
+            return;
+        }
+        m_pack.open(path, std::ofstream::binary | std::ofstream::trunc);
+        if (!m_pack || !m_pack.write(kPackMagic, sizeof(kPackMagic)))
+        {
+            std::cerr << "Failed to open output file for writing: " << path << "\n";
+            m_failed = true;
+            return;
+        }
+        m_packEnd = sizeof(kPackMagic);
+    }
+    for (size_t i = 0; i < threads; ++i)
+        m_threads.emplace_back(&OutputWriter::run, this);
+}
+
+OutputWriter::~OutputWriter()
+{
+    finish();
+}
+
+bool OutputWriter::write(size_t result, const std::string& name, std::vector<uint8_t>&& data)
+{
+    if (m_threads.empty())
+    {
+        Job job{result, name, std::move(data)};
+        if (m_failed || !store(job)) m_failed = true;
+        return !m_failed;
+    }
+    std::unique_lock<std::mutex> lock(m_m);
+    m_cv.wait(lock, [&] { return m_failed || m_jobs.empty() || m_queuedBytes < kMaxQueuedBytes; });
+    if (m_failed) return false;
+    m_queuedBytes += data.size();
+    m_jobs.push_back(Job{result, name, std::move(data)});
+    m_cv.notify_all();
+    return true;
+}
+
+bool OutputWriter::store(const Job& job)
+{
+    if (!m_packed)
+    {
+        std::ostringstream path;
+        path << m_dir << "/Result_" << job.result << "/" << job.name << ".raw";
+        return SaveRawFile(path.str(), job.data.data(), job.data.size());
+    }
+    std::lock_guard<std::mutex> lock(m_packMutex);
+    if (!m_pack.write(reinterpret_cast<const char*>(job.data.data()), static_cast<std::streamsize>(job.data.size())))
+    {
+        std::cerr << "Failed to write data to: " << m_dir << "/results.pack\n";
+        return false;
+    }
+    m_index.push_back(IndexEntry{job.result, m_packEnd, job.data.size(), job.name});
+    m_packEnd += job.data.size();
+    return true;
+}
+
+void OutputWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_m);
+    for (;;)
+    {
+        m_cv.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+        if (m_jobs.empty()) return;
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        ++m_active;
+        lock.unlock();
+        const bool ok = store(job);
+        lock.lock();
+        --m_active;
+        m_queuedBytes -= job.data.size();
+        if (!ok)
+        {
+            m_failed = true;
+            for (const auto& j : m_jobs) m_queuedBytes -= j.data.size();
+            m_jobs.clear();
+        }
+        m_cv.notify_all();
+    }
+}
+
+bool OutputWriter::finish()
+{
+    if (m_finished) return !m_failed;
+    m_finished = true;
+    {
+        std::unique_lock<std::mutex> lock(m_m);
+        m_cv.wait(lock, [&] { return m_jobs.empty() && m_active == 0; });
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& t : m_threads) t.join();
+    m_threads.clear();
+
+    if (m_packed && m_pack.is_open())
+    {
+        std::string index;
+        for (const auto& e : m_index)
+        {
+            putLe(index, e.result, 8);
+            putLe(index, e.offset, 8);
+            putLe(index, e.bytes, 8);
+            putLe(index, e.name.size(), 4);
+            index += e.name;
+        }
+        putLe(index, m_packEnd, 8);
+        putLe(index, m_index.size(), 8);
+        index.append(kIndexMagic, sizeof(kIndexMagic));
+        if (!m_pack.write(index.data(), static_cast<std::streamsize>(index.size())) || !m_pack.flush())
+        {
+            std::cerr << "Failed to write the index of: " << m_dir << "/results.pack\n";
+            m_failed = true;
+        }
+        m_pack.close();
+    }
+    return !m_failed;
+}
@@ -0,0 +1,77 @@
+// OutputWriter.hpp – where snpe-sample's results go, and the threads that write them
+#ifndef OUTPUTWRITER_H
+#define OUTPUTWRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Results are written either one file each, as <outputDir>/Result_<N>/<name>.raw, or all
+// into the single packed file <outputDir>/results.pack:
+//
+//   "SNPEPACK"                                8-byte magic
+//   data of every result                      in the order they were written
+//   index, per result:                        uint64 N, uint64 offset, uint64 bytes,
+//                                             uint32 name length, name (no terminator)
+//   uint64 index offset, uint64 results, "SNPEIDX1"    24-byte trailer
+//
+// Integers are little-endian; a reader seeks to the trailer, then to the index. The index
+// is written by finish(), so a pack without a trailer is from a run that did not end.
+//
+// With threads > 0, write() only queues the bytes and a pool of threads stores them, so
+// the caller's buffers are free again at once. Queued bytes are bounded; write() blocks
+// while the pool is that far behind. With 0 threads every write happens in write().
+class OutputWriter
+{
+public:
+    OutputWriter(const std::string& outputDir, size_t threads, bool packed);
+    ~OutputWriter();
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    // Store the bytes of output name of result N. False once any write has failed.
+    bool write(size_t result, const std::string& name, std::vector<uint8_t>&& data);
+    // Wait for the queued writes and close the pack with its index. False if any failed.
+    bool finish();
+
+private:
+    struct Job
+    {
+        size_t result;
+        std::string name;
+        std::vector<uint8_t> data;
+    };
+    struct IndexEntry
+    {
+        uint64_t result, offset, bytes;
+        std::string name;
+    };
+
+    bool store(const Job& job);
+    void run();
+
+    std::string m_dir;
+    bool m_packed;
+
+    std::mutex m_packMutex;                  // the pack is appended to by one thread at a time
+    std::ofstream m_pack;
+    uint64_t m_packEnd = 0;
+    std::vector<IndexEntry> m_index;
+
+    std::mutex m_m;
+    std::condition_variable m_cv;
+    std::deque<Job> m_jobs;
+    size_t m_queuedBytes = 0;
+    size_t m_active = 0;                     // jobs being stored right now
+    bool m_stop = false;
+    bool m_failed = false;
+    bool m_finished = false;
+    std::vector<std::thread> m_threads;
+};
+
+#endif
@@ -0,0 +1,202 @@
+// Pipeline.cpp – load / execute / save pipeline over recycled user-buffer sets
+#include "Pipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "CreateUserBuffer.hpp"
+#include "LoadInputTensor.hpp"
+#include "SaveOutputTensor.hpp"
+#include "DlSystem/IUserBuffer.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+
+namespace
+{
+// One set of user buffers: the application storage and the SNPE buffers on top of it.
+struct BufferSet
+{
+    std::unordered_map<std::string, ApplicationBuffer> application;
+    std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> snpeBuffers;
+    zdl::DlSystem::UserBufferMap map;
+    std::vector<MappedFile> mapped;     // input files the buffers point into (mapInputs)
+};
+
+// Blocking FIFO between two stages. close() aborts the pipeline: every pop() fails from
+// then on, whatever is still queued.
+template<typename T>
+class StageQueue
+{
+public:
+    void push(const T& v)
+    {
+        { std::lock_guard<std::mutex> lock(m_m); m_q.push_back(v); }
+        m_cv.notify_one();
+    }
+    bool pop(T& v)
+    {
+        std::unique_lock<std::mutex> lock(m_m);
+        m_cv.wait(lock, [&] { return m_closed || !m_q.empty(); });
+        if (m_closed) return false;
+        v = m_q.front();
+        m_q.pop_front();
+        return true;
+    }
+    void close()
+    {
+        { std::lock_guard<std::mutex> lock(m_m); m_closed = true; }
+        m_cv.notify_all();
+    }
+private:
+    std::mutex m_m;
+    std::condition_variable m_cv;
+    std::deque<T> m_q;
+    bool m_closed = false;
+};
+
+// An executed output set on its way to the writer.
+struct Executed
+{
+    size_t set;
+    bool ok;
+};
+
+double msSince(std::chrono::steady_clock::time_point t)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count();
+}
+}
+
+void printExecUtilization(const char* mode, const ExecStats& stats)
+{
+    if (stats.runs == 0 || stats.wallMs <= 0.0) return;
+    std::cout << mode << ": " << stats.runs << " executions, execute busy "
+              << 100.0 * stats.execMs / stats.wallMs << "% of " << stats.wallMs << " ms wall time ("
+              << stats.execMs / stats.runs << " ms per execution), "
+              << 1000.0 * stats.images / stats.wallMs << " images/s" << std::endl;
+    if (stats.loadMs > 0.0)
+        std::cout << "  loading inputs took " << stats.loadMs << " ms, "
+                  << 1000.0 * stats.images / stats.loadMs << " inputs/s" << std::endl;
+    if (stats.prep.frames > 0)
+        std::cout << "  preprocessing " << stats.prep.frames << " camera frames: convert "
+                  << stats.prep.convertMs / stats.prep.frames << " ms, resize "
+                  << stats.prep.resizeMs / stats.prep.frames << " ms, normalize "
+                  << stats.prep.normalizeMs / stats.prep.frames << " ms per frame" << std::endl;
+    if (stats.saveMs > 0.0)
+        std::cout << "  writer busy " << stats.saveMs << " ms; execution waited " << stats.inWaitMs
+                  << " ms for inputs, " << stats.outWaitMs << " ms for output sets" << std::endl;
+}
+
+bool executePipelined(std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                      std::vector<std::vector<std::string>>& inputs,
+                      OutputWriter& writer,
+                      size_t batchSize,
+                      bool isTfNBuffer,
+                      bool staticQuantization,
+                      int bitWidth,
+                      bool useNativeInputFiles,
+                      bool mapInputs,
+                      const InputPack* pack,
+                      const CameraInput* camera,
+                      UserBufferArena* arena,
+                      size_t depth,
+                      ExecStats& stats)
+{
+    depth = std::max<size_t>(depth, 1);
+    std::vector<BufferSet> in(depth), out(depth);
+    for (size_t k = 0; k < depth; ++k)
+    {
+        createInputBufferMap(in[k].map, in[k].application, in[k].snpeBuffers, snpe, isTfNBuffer, staticQuantization, bitWidth, arena);
+        createOutputBufferMap(out[k].map, out[k].application, out[k].snpeBuffers, snpe, isTfNBuffer, bitWidth, arena);
+    }
+
+    // Sets travel free -> loaded -> executed -> free; batches stay in order because every
+    // stage is a single thread taking its queue in FIFO order.
+    StageQueue<size_t> freeIn, loaded, freeOut;
+    StageQueue<Executed> executed;
+    for (size_t k = 0; k < depth; ++k)
+    {
+        freeIn.push(k);
+        freeOut.push(k);
+    }
+    std::atomic<bool> failed(false);
+    auto abort = [&]
+    {
+        failed = true;
+        freeIn.close(); loaded.close(); freeOut.close(); executed.close();
+    };
+    const size_t n = inputs.size();
+    double loadMs = 0.0, saveMs = 0.0;
+    PreprocessTimes prep;
+
+    std::thread loader([&]
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t k;
+            if (!freeIn.pop(k)) return;
+            const auto start = std::chrono::steady_clock::now();
+            BufferSet& set = in[k];
+            bool ok = camera ? loadInputUserBufferCamera(set.application, snpe, inputs[i], set.map, *camera, isTfNBuffer, staticQuantization, bitWidth, prep)
+                    : pack ? loadInputUserBufferPacked(*pack, set.application, set.map, inputs[i], isTfNBuffer)
+                    : isTfNBuffer
+                    ? loadInputUserBufferTfN(set.application, snpe, inputs[i], set.map, staticQuantization, bitWidth, useNativeInputFiles)
+                    : mapInputs ? bindInputUserBufferMapped(set.mapped, set.map, snpe, inputs[i])
+                    : loadInputUserBufferFloat(set.application, snpe, inputs[i]);
+            loadMs += msSince(start);
+            if (!ok) { abort(); return; }
+            loaded.push(k);
+        }
+    });
+
+    std::thread saver([&]
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Executed e;
+            if (!executed.pop(e)) return;
+            const auto start = std::chrono::steady_clock::now();
+            // Save the execution results only if successful
+            if (e.ok && !saveOutput(out[e.set].map, out[e.set].application, writer, i * batchSize, batchSize, isTfNBuffer, bitWidth))
+            {
+                abort();
+                return;
+            }
+            saveMs += msSince(start);
+            freeOut.push(e.set);
+        }
+    });
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t k, o;
+        auto wait = std::chrono::steady_clock::now();
+        if (!loaded.pop(k)) break;
+        stats.inWaitMs += msSince(wait);
+        wait = std::chrono::steady_clock::now();
+        if (!freeOut.pop(o)) break;
+        stats.outWaitMs += msSince(wait);
+        if (batchSize > 1)
+            std::cout << "Batch " << i << ":" << std::endl;
+        bool execStatus;
+        {
+            ExecTimer timer(stats);
+            execStatus = snpe->execute(in[k].map, out[o].map);
+        }
+        freeIn.push(k);
+        executed.push({o, execStatus});
+        if (!execStatus)
+            std::cerr << "Error while executing the network." << std::endl;
+    }
+    loader.join();
+    saver.join();
+    stats.loadMs += loadMs;
+    stats.prep += prep;
+    stats.saveMs += saveMs;
+    return !failed;
+}
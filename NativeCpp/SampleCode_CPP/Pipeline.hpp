@@ -0,0 +1,76 @@
+// Pipeline.hpp – load / execute / save pipeline over recycled user-buffer sets
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "InputPack.hpp"
+#include "LoadInputTensor.hpp"
+#include "OutputWriter.hpp"
+#include "UserBufferArena.hpp"
+#include "SNPE/SNPE.hpp"
+
+// Time spent inside execute() versus the wall time of the whole batch loop (set by the caller).
+// images counts input files, without the padding of a short last batch. Loading the user
+// buffers is timed too, with the stages of preprocessing camera frames; the pipeline adds the
+// busy time of its writer thread and how long execution waited for its loader and writer.
+struct ExecStats
+{
+    double wallMs  = 0.0;
+    double execMs  = 0.0;
+    size_t runs    = 0;
+    size_t images  = 0;
+    double loadMs  = 0.0;    // loading inputs (the loader thread of the pipeline)
+    PreprocessTimes prep;    // the part of loading that preprocessed camera frames
+    double saveMs  = 0.0;    // writer thread, writing output sets
+    double inWaitMs  = 0.0;  // execution waiting for a loaded input set
+    double outWaitMs = 0.0;  // execution waiting for a written-out output set
+};
+
+// Adds the duration of one execute() call to the stats on destruction.
+class ExecTimer
+{
+public:
+    explicit ExecTimer(ExecStats& stats) : m_stats(stats), m_start(std::chrono::steady_clock::now()) {}
+    ~ExecTimer()
+    {
+        m_stats.execMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        m_stats.runs++;
+    }
+private:
+    ExecStats& m_stats;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Print the share of the wall time the runtime spent executing and the images per second.
+void printExecUtilization(const char* mode, const ExecStats& stats);
+
+// Run every batch of inputs through the network in three stages over depth input and
+// depth output user-buffer sets: a loader thread fills free input sets and queues them,
+// the calling thread executes them in order, and a writer thread hands the executed
+// output sets to writer. Every set goes back to its free list once consumed, so at most
+// depth batches are loaded ahead and depth executed batches wait for the writer. With
+// mapInputs the loader points the float input set at the mapped input files instead
+// of copying them (batch size 1 only); with a pack it loads every batch from the pack,
+// with camera it preprocesses the batch's frame files into the input set. With an arena,
+// sized for depth sets, every set's buffers are allocated from it.
+// Adds every execute() and the stage times to stats. Returns false on the first load or
+// save failure.
+bool executePipelined(std::unique_ptr<zdl::SNPE::SNPE>& snpe,
+                      std::vector<std::vector<std::string>>& inputs,
+                      OutputWriter& writer,
+                      size_t batchSize,
+                      bool isTfNBuffer,
+                      bool staticQuantization,
+                      int bitWidth,
+                      bool useNativeInputFiles,
+                      bool mapInputs,
+                      const InputPack* pack,
+                      const CameraInput* camera,
+                      UserBufferArena* arena,
+                      size_t depth,
+                      ExecStats& stats);
+
+#endif
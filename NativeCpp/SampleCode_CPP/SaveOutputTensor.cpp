@@ -53,23 +53,31 @@ bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
                  const std::string& outputDir,
                  int num,
                  size_t batchSize)
+{
+    OutputWriter writer(outputDir, 0, false);
+    return saveOutput(outputTensorMap, writer, num, batchSize) && writer.finish();
+}
+
+bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
+                 OutputWriter& writer,
+                 int num,
+                 size_t batchSize)
 {
     // Get all output tensor names from the network
     zdl::DlSystem::StringList tensorNames = outputTensorMap.getTensorNames();
 
-    // Iterate through the output Tensor map, and print each output layer name to a raw file
+    // Iterate through the output Tensor map, and hand each output layer of each batch element to the writer
     for( auto& name : tensorNames)
     {
+        auto tensorPtr = outputTensorMap.getTensor(name);
+        size_t batchChunk = tensorPtr->getSize() / batchSize;
+
         // Split the batched output tensor and save the results
         for(size_t i=0; i<batchSize; i++) {
-            std::ostringstream path;
-            path << outputDir << "/"
-                 << "Result_" << num + i << "/"
-                 << ToLegalFilename(name) << ".raw";
-            auto tensorPtr = outputTensorMap.getTensor(name);
-            size_t batchChunk = tensorPtr->getSize() / batchSize;
-
-            if(!SaveITensorBatched(path.str(), tensorPtr, i, batchChunk))
+            std::vector<uint8_t> data(batchChunk * sizeof(float));
+            std::copy(tensorPtr->cbegin() + i * batchChunk, tensorPtr->cbegin() + (i+1) * batchChunk,
+                      reinterpret_cast<float*>(data.data()));
+            if(!writer.write(num + i, ToLegalFilename(name), std::move(data)))
             {
                 return false;
             }
@@ -80,55 +88,62 @@ bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
 
 // Execute the network on an input user buffer map and print results to raw files
 bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
-                 std::unordered_map<std::string,std::vector<uint8_t>>& applicationOutputBuffers,
+                 std::unordered_map<std::string, ApplicationBuffer>& applicationOutputBuffers,
                  const std::string& outputDir,
                  int num,
                  size_t batchSize,
                  bool isTfNBuffer,
                  int bitWidth)
+{
+    OutputWriter writer(outputDir, 0, false);
+    return saveOutput(outputMap, applicationOutputBuffers, writer, num, batchSize, isTfNBuffer, bitWidth) && writer.finish();
+}
+
+bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
+                 std::unordered_map<std::string, ApplicationBuffer>& applicationOutputBuffers,
+                 OutputWriter& writer,
+                 int num,
+                 size_t batchSize,
+                 bool isTfNBuffer,
+                 int bitWidth)
 {
    // Get all output buffer names from the network
    const zdl::DlSystem::StringList& outputBufferNames = outputMap.getUserBufferNames();
 
    int elementSize = bitWidth / 8;
 
-   // Iterate through output buffers and print each output to a raw file
+   // Iterate through output buffers and hand each output of each batch element to the writer
    for(auto& name : outputBufferNames)
    {
+       auto bufferPtr = outputMap.getUserBuffer(name);
+       const ApplicationBuffer& buffer = applicationOutputBuffers.at(name);
+       size_t batchChunk = bufferPtr->getSize() / batchSize;
+       size_t dataChunk = bufferPtr->getOutputSize() / batchSize;
+       if(batchChunk != dataChunk) {
+          std::cout << "\tUserBuffer size is " << bufferPtr->getSize() << " bytes, but "
+                                             << bufferPtr->getOutputSize() << " bytes of data was found." << std::endl;
+          if( dataChunk > batchChunk )
+             std::cout << "\tAssign a larger buffer using a bigger -z argument" << std::endl;
+          batchChunk = std::min(batchChunk,dataChunk);
+       }
        for(size_t i=0; i<batchSize; i++) {
-           std::ostringstream path;
-           path << outputDir << "/"
-                << "Result_" << num + i << "/"
-                << ToLegalFilename(name) << ".raw";
-           auto bufferPtr = outputMap.getUserBuffer(name);
-           size_t batchChunk = bufferPtr->getSize() / batchSize;
-           size_t dataChunk = bufferPtr->getOutputSize() / batchSize;
-           if(batchChunk != dataChunk) {
-              std::cout << "\tUserBuffer size is " << bufferPtr->getSize() << " bytes, but "
-                                                 << bufferPtr->getOutputSize() << " bytes of data was found." << std::endl;
-              if( dataChunk > batchChunk )
-                 std::cout << "\tAssign a larger buffer using a bigger -z argument" << std::endl;
-              batchChunk = std::min(batchChunk,dataChunk);
-           }
+           std::vector<uint8_t> data;
            if (isTfNBuffer)
            {
-              std::vector<uint8_t> output;
-              zdl::DlSystem::UserBufferEncodingTfN ubetfN = dynamic_cast<zdl::DlSystem::UserBufferEncodingTfN &>(outputMap.getUserBuffer(name)->getEncoding());
-              output.resize(applicationOutputBuffers.at(name).size() * sizeof(float) / elementSize);
-              TfNToFloat(reinterpret_cast<float *>(&output[0]),applicationOutputBuffers.at(name).data(),
-                         ubetfN.getStepExactly0(),ubetfN.getQuantizedStepSize(),
-                        applicationOutputBuffers.at(name).size() / elementSize, bitWidth);
-              if(!SaveUserBufferBatched(path.str(), output, i, batchChunk * sizeof(float) / elementSize))
-              {
-                  return false;
-              }
+              // Dequantize just this batch element's chunk
+              zdl::DlSystem::UserBufferEncodingTfN ubetfN = dynamic_cast<zdl::DlSystem::UserBufferEncodingTfN &>(bufferPtr->getEncoding());
+              const size_t elements = batchChunk / elementSize;
+              data.resize(elements * sizeof(float));
+              TfNToFloat(reinterpret_cast<float *>(data.data()), const_cast<uint8_t*>(buffer.data()) + i * elements * elementSize,
+                         ubetfN.getStepExactly0(), ubetfN.getQuantizedStepSize(), elements, bitWidth);
            }
            else
            {
-              if(!SaveUserBufferBatched(path.str(), applicationOutputBuffers.at(name), i, batchChunk))
-              {
-                  return false;
-              }
+              data.assign(buffer.begin() + i * batchChunk, buffer.begin() + (i+1) * batchChunk);
+           }
+           if(!writer.write(num + i, ToLegalFilename(name), std::move(data)))
+           {
+               return false;
            }
        }
    }
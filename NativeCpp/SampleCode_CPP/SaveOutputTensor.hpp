@@ -16,6 +16,8 @@
 #include "SNPE/SNPE.hpp"
 #include "DlSystem/ITensor.hpp"
 #include "DlSystem/UserBufferMap.hpp"
+#include "UserBufferArena.hpp"
+#include "OutputWriter.hpp"
 
 // Save output implementation of ITensor
 bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
@@ -25,13 +27,28 @@ bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
 
 // Save output USERBUFFER
 bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
-                 std::unordered_map<std::string,std::vector<uint8_t>>& applicationOutputBuffers,
+                 std::unordered_map<std::string, ApplicationBuffer>& applicationOutputBuffers,
                  const std::string& outputDir,
                  int num,
                  size_t batchSize,
                  bool isTfNBuffer,
                  int bitWidth);
 
+// The same, handing every result of the batch to writer instead of writing it into
+// outputDir. The outputs are copied out first, so the buffers can be reused on return.
+bool saveOutput (zdl::DlSystem::TensorMap outputTensorMap,
+                 OutputWriter& writer,
+                 int num,
+                 size_t batchSize=1);
+
+bool saveOutput (zdl::DlSystem::UserBufferMap& outputMap,
+                 std::unordered_map<std::string, ApplicationBuffer>& applicationOutputBuffers,
+                 OutputWriter& writer,
+                 int num,
+                 size_t batchSize,
+                 bool isTfNBuffer,
+                 int bitWidth);
+
 
 
 #endif
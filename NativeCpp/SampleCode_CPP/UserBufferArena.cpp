@@ -0,0 +1,90 @@
+// UserBufferArena.cpp – one aligned block holding every application buffer of a model
+#include "UserBufferArena.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#else
+#include <Windows.h>
+#endif
+
+namespace
+{
+const size_t kPageBytes = 4096;
+const size_t kHugePageBytes = size_t(2) << 20;
+
+size_t roundUp(size_t n, size_t to) { return (n + to - 1) / to * to; }
+}
+
+UserBufferArena::UserBufferArena(size_t capacity, bool hugePages)
+{
+    if (capacity == 0) return;
+#ifdef _WIN32
+    // Large pages need SeLockMemoryPrivilege; normal pages are what a sample can count on
+    m_mapped = roundUp(capacity, kPageBytes);
+    m_base = static_cast<uint8_t*>(VirtualAlloc(NULL, m_mapped, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    if (m_base) m_pageKind = "4 KiB";
+    (void)hugePages;
+#else
+    void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (hugePages)
+    {
+        m_mapped = roundUp(capacity, kHugePageBytes);
+        p = mmap(nullptr, m_mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) m_pageKind = "2 MiB hugetlb";
+    }
+#endif
+    if (p == MAP_FAILED)
+    {
+        m_mapped = roundUp(capacity, hugePages ? kHugePageBytes : kPageBytes);
+        // Over-map by a huge page so the block can start on a huge page boundary
+        const size_t extra = hugePages ? kHugePageBytes : 0;
+        p = mmap(nullptr, m_mapped + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) { m_mapped = 0; return; }
+        uint8_t* start = static_cast<uint8_t*>(p);
+        if (extra)
+        {
+            uint8_t* aligned = reinterpret_cast<uint8_t*>(roundUp(reinterpret_cast<uintptr_t>(start), kHugePageBytes));
+            if (aligned > start) munmap(start, aligned - start);
+            munmap(aligned + m_mapped, start + extra - aligned);
+            p = aligned;
+        }
+        m_pageKind = "4 KiB";
+#ifdef MADV_HUGEPAGE
+        if (hugePages && madvise(p, m_mapped, MADV_HUGEPAGE) == 0) m_pageKind = "2 MiB transparent";
+#endif
+    }
+#endif
+    m_base = static_cast<uint8_t*>(p);
+    m_capacity = capacity;
+}
+
+UserBufferArena::~UserBufferArena()
+{
+    if (!m_base) return;
+#ifdef _WIN32
+    VirtualFree(m_base, 0, MEM_RELEASE);
+#else
+    munmap(m_base, m_mapped);
+#endif
+}
+
+void* UserBufferArena::allocate(size_t bytes)
+{
+    const size_t offset = roundUp(m_used, kAlignment);
+    if (!m_base || offset + bytes > m_capacity) return nullptr;
+    m_used = offset + bytes;
+    return m_base + offset;
+}
+
+void UserBufferArena::record(const std::string& name, const void* p, size_t bytes)
+{
+    m_slots.push_back({name, size_t(static_cast<const uint8_t*>(p) - m_base), bytes});
+}
+
+size_t UserBufferArena::bytesFor(const std::vector<size_t>& sizes)
+{
+    size_t bytes = 0;
+    for (size_t n : sizes) bytes += roundUp(n, kAlignment);     // in any order
+    return bytes;
+}
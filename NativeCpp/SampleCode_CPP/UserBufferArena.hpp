@@ -0,0 +1,115 @@
+// UserBufferArena.hpp – one aligned block holding every application buffer of a model
+#ifndef USERBUFFERARENA_H
+#define USERBUFFERARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The application buffers of a model, inputs and outputs of every buffer set, carved out
+// of one mapping in the order they are created: each starts on a kAlignment boundary, so
+// no two share a cache line, and the whole working set spans as few pages as it can. The
+// offsets depend only on the network's tensors, so they are the same on every run.
+// Nothing is ever freed; the block goes when the arena does, after the buffers' users.
+class UserBufferArena
+{
+public:
+    static const size_t kAlignment = 64;
+
+    struct Slot
+    {
+        std::string name;
+        size_t offset;
+        size_t bytes;
+    };
+
+    // Reserves capacity bytes. With hugePages the block is backed by 2 MiB pages: from the
+    // hugetlbfs pool if it has enough free, else transparent huge pages (madvise); normal
+    // pages when neither is granted, which pageKind() tells. Check valid() afterwards.
+    UserBufferArena(size_t capacity, bool hugePages);
+    ~UserBufferArena();
+    UserBufferArena(const UserBufferArena&) = delete;
+    UserBufferArena& operator=(const UserBufferArena&) = delete;
+
+    bool valid() const { return m_base != nullptr; }
+    // The next bytes at a kAlignment boundary; nullptr once the block is full.
+    void* allocate(size_t bytes);
+    // Continues at offset. Going back hands bytes out a second time, aliasing the buffers
+    // already there: only for buffers that are never in use at the same time.
+    void seek(size_t offset) { m_used = offset; }
+    // Names the allocation at p, for layout().
+    void record(const std::string& name, const void* p, size_t bytes);
+
+    uint8_t* data() const { return m_base; }
+    size_t capacity() const { return m_capacity; }
+    size_t used() const { return m_used; }
+    const char* pageKind() const { return m_pageKind; }
+    const std::vector<Slot>& layout() const { return m_slots; }
+
+    // Bytes an arena needs for buffers of these sizes, allocated in any order
+    static size_t bytesFor(const std::vector<size_t>& sizes);
+
+private:
+    uint8_t* m_base = nullptr;
+    size_t m_capacity = 0;
+    size_t m_mapped = 0;
+    size_t m_used = 0;
+    const char* m_pageKind = "none";
+    std::vector<Slot> m_slots;
+};
+
+// Allocator of the application buffers: from the arena it was made with, else from the
+// heap like std::allocator. Arena memory comes zeroed from the mapping, so elements are
+// default-initialized there instead of being written a second time; a copy of a buffer
+// goes to the heap.
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(UserBufferArena* arena) : m_arena(arena) {}
+    template<typename U> ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.arena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (!m_arena) return static_cast<T*>(::operator new(n * sizeof(T)));
+        void* p = m_arena->allocate(n * sizeof(T));
+        if (!p) throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t)
+    {
+        if (!m_arena) ::operator delete(p);
+    }
+
+    template<typename U> void construct(U* p)
+    {
+        if (m_arena) ::new(static_cast<void*>(p)) U;
+        else ::new(static_cast<void*>(p)) U();
+    }
+    template<typename U, typename... Args> void construct(U* p, Args&&... args)
+    {
+        ::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+    UserBufferArena* arena() const { return m_arena; }
+
+private:
+    UserBufferArena* m_arena = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena() == b.arena(); }
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena() != b.arena(); }
+
+// Storage of one application user buffer
+typedef std::vector<uint8_t, ArenaAllocator<uint8_t>> ApplicationBuffer;
+
+#endif
@@ -6,6 +6,7 @@
 //
 //==============================================================================
 
+#include <algorithm>
 #include <vector>
 #include <sstream>
 #include <cstring>
@@ -14,9 +15,15 @@
 #include <sys/stat.h>
 #include <cerrno>
 #include <limits>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
 
 #ifndef _WIN32
 #include <cmath>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #else
 #define NOMINMAX // std::min
 #define NOCRYPT
@@ -24,6 +31,21 @@
 #include <Windows.h>
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define TFN_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TFN_TARGET(isa)
+#else
+#include <cpuid.h>
+#define TFN_TARGET(isa) __attribute__((target(isa)))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define TFN_NEON
+#include <arm_neon.h>
+#endif
+
 #include "Util.hpp"
 
 #include "DlSystem/ITensorFactory.hpp"
@@ -36,7 +58,7 @@ add enum class: enum class DirMode
 add function: static enum class DirMode : uint32_t;
 add function: DirMode operator|(DirMode lhs, DirMode rhs);
 add function: static bool CreateDir(const std::string& path, DirMode dirmode);
-modified function: bool EnsureDirectory(const std::string& dir);
+modified function: static bool CreateDirectoryTree(const std::string& dir);
 */
 
 static enum class DirMode : uint32_t {
@@ -73,7 +95,7 @@ static bool CreateDir(const std::string& path, DirMode dirmode) {
   return false;
 }
 
-bool EnsureDirectory(const std::string& dir)
+static bool CreateDirectoryTree(const std::string& dir)
 {
     auto i = dir.find_last_of('/');
     std::string prefix = dir.substr(0, i);
@@ -112,7 +134,7 @@ bool EnsureDirectory(const std::string& dir)
     }
 }
 #else
-bool EnsureDirectory(const std::string& dir)
+static bool CreateDirectoryTree(const std::string& dir)
 {
    auto i = dir.find_last_of('/');
    std::string prefix = dir.substr(0, i);
@@ -144,6 +166,24 @@ bool EnsureDirectory(const std::string& dir)
    }
 }
 #endif
+
+// Directories known to exist. Thousands of Result_N/ outputs would otherwise cost a
+// mkdir() and a stat() per path level for every file written.
+static std::mutex knownDirsMutex;
+static std::unordered_set<std::string> knownDirs;
+
+bool EnsureDirectory(const std::string& dir)
+{
+   {
+      std::lock_guard<std::mutex> lock(knownDirsMutex);
+      if (knownDirs.count(dir)) return true;
+   }
+   if (!CreateDirectoryTree(dir)) return false;
+   std::lock_guard<std::mutex> lock(knownDirsMutex);
+   knownDirs.insert(dir);
+   return true;
+}
+
 size_t resizable_dim;
 
 size_t calcSizeFromDims(const zdl::DlSystem::Dimension *dims, size_t rank, size_t elementSize )
@@ -157,11 +197,98 @@ size_t calcSizeFromDims(const zdl::DlSystem::Dimension *dims, size_t rank, size_
    return size;
 }
 
+MappedFile::MappedFile(const std::string& path)
+{
+#ifdef _WIN32
+   HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+   if (file == INVALID_HANDLE_VALUE)
+   {
+      std::cerr << "Failed to open input file: " << path << "\n";
+      return;
+   }
+   LARGE_INTEGER length;
+   if (GetFileSizeEx(file, &length) && length.QuadPart > 0)
+   {
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+      if (mapping != NULL)
+      {
+         m_data = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+         CloseHandle(mapping);
+      }
+      if (m_data != nullptr) m_size = static_cast<size_t>(length.QuadPart);
+   }
+   CloseHandle(file);
+#else
+   int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+   {
+      std::cerr << "Failed to open input file: " << path << "\n";
+      return;
+   }
+   struct stat st;
+   if (fstat(fd, &st) == 0 && st.st_size > 0)
+   {
+      void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+      {
+         m_data = static_cast<uint8_t*>(p);
+         m_size = static_cast<size_t>(st.st_size);
+         madvise(p, m_size, MADV_WILLNEED);     // start the read-ahead of the whole file now
+      }
+   }
+   close(fd);
+#endif
+   if (m_data == nullptr)
+      std::cerr << "Failed to map input file: " << path << "\n";
+}
+
+MappedFile::~MappedFile()
+{
+   unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+   : m_data(other.m_data), m_size(other.m_size)
+{
+   other.m_data = nullptr;
+   other.m_size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+   if (this != &other)
+   {
+      unmap();
+      m_data = other.m_data;
+      m_size = other.m_size;
+      other.m_data = nullptr;
+      other.m_size = 0;
+   }
+   return *this;
+}
+
+void MappedFile::unmap()
+{
+   if (m_data == nullptr) return;
+#ifdef _WIN32
+   UnmapViewOfFile(m_data);
+#else
+   munmap(m_data, m_size);
+#endif
+   m_data = nullptr;
+   m_size = 0;
+}
+
 std::vector<float> loadFloatDataFile(const std::string& inputFile)
 {
-    std::vector<float> vec;
-    loadByteDataFile(inputFile, vec);
-    return vec;
+    MappedFile file(inputFile);
+    if (!file.valid()) return std::vector<float>();
+    if (file.size() % sizeof(float) != 0) {
+        std::cerr << "Size of input file should be divisible by sizeof(dtype).\n";
+        return std::vector<float>();
+    }
+    return std::vector<float>(file.as<float>(), file.as<float>() + file.size() / sizeof(float));
 }
 
 std::vector<unsigned char> loadByteDataFile(const std::string& inputFile)
@@ -179,6 +306,411 @@ std::vector<unsigned char> loadByteDataFileBatched(const std::string& inputFile)
    return vec;
 }
 
+// TfN kernels ------------------------------------------------------------------------------
+// Every kernel computes exactly what the scalar one does: dequantization multiplies in float,
+// which rounds the exact product (q - stepEquivalentTo0) * quantizedStepSize once, just as
+// the double product rounded to float did; quantization keeps the double arithmetic and
+// rounds halves away from zero like round(). The vector kernels handle whole vectors and
+// leave the tail to the scalar ones.
+namespace
+{
+struct TfNKernels
+{
+   const char* name;
+   // fmin / fmax of in[0..n) into min and max; NaNs are skipped
+   void (*minMax)(const float* in, size_t n, float& min, float& max);
+   // round(scale * (in - encodingMin) / encodingRange) clamped to [0, scale]
+   void (*quantize8)(uint8_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale);
+   void (*quantize16)(uint16_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale);
+   // (in - stepEquivalentTo0) * quantizedStepSize
+   void (*dequantize8)(float* out, const uint8_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize);
+   void (*dequantize16)(float* out, const uint16_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize);
+};
+
+void minMaxScalar(const float* in, size_t n, float& min, float& max)
+{
+   for (size_t i = 0; i < n; ++i) {
+      min = fmin(min, in[i]);
+      max = fmax(max, in[i]);
+   }
+}
+
+template <typename T>
+void quantizeScalar(T* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   for (size_t i = 0; i < n; ++i) {
+      double quantizedValue = round(scale * (in[i] - encodingMin) / encodingRange);
+      // Clamped as a double: NaN and values beyond int go to the ends of the range too
+      if (!(quantizedValue >= 0.0))
+         quantizedValue = 0.0;
+      else if (quantizedValue > scale)
+         quantizedValue = scale;
+      out[i] = static_cast <T> (quantizedValue);
+   }
+}
+
+template <typename T>
+void dequantizeScalar(float* out, const T* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   for (size_t i = 0; i < n; ++i) {
+      out[i] = static_cast <float> ((static_cast <double> (in[i]) - stepEquivalentTo0) * quantizedStepSize);
+   }
+}
+
+const TfNKernels kScalarKernels = {
+   "scalar", minMaxScalar, quantizeScalar<uint8_t>, quantizeScalar<uint16_t>,
+   dequantizeScalar<uint8_t>, dequantizeScalar<uint16_t>
+};
+
+#ifdef TFN_X86
+// _mm_min_ps / _mm_max_ps return their second operand when either is NaN, so with the
+// accumulator second a NaN input is skipped like fmin / fmax do
+TFN_TARGET("sse4.1")
+void minMaxSse41(const float* in, size_t n, float& min, float& max)
+{
+   __m128 lo = _mm_set1_ps(min), hi = _mm_set1_ps(max);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4) {
+      const __m128 x = _mm_loadu_ps(in + i);
+      lo = _mm_min_ps(x, lo);
+      hi = _mm_max_ps(x, hi);
+   }
+   float l[4], h[4];
+   _mm_storeu_ps(l, lo);
+   _mm_storeu_ps(h, hi);
+   minMaxScalar(l, 4, min, max);
+   minMaxScalar(h, 4, min, max);
+   minMaxScalar(in + i, n - i, min, max);
+}
+
+// round() on doubles: truncate, then step away from zero when the fraction is a half or more
+TFN_TARGET("sse4.1")
+__m128i quantizeSse41(__m128d x, __m128d encodingMin, __m128d encodingRange, __m128d scale)
+{
+   const __m128d one = _mm_set1_pd(1.0), half = _mm_set1_pd(0.5);
+   x = _mm_div_pd(_mm_mul_pd(scale, _mm_sub_pd(x, encodingMin)), encodingRange);
+   __m128d r = _mm_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+   const __m128d f = _mm_sub_pd(x, r);
+   r = _mm_add_pd(r, _mm_and_pd(_mm_cmpge_pd(f, half), one));
+   r = _mm_sub_pd(r, _mm_and_pd(_mm_cmple_pd(f, _mm_sub_pd(_mm_setzero_pd(), half)), one));
+   r = _mm_min_pd(_mm_max_pd(r, _mm_setzero_pd()), scale);     // NaN becomes 0
+   return _mm_cvttpd_epi32(r);
+}
+
+// Four floats to four int32 quantized values
+TFN_TARGET("sse4.1")
+__m128i quantize4Sse41(const float* in, __m128d encodingMin, __m128d encodingRange, __m128d scale)
+{
+   const __m128 x = _mm_loadu_ps(in);
+   const __m128i lo = quantizeSse41(_mm_cvtps_pd(x), encodingMin, encodingRange, scale);
+   const __m128i hi = quantizeSse41(_mm_cvtps_pd(_mm_movehl_ps(x, x)), encodingMin, encodingRange, scale);
+   return _mm_unpacklo_epi64(lo, hi);
+}
+
+TFN_TARGET("sse4.1")
+void quantize8Sse41(uint8_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   const __m128d mn = _mm_set1_pd(encodingMin), rg = _mm_set1_pd(encodingRange), sc = _mm_set1_pd(scale);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i q = _mm_packus_epi32(quantize4Sse41(in + i, mn, rg, sc), quantize4Sse41(in + i + 4, mn, rg, sc));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(q, q));
+   }
+   quantizeScalar(out + i, in + i, n - i, encodingMin, encodingRange, scale);
+}
+
+TFN_TARGET("sse4.1")
+void quantize16Sse41(uint16_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   const __m128d mn = _mm_set1_pd(encodingMin), rg = _mm_set1_pd(encodingRange), sc = _mm_set1_pd(scale);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i q = _mm_packus_epi32(quantize4Sse41(in + i, mn, rg, sc), quantize4Sse41(in + i + 4, mn, rg, sc));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), q);
+   }
+   quantizeScalar(out + i, in + i, n - i, encodingMin, encodingRange, scale);
+}
+
+TFN_TARGET("sse4.1")
+void dequantize8Sse41(float* out, const uint8_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   const __m128 s0 = _mm_set1_ps(stepEquivalentTo0), step = _mm_set1_ps(quantizedStepSize);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4) {
+      int32_t word;
+      memcpy(&word, in + i, sizeof(word));
+      const __m128 q = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(word)));
+      _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sub_ps(q, s0), step));
+   }
+   dequantizeScalar(out + i, in + i, n - i, stepEquivalentTo0, quantizedStepSize);
+}
+
+TFN_TARGET("sse4.1")
+void dequantize16Sse41(float* out, const uint16_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   const __m128 s0 = _mm_set1_ps(stepEquivalentTo0), step = _mm_set1_ps(quantizedStepSize);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4) {
+      const __m128i w = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+      const __m128 q = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(w));
+      _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sub_ps(q, s0), step));
+   }
+   dequantizeScalar(out + i, in + i, n - i, stepEquivalentTo0, quantizedStepSize);
+}
+
+const TfNKernels kSse41Kernels = {
+   "sse4.1", minMaxSse41, quantize8Sse41, quantize16Sse41, dequantize8Sse41, dequantize16Sse41
+};
+
+TFN_TARGET("avx2")
+void minMaxAvx2(const float* in, size_t n, float& min, float& max)
+{
+   __m256 lo = _mm256_set1_ps(min), hi = _mm256_set1_ps(max);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m256 x = _mm256_loadu_ps(in + i);
+      lo = _mm256_min_ps(x, lo);
+      hi = _mm256_max_ps(x, hi);
+   }
+   float l[8], h[8];
+   _mm256_storeu_ps(l, lo);
+   _mm256_storeu_ps(h, hi);
+   minMaxScalar(l, 8, min, max);
+   minMaxScalar(h, 8, min, max);
+   minMaxScalar(in + i, n - i, min, max);
+}
+
+// Four floats to four int32 quantized values, as quantizeSse41
+TFN_TARGET("avx2")
+__m128i quantize4Avx2(const float* in, __m256d encodingMin, __m256d encodingRange, __m256d scale)
+{
+   const __m256d one = _mm256_set1_pd(1.0), half = _mm256_set1_pd(0.5), zero = _mm256_setzero_pd();
+   __m256d x = _mm256_cvtps_pd(_mm_loadu_ps(in));
+   x = _mm256_div_pd(_mm256_mul_pd(scale, _mm256_sub_pd(x, encodingMin)), encodingRange);
+   __m256d r = _mm256_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+   const __m256d f = _mm256_sub_pd(x, r);
+   r = _mm256_add_pd(r, _mm256_and_pd(_mm256_cmp_pd(f, half, _CMP_GE_OQ), one));
+   r = _mm256_sub_pd(r, _mm256_and_pd(_mm256_cmp_pd(f, _mm256_sub_pd(zero, half), _CMP_LE_OQ), one));
+   r = _mm256_min_pd(_mm256_max_pd(r, zero), scale);
+   return _mm256_cvttpd_epi32(r);
+}
+
+TFN_TARGET("avx2")
+void quantize8Avx2(uint8_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   const __m256d mn = _mm256_set1_pd(encodingMin), rg = _mm256_set1_pd(encodingRange), sc = _mm256_set1_pd(scale);
+   size_t i = 0;
+   for (; i + 16 <= n; i += 16) {
+      const __m128i a = _mm_packus_epi32(quantize4Avx2(in + i, mn, rg, sc), quantize4Avx2(in + i + 4, mn, rg, sc));
+      const __m128i b = _mm_packus_epi32(quantize4Avx2(in + i + 8, mn, rg, sc), quantize4Avx2(in + i + 12, mn, rg, sc));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(a, b));
+   }
+   quantizeScalar(out + i, in + i, n - i, encodingMin, encodingRange, scale);
+}
+
+TFN_TARGET("avx2")
+void quantize16Avx2(uint16_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   const __m256d mn = _mm256_set1_pd(encodingMin), rg = _mm256_set1_pd(encodingRange), sc = _mm256_set1_pd(scale);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i q = _mm_packus_epi32(quantize4Avx2(in + i, mn, rg, sc), quantize4Avx2(in + i + 4, mn, rg, sc));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), q);
+   }
+   quantizeScalar(out + i, in + i, n - i, encodingMin, encodingRange, scale);
+}
+
+TFN_TARGET("avx2")
+void dequantize8Avx2(float* out, const uint8_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   const __m256 s0 = _mm256_set1_ps(stepEquivalentTo0), step = _mm256_set1_ps(quantizedStepSize);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i w = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+      const __m256 q = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(w));
+      _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_sub_ps(q, s0), step));
+   }
+   dequantizeScalar(out + i, in + i, n - i, stepEquivalentTo0, quantizedStepSize);
+}
+
+TFN_TARGET("avx2")
+void dequantize16Avx2(float* out, const uint16_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   const __m256 s0 = _mm256_set1_ps(stepEquivalentTo0), step = _mm256_set1_ps(quantizedStepSize);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+      const __m256 q = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(w));
+      _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_sub_ps(q, s0), step));
+   }
+   dequantizeScalar(out + i, in + i, n - i, stepEquivalentTo0, quantizedStepSize);
+}
+
+const TfNKernels kAvx2Kernels = {
+   "avx2", minMaxAvx2, quantize8Avx2, quantize16Avx2, dequantize8Avx2, dequantize16Avx2
+};
+
+bool cpuHas(int leaf, int reg, int bit)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+   int r[4];
+   __cpuid(r, 0);
+   if (r[0] < leaf) return false;
+   __cpuidex(r, leaf, 0);
+   return (r[reg] >> bit) & 1;
+#else
+   unsigned int r[4] = {0, 0, 0, 0};
+   if (!__get_cpuid_count(leaf, 0, &r[0], &r[1], &r[2], &r[3])) return false;
+   return (r[reg] >> bit) & 1;
+#endif
+}
+
+bool osSavesYmm()
+{
+   if (!cpuHas(1, 2, 27)) return false;                    // OSXSAVE
+#if defined(_MSC_VER) && !defined(__clang__)
+   return (_xgetbv(0) & 6) == 6;
+#else
+   unsigned int lo, hi;
+   __asm__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+   return (lo & 6) == 6;
+#endif
+}
+#endif // TFN_X86
+
+#ifdef TFN_NEON
+// vminnmq / vmaxnmq are IEEE minNum / maxNum: like fmin / fmax they skip a NaN
+void minMaxNeon(const float* in, size_t n, float& min, float& max)
+{
+   float32x4_t lo = vdupq_n_f32(min), hi = vdupq_n_f32(max);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4) {
+      const float32x4_t x = vld1q_f32(in + i);
+      lo = vminnmq_f32(lo, x);
+      hi = vmaxnmq_f32(hi, x);
+   }
+   float l[4], h[4];
+   vst1q_f32(l, lo);
+   vst1q_f32(h, hi);
+   minMaxScalar(l, 4, min, max);
+   minMaxScalar(h, 4, min, max);
+   minMaxScalar(in + i, n - i, min, max);
+}
+
+// vrndaq rounds halves away from zero, as round() does
+uint32x2_t quantizeNeon(float64x2_t x, float64x2_t encodingMin, float64x2_t encodingRange, float64x2_t scale)
+{
+   x = vdivq_f64(vmulq_f64(scale, vsubq_f64(x, encodingMin)), encodingRange);
+   float64x2_t r = vrndaq_f64(x);
+   r = vminq_f64(vmaxnmq_f64(r, vdupq_n_f64(0.0)), scale);     // NaN becomes 0
+   return vmovn_u64(vcvtq_u64_f64(r));
+}
+
+// Four floats to four uint16 quantized values
+uint16x4_t quantize4Neon(const float* in, float64x2_t encodingMin, float64x2_t encodingRange, float64x2_t scale)
+{
+   const float32x4_t x = vld1q_f32(in);
+   const uint32x2_t lo = quantizeNeon(vcvt_f64_f32(vget_low_f32(x)), encodingMin, encodingRange, scale);
+   const uint32x2_t hi = quantizeNeon(vcvt_high_f64_f32(x), encodingMin, encodingRange, scale);
+   return vmovn_u32(vcombine_u32(lo, hi));
+}
+
+void quantize8Neon(uint8_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   const float64x2_t mn = vdupq_n_f64(encodingMin), rg = vdupq_n_f64(encodingRange), sc = vdupq_n_f64(scale);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const uint16x8_t q = vcombine_u16(quantize4Neon(in + i, mn, rg, sc), quantize4Neon(in + i + 4, mn, rg, sc));
+      vst1_u8(out + i, vmovn_u16(q));
+   }
+   quantizeScalar(out + i, in + i, n - i, encodingMin, encodingRange, scale);
+}
+
+void quantize16Neon(uint16_t* out, const float* in, size_t n, double encodingMin, double encodingRange, double scale)
+{
+   const float64x2_t mn = vdupq_n_f64(encodingMin), rg = vdupq_n_f64(encodingRange), sc = vdupq_n_f64(scale);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      vst1q_u16(out + i, vcombine_u16(quantize4Neon(in + i, mn, rg, sc), quantize4Neon(in + i + 4, mn, rg, sc)));
+   }
+   quantizeScalar(out + i, in + i, n - i, encodingMin, encodingRange, scale);
+}
+
+void dequantize8Neon(float* out, const uint8_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   const float32x4_t s0 = vdupq_n_f32(stepEquivalentTo0), step = vdupq_n_f32(quantizedStepSize);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const uint16x8_t w = vmovl_u8(vld1_u8(in + i));
+      const float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(w)));
+      const float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(w)));
+      vst1q_f32(out + i, vmulq_f32(vsubq_f32(lo, s0), step));
+      vst1q_f32(out + i + 4, vmulq_f32(vsubq_f32(hi, s0), step));
+   }
+   dequantizeScalar(out + i, in + i, n - i, stepEquivalentTo0, quantizedStepSize);
+}
+
+void dequantize16Neon(float* out, const uint16_t* in, size_t n, float stepEquivalentTo0, float quantizedStepSize)
+{
+   const float32x4_t s0 = vdupq_n_f32(stepEquivalentTo0), step = vdupq_n_f32(quantizedStepSize);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4) {
+      const float32x4_t q = vcvtq_f32_u32(vmovl_u16(vld1_u16(in + i)));
+      vst1q_f32(out + i, vmulq_f32(vsubq_f32(q, s0), step));
+   }
+   dequantizeScalar(out + i, in + i, n - i, stepEquivalentTo0, quantizedStepSize);
+}
+
+const TfNKernels kNeonKernels = {
+   "neon", minMaxNeon, quantize8Neon, quantize16Neon, dequantize8Neon, dequantize16Neon
+};
+#endif // TFN_NEON
+
+// The kernels this CPU runs, best first; scalar is always last
+std::vector<const TfNKernels*> supportedTfNKernels()
+{
+   std::vector<const TfNKernels*> kernels;
+#ifdef TFN_X86
+   if (cpuHas(7, 1, 5) && osSavesYmm()) kernels.push_back(&kAvx2Kernels);
+   if (cpuHas(1, 2, 19)) kernels.push_back(&kSse41Kernels);
+#endif
+#ifdef TFN_NEON
+   kernels.push_back(&kNeonKernels);
+#endif
+   kernels.push_back(&kScalarKernels);
+   return kernels;
+}
+
+std::atomic<const TfNKernels*>& activeTfNKernels()
+{
+   static std::atomic<const TfNKernels*> active(supportedTfNKernels().front());
+   return active;
+}
+}
+
+std::vector<std::string> GetTfNKernels()
+{
+   std::vector<std::string> names;
+   for (const TfNKernels* k : supportedTfNKernels()) names.push_back(k->name);
+   return names;
+}
+
+std::string GetTfNKernel()
+{
+   return activeTfNKernels().load()->name;
+}
+
+bool SetTfNKernel(const std::string& name)
+{
+   for (const TfNKernels* k : supportedTfNKernels()) {
+      if (name == k->name) {
+         activeTfNKernels() = k;
+         return true;
+      }
+   }
+   return false;
+}
+
 void TfNToFloat(float *out,
                 uint8_t *in,
                 const unsigned char stepEquivalentTo0,
@@ -186,18 +718,12 @@ void TfNToFloat(float *out,
                 size_t numElement,
                 int bitWidth)
 {
-   for (size_t i = 0; i < numElement; ++i) {
-       if (8 == bitWidth) {
-           double quantizedValue = static_cast <double> (in[i]);
-           double stepEqTo0 = static_cast <double> (stepEquivalentTo0);
-           out[i] = static_cast <double> ((quantizedValue - stepEqTo0) * quantizedStepSize);
-       }
-       else if (16 == bitWidth) {
-           uint16_t *temp = (uint16_t *)in;
-           double quantizedValue = static_cast <double> (temp[i]);
-           double stepEqTo0 = static_cast <double> (stepEquivalentTo0);
-           out[i] = static_cast <double> ((quantizedValue - stepEqTo0) * quantizedStepSize);
-       }
+   const TfNKernels* kernels = activeTfNKernels().load();
+   if (8 == bitWidth) {
+      kernels->dequantize8(out, in, numElement, stepEquivalentTo0, quantizedStepSize);
+   }
+   else if (16 == bitWidth) {
+      kernels->dequantize16(out, reinterpret_cast<const uint16_t*>(in), numElement, stepEquivalentTo0, quantizedStepSize);
    }
 }
 
@@ -213,15 +739,13 @@ bool FloatToTfN(uint8_t* out,
    double encodingMax;
    double encodingRange;
    double trueBitWidthMax = pow(2, bitWidth) -1;
+   const TfNKernels* kernels = activeTfNKernels().load();
 
    if (!staticQuantization) {
       float trueMin = std::numeric_limits <float>::max();
       float trueMax = std::numeric_limits <float>::min();
 
-      for (size_t i = 0; i < numElement; ++i) {
-         trueMin = fmin(trueMin, in[i]);
-         trueMax = fmax(trueMax, in[i]);
-      }
+      kernels->minMax(in, numElement, trueMin, trueMax);
 
       double stepCloseTo0;
 
@@ -272,68 +796,55 @@ bool FloatToTfN(uint8_t* out,
       encodingRange = encodingMax - encodingMin;
    }
 
-   for (size_t i = 0; i < numElement; ++i) {
-      int quantizedValue = round(trueBitWidthMax * (in[i] - encodingMin) / encodingRange);
-
-      if (quantizedValue < 0)
-         quantizedValue = 0;
-      else if (quantizedValue > (int)trueBitWidthMax)
-         quantizedValue = (int)trueBitWidthMax;
-
-      if(bitWidth == 8){
-         out[i] = static_cast <uint8_t> (quantizedValue);
-      }
-      else if(bitWidth == 16){
-         uint16_t *temp = (uint16_t *)out;
-         temp[i] = static_cast <uint16_t> (quantizedValue);
-      }
+   if (bitWidth == 8) {
+      kernels->quantize8(out, in, numElement, encodingMin, encodingRange, trueBitWidthMax);
+   }
+   else if (bitWidth == 16) {
+      kernels->quantize16(reinterpret_cast<uint16_t*>(out), in, numElement, encodingMin, encodingRange, trueBitWidthMax);
    }
    return true;
 }
 
-bool loadByteDataFileBatchedTfN(const std::string& inputFile, std::vector<uint8_t>& loadVector, size_t offset,
+bool loadByteDataFileBatchedTfN(const std::string& inputFile, ApplicationBuffer& loadVector, size_t offset,
                                 unsigned char& stepEquivalentTo0, float& quantizedStepSize, bool staticQuantization,
                                 int bitWidth, bool useNativeInputFiles)
 {
-   std::ifstream in(inputFile, std::ifstream::binary);
-   std::vector<float> inVector;
-   if (!in.is_open() || !in.good())
+   // The floats are quantized straight out of the mapped file, without staging them in a vector
+   MappedFile in(inputFile);
+   if (!in.valid())
    {
-      std::cerr << "Failed to open input file: " << inputFile << "\n";
+      return false;
    }
-
-   in.seekg(0, in.end);
-   size_t length = in.tellg();
-   in.seekg(0, in.beg);
+   const size_t length = in.size();
 
    if (useNativeInputFiles) { //No need to convert datatypes if native input given
-      if(!in.read( reinterpret_cast<char*> (&loadVector[0]), length)) {
-         std::cerr << "Failed to read the contents of: " << inputFile << "\n";
+      if (loadVector.size() < (offset + 1) * length) {
+         std::cerr << "Vector is not large enough to hold data of input file: " << inputFile << "\n";
+         return false;
       }
+      std::memcpy(&loadVector[offset * length], in.data(), length);
       return true;
    }
 
+   const size_t elementSize = bitWidth / 8;
+   const size_t numElement = length / sizeof(float);
    if (loadVector.size() == 0) {
-      loadVector.resize(length / sizeof(uint8_t));
-   } else if (loadVector.size() < length/sizeof(float)) {
+      loadVector.resize(numElement * elementSize);
+   } else if (loadVector.size() < (offset + 1) * numElement * elementSize) {
       std::cerr << "Vector is not large enough to hold data of input file: " << inputFile << "\n";
+      return false;
    }
 
-   int elementSize = bitWidth / 8;
-   inVector.resize(loadVector.size() / elementSize);
-   if (!in.read( reinterpret_cast<char*> (&inVector[0]), length) )
-   {
-      std::cerr << "Failed to read the contents of: " << inputFile << "\n";
-   }
-   size_t dataStartPos = (offset * length * elementSize) / sizeof(float);
-   if(!FloatToTfN(&loadVector[dataStartPos], stepEquivalentTo0, quantizedStepSize, staticQuantization, inVector.data(), inVector.size(), bitWidth))
+   size_t dataStartPos = offset * numElement * elementSize;
+   if(!FloatToTfN(&loadVector[dataStartPos], stepEquivalentTo0, quantizedStepSize, staticQuantization,
+                  const_cast<float*>(in.as<float>()), numElement, bitWidth))
    {
      return false;
    }
    return true;
 }
 
-bool loadByteDataFileBatchedTf8(const std::string& inputFile, std::vector<uint8_t>& loadVector, size_t offset)
+bool loadByteDataFileBatchedTf8(const std::string& inputFile, ApplicationBuffer& loadVector, size_t offset)
 {
    std::ifstream in(inputFile, std::ifstream::binary);
    std::vector<float> inVector;
@@ -375,10 +886,8 @@ bool loadByteDataFileBatchedTf8(const std::string& inputFile, std::vector<uint8_
    return true;
 }
 
-bool SaveITensorBatched(const std::string& path, const zdl::DlSystem::ITensor* tensor, size_t batchIndex, size_t batchChunk)
+bool SaveRawFile(const std::string& path, const void* data, size_t bytes)
 {
-   if(batchChunk == 0)
-      batchChunk = tensor->getSize();
    // Create the directory path if it does not exist
    auto idx = path.find_last_of('/');
    if (idx != std::string::npos)
@@ -408,63 +917,29 @@ bool SaveITensorBatched(const std::string& path, const zdl::DlSystem::ITensor* t
       std::cerr << "Failed to open output file for writing: " << path << "\n";
       return false;
    }
-
-   for ( auto it = tensor->cbegin() + batchIndex * batchChunk; it != tensor->cbegin() + (batchIndex+1) * batchChunk; ++it )
+   if (bytes != 0 && !os.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes)))
    {
-      float f = *it;
-      if (!os.write(reinterpret_cast<char*>(&f), sizeof(float)))
-      {
-         std::cerr << "Failed to write data to: " << path << "\n";
-         return false;
-      }
+      std::cerr << "Failed to write data to: " << path << "\n";
+      return false;
    }
    return true;
 }
 
-bool SaveUserBufferBatched(const std::string& path, const std::vector<uint8_t>& buffer, size_t batchIndex, size_t batchChunk)
+bool SaveITensorBatched(const std::string& path, const zdl::DlSystem::ITensor* tensor, size_t batchIndex, size_t batchChunk)
 {
    if(batchChunk == 0)
-      batchChunk = buffer.size();
-   // Create the directory path if it does not exist
-   auto idx = path.find_last_of('/');
-   if (idx != std::string::npos)
-   {
-      std::string dir = path.substr(0, idx);
-      if (!EnsureDirectory(dir))
-      {
-#ifdef _WIN32
-         char buf[64] = { 0 };
-         const size_t bufSize = sizeof(buf);
-         if (strerror_s(buf, bufSize, errno) != 0) {
-             buf[bufSize - 1] = '\0';
-             std::cerr << "Failed to create output directory: " << dir << ": "
-                 << buf << "\n";
-         }
-#else
-         std::cerr << "Failed to create output directory: " << dir << ": "
-                   << std::strerror(errno) << "\n";
-#endif
-         return false;
-      }
-   }
-
-   std::ofstream os(path, std::ofstream::binary);
-   if (!os)
-   {
-      std::cerr << "Failed to open output file for writing: " << path << "\n";
-      return false;
-   }
+      batchChunk = tensor->getSize();
+   // Gather the chunk once and write it in one call rather than a float at a time
+   std::vector<float> chunk(batchChunk);
+   std::copy(tensor->cbegin() + batchIndex * batchChunk, tensor->cbegin() + (batchIndex+1) * batchChunk, chunk.begin());
+   return SaveRawFile(path, chunk.data(), chunk.size() * sizeof(float));
+}
 
-   for ( auto it = buffer.begin() + batchIndex * batchChunk; it != buffer.begin() + (batchIndex+1) * batchChunk; ++it )
-   {
-      uint8_t u = *it;
-      if(!os.write((char*)(&u), sizeof(uint8_t)))
-      {
-        std::cerr << "Failed to write data to: " << path << "\n";
-        return false;
-      }
-   }
-   return true;
+bool SaveUserBufferBatched(const std::string& path, const ApplicationBuffer& buffer, size_t batchIndex, size_t batchChunk)
+{
+   if(batchChunk == 0)
+      batchChunk = buffer.size();
+   return SaveRawFile(path, buffer.data() + batchIndex * batchChunk, batchChunk);
 }
 
 void setResizableDim(size_t resizableDim)
@@ -17,6 +17,7 @@
 
 #include "DlSystem/ITensorFactory.hpp"
 #include "DlSystem/TensorShape.hpp"
+#include "UserBufferArena.hpp"
 
 template <typename Container> Container& split(Container& result, const typename Container::value_type & s, typename Container::value_type::value_type delimiter )
 {
@@ -39,6 +40,31 @@ std::vector<float> loadFloatDataFile(const std::string& inputFile);
 std::vector<unsigned char> loadByteDataFile(const std::string& inputFile);
 std::vector<unsigned char> loadByteDataFileBatched(const std::string& inputFile);
 
+// Read-only view of a whole file through mmap (MapViewOfFile on Windows). The pages come
+// straight from the page cache, so data() can back an input user buffer without a copy.
+// The mapping is private: a write lands in a private page and never reaches the file.
+class MappedFile
+{
+public:
+   MappedFile() = default;
+   explicit MappedFile(const std::string& path);
+   ~MappedFile();
+   MappedFile(MappedFile&& other) noexcept;
+   MappedFile& operator=(MappedFile&& other) noexcept;
+   MappedFile(const MappedFile&) = delete;
+   MappedFile& operator=(const MappedFile&) = delete;
+
+   bool valid() const { return m_data != nullptr; }
+   uint8_t* data() const { return m_data; }
+   size_t size() const { return m_size; }
+   template<typename T> const T* as() const { return reinterpret_cast<const T*>(m_data); }
+
+private:
+   void unmap();
+   uint8_t* m_data = nullptr;
+   size_t m_size = 0;
+};
+
 template<typename T>
 bool loadByteDataFile(const std::string& inputFile, std::vector<T>& loadVector)
 {
@@ -71,8 +97,8 @@ bool loadByteDataFile(const std::string& inputFile, std::vector<T>& loadVector)
    return true;
 }
 
-template<typename T>
-bool loadByteDataFileBatched(const std::string& inputFile, std::vector<T>& loadVector, size_t offset)
+template<typename T, typename A>
+bool loadByteDataFileBatched(const std::string& inputFile, std::vector<T, A>& loadVector, size_t offset)
 {
     std::ifstream in(inputFile, std::ifstream::binary);
     if (!in.is_open() || !in.good())
@@ -104,15 +130,24 @@ bool loadByteDataFileBatched(const std::string& inputFile, std::vector<T>& loadV
     return true;
 }
 
-bool loadByteDataFileBatchedTf8(const std::string& inputFile, std::vector<uint8_t>& loadVector, size_t offset);
-bool loadByteDataFileBatchedTfN(const std::string& inputFile, std::vector<uint8_t>& loadVector, size_t offset,
+bool loadByteDataFileBatchedTf8(const std::string& inputFile, ApplicationBuffer& loadVector, size_t offset);
+bool loadByteDataFileBatchedTfN(const std::string& inputFile, ApplicationBuffer& loadVector, size_t offset,
                                 unsigned char& stepEquivalentTo0, float& quantizedStepSize, bool staticQuantization,
                                 int bitWidth, bool useNativeInputFiles=false);
 
+// Write bytes to path in one call, creating its directory first.
+bool SaveRawFile(const std::string& path, const void* data, size_t bytes);
 bool SaveITensorBatched(const std::string& path, const zdl::DlSystem::ITensor* tensor, size_t batchIndex=0, size_t batchChunk=0);
-bool SaveUserBufferBatched(const std::string& path, const std::vector<uint8_t>& buffer, size_t batchIndex=0, size_t batchChunk=0);
+bool SaveUserBufferBatched(const std::string& path, const ApplicationBuffer& buffer, size_t batchIndex=0, size_t batchChunk=0);
 bool EnsureDirectory(const std::string& dir);
 
+// FloatToTfN and TfNToFloat run vector kernels for the best instruction set this CPU has
+// (avx2 or sse4.1 on x86-64, neon on AArch64, else scalar), all with identical results.
+// GetTfNKernels lists those usable here, best first; SetTfNKernel picks one of them.
+std::vector<std::string> GetTfNKernels();
+std::string GetTfNKernel();
+bool SetTfNKernel(const std::string& name);
+
 void TfNToFloat(float *out, uint8_t *in, const unsigned char stepEquivalentTo0, const float quantizedStepSize, size_t numElement, int bitWidth);
 bool FloatToTfN(uint8_t* out, unsigned char& stepEquivalentTo0, float& quantizedStepSize, bool staticQuantization, float* in, size_t numElement, int bitWidth);
 
@@ -0,0 +1,65 @@
+// YuvPreprocess.hpp – camera frames (NV21 / NV12) to a network's NHWC RGB float input
+#ifndef YUVPREPROCESS_H
+#define YUVPREPROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Both layouts are a full-resolution Y plane followed by one plane of interleaved chroma
+// pairs at half resolution in each direction (rounded up): V then U for NV21, the
+// Android camera default, U then V for NV12.
+enum class YuvLayout { NV21, NV12 };
+
+struct YuvFrame
+{
+    const uint8_t* data = nullptr;
+    size_t width = 0;
+    size_t height = 0;
+    YuvLayout layout = YuvLayout::NV21;
+};
+
+// Bytes of a width x height frame
+size_t YuvFrameBytes(size_t width, size_t height);
+
+// Per channel, in R, G, B order: value = (pixel - mean) * scale, pixels being 0..255.
+// The default leaves the pixel values as they are, like the raw files quantize.py writes.
+struct PixelNormalization
+{
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+    bool identity() const;
+};
+
+// Wall time of the three stages, summed over frames
+struct PreprocessTimes
+{
+    double convertMs = 0.0;     // YUV to RGB, of the source rows the resize reads
+    double resizeMs = 0.0;      // bilinear resize
+    double normalizeMs = 0.0;   // mean / scale into the destination
+    size_t frames = 0;
+    PreprocessTimes& operator+=(const PreprocessTimes& other);
+};
+
+// Frame to dst, outHeight x outWidth x 3 floats (NHWC, RGB): BT.601 limited-range YUV to
+// RGB, bilinear resize with half-pixel centres (as OpenCV INTER_LINEAR; downscaling does
+// not low-pass filter like PIL does), then the normalization. dst may be an input user
+// buffer. Only the source rows the resize reads are converted. Adds the stage times to
+// times if given. False, with the reason on stderr, for an empty frame or size.
+bool PreprocessYuvFrame(const YuvFrame& frame, size_t outWidth, size_t outHeight,
+                        const PixelNormalization& norm, float* dst, PreprocessTimes* times = nullptr);
+
+// "<W>x<H>[:nv12|:nv21]" to the size and layout of frame (data is left alone)
+bool ParseYuvFormat(const std::string& spec, YuvFrame& frame);
+// "<MEAN>[:<SCALE>]", each a single value or three comma-separated ones (R,G,B)
+bool ParsePixelNormalization(const std::string& spec, PixelNormalization& norm);
+
+// The kernels run the best instruction set this CPU has (avx2 or sse4.1 on x86-64, neon
+// on AArch64, else scalar). GetYuvKernels lists those usable here, best first;
+// SetYuvKernel picks one of them.
+std::vector<std::string> GetYuvKernels();
+std::string GetYuvKernel();
+bool SetYuvKernel(const std::string& name);
+
+#endif
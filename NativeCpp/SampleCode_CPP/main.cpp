@@ -20,6 +20,7 @@
 #include <iterator>
 #include <unordered_map>
 #include <algorithm>
+#include <chrono>
 
 #include "CheckRuntime.hpp"
 #include "LoadContainer.hpp"
@@ -29,6 +30,11 @@
 #include "CreateUserBuffer.hpp"
 #include "PreprocessInput.hpp"
 #include "SaveOutputTensor.hpp"
+#include "Pipeline.hpp"
+#include "OutputWriter.hpp"
+#include "InputPack.hpp"
+#include "YuvPreprocess.hpp"
+#include "UserBufferArena.hpp"
 #include "Util.hpp"
 #include "DlSystem/DlError.hpp"
 #include "DlSystem/RuntimeList.hpp"
@@ -86,6 +92,15 @@ int main(int argc, char **argv)
     bool cpuFixedPointMode = false;
     std::string UdoPackagePath = "";
     bool useNativeInputFiles = false;
+    bool pipelined = false;
+    bool mapInputs = false;
+    size_t pipelineDepth = 2;
+    size_t writerThreads = 0;
+    bool packedOutput = false;
+    std::string inputPackPath = "";
+    std::string cameraFormatStr = "";
+    std::string cameraNormStr = "";
+    std::string arenaPagesStr = "";
     static std::string perfProfileStr = "default";
     static zdl::DlSystem::PerformanceProfile_t PerfProfile = zdl::DlSystem::PerformanceProfile_t::BALANCED;;
 
@@ -103,7 +118,7 @@ int main(int argc, char **argv)
     // Process command line arguments
     int opt = 0;
 #ifndef _WIN32
-    while ((opt = getopt(argc, argv, "hi:d:o:b:q:s:z:r:l:u:cx:p:n")) != -1)
+    while ((opt = getopt(argc, argv, "hi:d:o:b:q:s:z:r:l:u:cx:p:nemk:w:OP:Y:N:a:")) != -1)
 #else
     enum OPTIONS
     {
@@ -121,7 +136,16 @@ int main(int argc, char **argv)
         OPT_BUFF_SOURCE = 's',
         OPT_CPU_FXP = 'x',
         OPT_NATIVE_INPUT = 'n',
-        OPT_PERF_PROFILE = 'p'
+        OPT_PERF_PROFILE = 'p',
+        OPT_PIPELINED = 'e',
+        OPT_MAP_INPUTS = 'm',
+        OPT_PIPELINE_DEPTH = 'k',
+        OPT_WRITER_THREADS = 'w',
+        OPT_PACKED_OUTPUT = 'O',
+        OPT_INPUT_PACK = 'P',
+        OPT_CAMERA_FORMAT = 'Y',
+        OPT_CAMERA_NORM = 'N',
+        OPT_ARENA = 'a'
     };
     static struct WinOpt::option long_options[] = {
         {"h", WinOpt::no_argument, NULL, OPT_HELP},
@@ -139,6 +163,15 @@ int main(int argc, char **argv)
         {"s", WinOpt::required_argument, NULL, OPT_BUFF_SOURCE},
         {"n", WinOpt::no_argument, NULL, OPT_NATIVE_INPUT},
         {"p", WinOpt::required_argument, NULL, OPT_PERF_PROFILE},
+        {"e", WinOpt::no_argument, NULL, OPT_PIPELINED},
+        {"m", WinOpt::no_argument, NULL, OPT_MAP_INPUTS},
+        {"k", WinOpt::required_argument, NULL, OPT_PIPELINE_DEPTH},
+        {"w", WinOpt::required_argument, NULL, OPT_WRITER_THREADS},
+        {"O", WinOpt::no_argument, NULL, OPT_PACKED_OUTPUT},
+        {"P", WinOpt::required_argument, NULL, OPT_INPUT_PACK},
+        {"Y", WinOpt::required_argument, NULL, OPT_CAMERA_FORMAT},
+        {"N", WinOpt::required_argument, NULL, OPT_CAMERA_NORM},
+        {"a", WinOpt::required_argument, NULL, OPT_ARENA},
         {NULL, 0, NULL, 0}};
     int long_index = 0;
     while ((opt = WinOpt::GetOptLongOnly(argc, argv, "", long_options, &long_index)) != -1)
@@ -192,7 +225,35 @@ int main(int argc, char **argv)
                 << "  -n            Specifies to consume the input file(s) in their native data types. \n"
                 << "  -p <TYPE>     Specifies perf profile to set. Valid settings are \"low_balanced\" , \"balanced\" , \"default\",\n"
                 << "\"high_performance\" ,\"sustained_high_performance\", \"burst\", \"low_power_saver\", \"power_saver\",\n"
-                << "\"high_power_saver\", \"extreme_power_saver\", and \"system_settings\"."
+                << "\"high_power_saver\", \"extreme_power_saver\", and \"system_settings\".\n"
+                << "  -e            Overlap loading the next inputs and saving the previous outputs with execution:\n"
+                << "                a loader thread, the executing main thread and a writer thread pass recycled\n"
+                << "                user-buffer sets. Used in conjunction with USERBUFFER_* CPUBUFFER.\n"
+                << "  -k  <NUMBER>  Input and output buffer sets of -e, the batches loaded ahead or waiting to be\n"
+                << "                written at most (" << pipelineDepth << " is default).\n"
+                << "  -m            Execute straight from memory-mapped input files instead of copying them into\n"
+                << "                the input user buffers. Used in conjunction with USERBUFFER_FLOAT CPUBUFFER and batch size 1.\n"
+                << "  -w  <NUMBER>  Threads writing the output files in the background, so execution does not wait\n"
+                << "                for the file system (0, writing each result before the next execution, is default).\n"
+                << "  -O            Write all results into one packed file, <output_dir>/results.pack, with an index\n"
+                << "                of result number, output name, offset and size, instead of a Result_N directory\n"
+                << "                per result.\n"
+                << "  -P  <FILE>    Read the inputs from a packed input file: every input of the input list in one\n"
+                << "                mapped file, already in the buffer type's element type and encoding, bound to the\n"
+                << "                input user buffers without reading or converting files. Created from the input list\n"
+                << "                when FILE does not exist; delete it after changing the input files.\n"
+                << "                Used in conjunction with USERBUFFER_* CPUBUFFER.\n"
+                << "  -Y  <W>x<H>[:nv21|:nv12]  The input files are camera frames of this size and layout (nv21 is\n"
+                << "                default): each is converted to RGB, resized bilinearly to the input's height and\n"
+                << "                width, normalized and packed NHWC into the input user buffer, with a per-stage\n"
+                << "                time breakdown. Every input has to be an image with 3 channels.\n"
+                << "                Used in conjunction with USERBUFFER_* CPUBUFFER.\n"
+                << "  -N  <MEAN>[:<SCALE>]  Normalization of -Y, (pixel - MEAN) * SCALE on 0..255 pixels; each a single\n"
+                << "                value or R,G,B (0:1, the raw pixel values, is default).\n"
+                << "  -a  <PAGES>   Allocate all input and output user buffers, of every -e set, from one block\n"
+                << "                with each buffer on a 64-byte boundary, instead of one heap vector each. PAGES is\n"
+                << "                small (4 KiB pages) or huge (2 MiB pages: hugetlbfs if reserved, else transparent\n"
+                << "                huge pages). The layout is printed. Used in conjunction with USERBUFFER_* CPUBUFFER.\n"
                 << std::endl;
 
             std::exit(SUCCESS);
@@ -298,6 +359,33 @@ int main(int argc, char **argv)
         case 'p':
             perfProfileStr = optarg;
             break;
+        case 'e':
+            pipelined = true;
+            break;
+        case 'm':
+            mapInputs = true;
+            break;
+        case 'k':
+            pipelineDepth = static_cast<size_t>(std::max(1, atoi(optarg)));
+            break;
+        case 'w':
+            writerThreads = static_cast<size_t>(std::max(0, atoi(optarg)));
+            break;
+        case 'O':
+            packedOutput = true;
+            break;
+        case 'P':
+            inputPackPath = optarg;
+            break;
+        case 'Y':
+            cameraFormatStr = optarg;
+            break;
+        case 'N':
+            cameraNormStr = optarg;
+            break;
+        case 'a':
+            arenaPagesStr = optarg;
+            break;
         default:
             std::cout << "Invalid parameter specified. Please run snpe-sample with the -h flag to see required arguments" << std::endl;
             std::exit(FAILURE);
@@ -384,6 +472,25 @@ int main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
+    // Check if the camera frame format and normalization are valid
+    CameraInput camera;
+    const bool useCamera = !cameraFormatStr.empty();
+    if ((useCamera && !ParseYuvFormat(cameraFormatStr, camera.format))
+        || (!cameraNormStr.empty() && !ParsePixelNormalization(cameraNormStr, camera.norm)))
+    {
+        std::cout << "Camera frame format or normalization is not valid. Please run snpe-sample with the -h flag for more details"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Check if the arena page size is valid
+    if (!arenaPagesStr.empty() && arenaPagesStr != "small" && arenaPagesStr != "huge")
+    {
+        std::cout << "Arena page size is not valid. Please run snpe-sample with the -h flag for more details"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // Check if both runtimelist and runtime are passed in
     if (runtimeSpecified && runtimeList.empty() == false)
     {
@@ -538,10 +645,64 @@ int main(int argc, char **argv)
     }
 #endif
     std::cout << "Batch size for the container is " << batchSize << std::endl;
+    if (mapInputs && (bufferType != USERBUFFER_FLOAT || userBufferSourceType != CPUBUFFER || batchSize > 1))
+    {
+        std::cout << "-m needs USERBUFFER_FLOAT CPUBUFFER and batch size 1, copying the inputs" << std::endl;
+        mapInputs = false;
+    }
+
+    // Camera frames are preprocessed into the input user buffers, never mapped or packed
+    if (useCamera)
+    {
+        if (!useUserSuppliedBuffers || userBufferSourceType != CPUBUFFER)
+        {
+            std::cerr << "-Y needs USERBUFFER_* CPUBUFFER" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (mapInputs || !inputPackPath.empty())
+            std::cout << "-Y preprocesses every camera frame, ignoring -m and -P" << std::endl;
+        mapInputs = false;
+        inputPackPath.clear();
+    }
 
     // Open the input file listing and group input files into batches
     std::vector<std::vector<std::string>> inputs = preprocessInput(inputFile, batchSize);
 
+    // With -P the inputs come from the packed input file, made from the input list first if missing
+    InputPack inputPack;
+    const bool usePack = !inputPackPath.empty() && useUserSuppliedBuffers && userBufferSourceType == CPUBUFFER;
+    if (!inputPackPath.empty() && !usePack)
+    {
+        std::cout << "-P needs USERBUFFER_* CPUBUFFER, reading the input files" << std::endl;
+    }
+    if (usePack)
+    {
+        bool isTfN = (bufferType == USERBUFFER_TF8 || bufferType == USERBUFFER_TF16);
+        if (!std::ifstream(inputPackPath)
+            && !createInputPack(inputPackPath, snpe, inputs, isTfN, staticQuantization, bitWidth, useNativeInputFiles, batchSize))
+        {
+            return EXIT_FAILURE;
+        }
+        if (!inputPack.open(inputPackPath))
+        {
+            return EXIT_FAILURE;
+        }
+        if (!inputPack.fits(snpe, isTfN, staticQuantization, bitWidth, useNativeInputFiles, batchSize))
+        {
+            std::cerr << inputPackPath << " was made for other network inputs, buffer type or batch size; delete it to recreate it" << std::endl;
+            return EXIT_FAILURE;
+        }
+        mapInputs = false;
+    }
+
+    // Execute time against wall time of the batch loop, to compare with -e
+    ExecStats execStats;
+    for (const auto& batch : inputs)
+        execStats.images += batch.size();
+    // Results go through the writer; its threads, if any, are part of the wall time
+    OutputWriter writer(OutputDir, writerThreads, packedOutput);
+    auto loopStart = std::chrono::steady_clock::now();
+
     // Load contents of input file batches ino a SNPE tensor or user buffer,
     // user buffer include cpu buffer and OpenGL buffer,
     // execute the network with the input and save each of the returned output to a file.
@@ -552,32 +713,65 @@ int main(int argc, char **argv)
         // user-backed storage. These SNPE buffers are then supplied to the network
         // and the results are stored in user-backed output buffers. This allows for
         // reusing the same buffers for multiple inputs and outputs.
+        // With -a they are all carved out of one block, declared first so it goes last
+        std::unique_ptr<UserBufferArena> arena;
+        if (!arenaPagesStr.empty() && userBufferSourceType == CPUBUFFER)
+        {
+            bool isTfN = (bufferType == USERBUFFER_TF8 || bufferType == USERBUFFER_TF16);
+            size_t sets = pipelined ? pipelineDepth : 1;
+            arena.reset(new UserBufferArena(userBufferArenaBytes(snpe, isTfN, bitWidth, sets), arenaPagesStr == "huge"));
+            if (!arena->valid())
+            {
+                std::cerr << "Failed to map the user buffer arena" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else if (!arenaPagesStr.empty())
+        {
+            std::cout << "-a needs USERBUFFER_* CPUBUFFER, allocating the buffers one by one" << std::endl;
+        }
         zdl::DlSystem::UserBufferMap inputMap, outputMap;
         std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> snpeUserBackedInputBuffers, snpeUserBackedOutputBuffers;
-        std::unordered_map<std::string, std::vector<uint8_t>> applicationOutputBuffers;
+        std::unordered_map<std::string, ApplicationBuffer> applicationOutputBuffers;
 
-        if (bufferType == USERBUFFER_TF8 || bufferType == USERBUFFER_TF16)
+        if (pipelined && userBufferSourceType == CPUBUFFER)
         {
-            createOutputBufferMap(outputMap, applicationOutputBuffers, snpeUserBackedOutputBuffers, snpe, true, bitWidth);
+            bool isTfN = (bufferType == USERBUFFER_TF8 || bufferType == USERBUFFER_TF16);
+            if (!executePipelined(snpe, inputs, writer, batchSize, isTfN, staticQuantization, bitWidth, useNativeInputFiles, mapInputs, usePack ? &inputPack : nullptr, useCamera ? &camera : nullptr, arena.get(), pipelineDepth, execStats))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (bufferType == USERBUFFER_TF8 || bufferType == USERBUFFER_TF16)
+        {
+            createOutputBufferMap(outputMap, applicationOutputBuffers, snpeUserBackedOutputBuffers, snpe, true, bitWidth, arena.get());
 
-            std::unordered_map<std::string, std::vector<uint8_t>> applicationInputBuffers;
-            createInputBufferMap(inputMap, applicationInputBuffers, snpeUserBackedInputBuffers, snpe, true, staticQuantization, bitWidth);
+            std::unordered_map<std::string, ApplicationBuffer> applicationInputBuffers;
+            createInputBufferMap(inputMap, applicationInputBuffers, snpeUserBackedInputBuffers, snpe, true, staticQuantization, bitWidth, arena.get());
 
             for (size_t i = 0; i < inputs.size(); i++)
             {
                 // Load input user buffer(s) with values from file(s)
                 if (batchSize > 1)
                     std::cout << "Batch " << i << ":" << std::endl;
-                if (!loadInputUserBufferTfN(applicationInputBuffers, snpe, inputs[i], inputMap, staticQuantization, bitWidth, useNativeInputFiles))
+                auto loadStart = std::chrono::steady_clock::now();
+                bool loaded = useCamera ? loadInputUserBufferCamera(applicationInputBuffers, snpe, inputs[i], inputMap, camera, true, staticQuantization, bitWidth, execStats.prep)
+                            : usePack ? loadInputUserBufferPacked(inputPack, applicationInputBuffers, inputMap, inputs[i], true)
+                                      : loadInputUserBufferTfN(applicationInputBuffers, snpe, inputs[i], inputMap, staticQuantization, bitWidth, useNativeInputFiles);
+                execStats.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+                if (!loaded)
                 {
                     return EXIT_FAILURE;
                 }
                 // Execute the input buffer map on the model with SNPE
-                execStatus = snpe->execute(inputMap, outputMap);
+                {
+                    ExecTimer timer(execStats);
+                    execStatus = snpe->execute(inputMap, outputMap);
+                }
                 // Save the execution results only if successful
                 if (execStatus == true)
                 {
-                    if (!saveOutput(outputMap, applicationOutputBuffers, OutputDir, i * batchSize, batchSize, true, bitWidth))
+                    if (!saveOutput(outputMap, applicationOutputBuffers, writer, i * batchSize, batchSize, true, bitWidth))
                     {
                         return EXIT_FAILURE;
                     }
@@ -590,28 +784,39 @@ int main(int argc, char **argv)
         }
         else if (bufferType == USERBUFFER_FLOAT)
         {
-            createOutputBufferMap(outputMap, applicationOutputBuffers, snpeUserBackedOutputBuffers, snpe, false, bitWidth);
+            createOutputBufferMap(outputMap, applicationOutputBuffers, snpeUserBackedOutputBuffers, snpe, false, bitWidth, arena.get());
 
             if (userBufferSourceType == CPUBUFFER || userBufferSourceType == GLBUFFER)
             {
-                std::unordered_map<std::string, std::vector<uint8_t>> applicationInputBuffers;
-                createInputBufferMap(inputMap, applicationInputBuffers, snpeUserBackedInputBuffers, snpe, false, false, bitWidth);
+                std::unordered_map<std::string, ApplicationBuffer> applicationInputBuffers;
+                createInputBufferMap(inputMap, applicationInputBuffers, snpeUserBackedInputBuffers, snpe, false, false, bitWidth, arena.get());
+                // With -m the input buffers point into these mappings of the current batch's files
+                std::vector<MappedFile> mappedInputs;
 
                 for (size_t i = 0; i < inputs.size(); i++)
                 {
                     // Load input user buffer(s) with values from file(s)
                     if (batchSize > 1)
                         std::cout << "Batch " << i << ":" << std::endl;
-                    if (!loadInputUserBufferFloat(applicationInputBuffers, snpe, inputs[i]))
+                    auto loadStart = std::chrono::steady_clock::now();
+                    bool loaded = useCamera ? loadInputUserBufferCamera(applicationInputBuffers, snpe, inputs[i], inputMap, camera, false, false, bitWidth, execStats.prep)
+                                : usePack ? loadInputUserBufferPacked(inputPack, applicationInputBuffers, inputMap, inputs[i], false)
+                                : mapInputs ? bindInputUserBufferMapped(mappedInputs, inputMap, snpe, inputs[i])
+                                : loadInputUserBufferFloat(applicationInputBuffers, snpe, inputs[i]);
+                    execStats.loadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+                    if (!loaded)
                     {
                         return EXIT_FAILURE;
                     }
                     // Execute the input buffer map on the model with SNPE
-                    execStatus = snpe->execute(inputMap, outputMap);
+                    {
+                        ExecTimer timer(execStats);
+                        execStatus = snpe->execute(inputMap, outputMap);
+                    }
                     // Save the execution results only if successful
                     if (execStatus == true)
                     {
-                        if (!saveOutput(outputMap, applicationOutputBuffers, OutputDir, i * batchSize, batchSize, false, bitWidth))
+                        if (!saveOutput(outputMap, applicationOutputBuffers, writer, i * batchSize, batchSize, false, bitWidth))
                         {
                             return EXIT_FAILURE;
                         }
@@ -623,9 +828,18 @@ int main(int argc, char **argv)
                 }
             }
         }
+        if (arena)
+        {
+            std::cout << "User buffer arena: " << arena->layout().size() << " buffers, " << arena->used() << " of "
+                      << arena->capacity() << " bytes, " << arena->pageKind() << " pages" << std::endl;
+            for (const auto& slot : arena->layout())
+                std::cout << "  " << slot.name << " at offset " << slot.offset << ", " << slot.bytes << " bytes" << std::endl;
+        }
     }
     else if (bufferType == ITENSOR)
     {
+        if (pipelined)
+            std::cout << "-e needs user buffers, running ITENSOR serially" << std::endl;
         // A tensor map for SNPE execution outputs
         zdl::DlSystem::TensorMap outputTensorMap;
         // Get input names and number
@@ -648,6 +862,7 @@ int main(int argc, char **argv)
                     return EXIT_FAILURE;
                 }
                 // Execute the input tensor on the model with SNPE
+                ExecTimer timer(execStats);
                 execStatus = snpe->execute(inputTensor.get(), outputTensorMap);
             }
             else
@@ -662,12 +877,13 @@ int main(int argc, char **argv)
                     return EXIT_FAILURE;
                 }
                 // Execute the multiple input tensorMap on the model with SNPE
+                ExecTimer timer(execStats);
                 execStatus = snpe->execute(inputTensorMap, outputTensorMap);
             }
             // Save the execution results if execution successful
             if (execStatus == true)
             {
-                if (!saveOutput(outputTensorMap, OutputDir, i * batchSize, batchSize))
+                if (!saveOutput(outputTensorMap, writer, i * batchSize, batchSize))
                 {
                     return EXIT_FAILURE;
                 }
@@ -678,6 +894,13 @@ int main(int argc, char **argv)
             }
         }
     }
+    if (!writer.finish())
+    {
+        return EXIT_FAILURE;
+    }
+    execStats.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loopStart).count();
+    printExecUtilization(pipelined && useUserSuppliedBuffers && userBufferSourceType == CPUBUFFER ? "pipelined" : "serial", execStats);
+
     // Freeing of snpe object
 
     // Terminate Logging
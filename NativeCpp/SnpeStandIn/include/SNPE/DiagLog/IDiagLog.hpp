@@ -0,0 +1,30 @@
+// DiagLog/IDiagLog.hpp – SNPE stand‑in: diagnostic log options (accepted, nothing logged)
+#ifndef STANDIN_IDIAGLOG_H
+#define STANDIN_IDIAGLOG_H
+
+#include <cstdint>
+#include <string>
+
+namespace zdl { namespace DiagLog {
+
+struct DiagLogOptions {
+    std::string DiagLogMask;
+    std::string LogFileDirectory = "diaglogs";
+    std::string LogFileName = "DiagLog";
+    uint32_t    LogFileRotateCount = 20;
+    bool        LogFileReplace = true;
+};
+
+class IDiagLog {
+public:
+    DiagLogOptions getOptions() const { return m_o; }
+    bool setOptions(const DiagLogOptions& o){ m_o = o; return true; }
+    bool start(){ return true; }
+    bool stop(){ return true; }
+private:
+    DiagLogOptions m_o;
+};
+
+}} // namespace zdl::DiagLog
+
+#endif // STANDIN_IDIAGLOG_H
@@ -0,0 +1,30 @@
+// DlContainer/IDlContainer.hpp – SNPE stand‑in: a model container is only its path here
+#ifndef STANDIN_IDLCONTAINER_H
+#define STANDIN_IDLCONTAINER_H
+
+#include <memory>
+#include <string>
+
+#include "DlSystem/String.hpp"
+
+namespace zdl { namespace DlContainer {
+
+// open() succeeds for any readable file; the model name the profile refers to is the
+// file name without directory and extension.
+class IDlContainer {
+public:
+    static std::unique_ptr<IDlContainer> open(const std::string& path) noexcept;
+    static std::unique_ptr<IDlContainer> open(const zdl::DlSystem::String& path) noexcept;
+    virtual ~IDlContainer() = default;
+    bool save(const std::string&){ return true; }   // init caches are not simulated
+    bool save(const char*){ return true; }
+    const std::string& path()  const { return m_path; }   // stand‑in only
+    const std::string& model() const { return m_model; }
+private:
+    IDlContainer(const std::string& path);
+    std::string m_path, m_model;
+};
+
+}} // namespace zdl::DlContainer
+
+#endif // STANDIN_IDLCONTAINER_H
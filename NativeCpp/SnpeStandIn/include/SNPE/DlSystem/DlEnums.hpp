@@ -0,0 +1,23 @@
+// DlSystem/DlEnums.hpp – SNPE stand‑in: runtime, performance‑profile and log‑level enums
+#ifndef STANDIN_DLENUMS_H
+#define STANDIN_DLENUMS_H
+
+namespace zdl { namespace DlSystem {
+
+enum class Runtime_t {
+    CPU_FLOAT32 = 0, GPU_FLOAT32_16_HYBRID = 1, DSP_FIXED8_TF = 2, GPU_FLOAT16 = 3, AIP_FIXED8_TF = 5,
+    CPU = CPU_FLOAT32, GPU = GPU_FLOAT32_16_HYBRID, DSP = DSP_FIXED8_TF, AIP_FIXED_TF = AIP_FIXED8_TF,
+    UNSET = -1
+};
+
+enum class PerformanceProfile_t {
+    DEFAULT = 0, BALANCED = 0, HIGH_PERFORMANCE, POWER_SAVER, SYSTEM_SETTINGS,
+    SUSTAINED_HIGH_PERFORMANCE, BURST, LOW_POWER_SAVER, HIGH_POWER_SAVER, LOW_BALANCED,
+    EXTREME_POWER_SAVER
+};
+
+enum class LogLevel_t { LOG_FATAL = 0, LOG_ERROR, LOG_WARN, LOG_INFO, LOG_VERBOSE };
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_DLENUMS_H
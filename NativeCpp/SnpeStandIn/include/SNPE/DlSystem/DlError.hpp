@@ -0,0 +1,11 @@
+// DlSystem/DlError.hpp – SNPE stand‑in: last error of the calling thread
+#ifndef STANDIN_DLERROR_H
+#define STANDIN_DLERROR_H
+
+namespace zdl { namespace DlSystem {
+
+const char* getLastErrorString();
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_DLERROR_H
@@ -0,0 +1,22 @@
+// DlSystem/DlOptional.hpp – SNPE stand‑in: value or nothing, as the SDK returns it
+#ifndef STANDIN_DLOPTIONAL_H
+#define STANDIN_DLOPTIONAL_H
+
+namespace zdl { namespace DlSystem {
+
+template<typename T> class Optional {
+public:
+    Optional() : m_v(), m_ok(false) {}
+    Optional(const T& v) : m_v(v), m_ok(true) {}
+    explicit operator bool() const { return m_ok; }
+    const T& operator*()  const { return m_v; }
+    T&       operator*()        { return m_v; }
+    const T* operator->() const { return &m_v; }
+    T*       operator->()       { return &m_v; }
+private:
+    T m_v; bool m_ok;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_DLOPTIONAL_H
@@ -0,0 +1,18 @@
+// DlSystem/DlVersion.hpp – SNPE stand‑in: library version
+#ifndef STANDIN_DLVERSION_H
+#define STANDIN_DLVERSION_H
+
+#include <string>
+
+namespace zdl { namespace DlSystem {
+
+struct Version_t {
+    int Major = 0, Minor = 0, Teeny = 0;
+    std::string Build = "standin";
+    std::string asString() const {
+        return std::to_string(Major)+"."+std::to_string(Minor)+"."+std::to_string(Teeny)+"."+Build; }
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_DLVERSION_H
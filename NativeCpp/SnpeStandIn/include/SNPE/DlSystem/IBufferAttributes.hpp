@@ -0,0 +1,29 @@
+// DlSystem/IBufferAttributes.hpp – SNPE stand‑in: dims and encoding of a network input or output
+#ifndef STANDIN_IBUFFERATTRIBUTES_H
+#define STANDIN_IBUFFERATTRIBUTES_H
+
+#include <cstddef>
+
+#include "DlSystem/IUserBuffer.hpp"
+#include "DlSystem/TensorShape.hpp"
+
+namespace zdl { namespace DlSystem {
+
+// The stand‑in networks are float; a TfN user buffer on them uses the encoding below,
+// which spans [0, 1) like the normalised inputs of the samples.
+class IBufferAttributes {
+public:
+    explicit IBufferAttributes(const TensorShape& dims) : m_dims(dims), m_tfn(0, 1.0f/255.0f) {}
+    virtual ~IBufferAttributes() = default;
+    size_t getElementSize() const { return sizeof(float); }
+    const TensorShape& getDims() const { return m_dims; }
+    UserBufferEncoding::ElementType_t getEncodingType() const { return UserBufferEncoding::ElementType_t::FLOAT; }
+    const UserBufferEncoding* getEncoding() const { return &m_tfn; }
+private:
+    TensorShape m_dims;
+    UserBufferEncodingTfN m_tfn;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_IBUFFERATTRIBUTES_H
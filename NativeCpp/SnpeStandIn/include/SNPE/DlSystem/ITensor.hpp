@@ -0,0 +1,37 @@
+// DlSystem/ITensor.hpp – SNPE stand‑in: float tensor owned by the library
+#ifndef STANDIN_ITENSOR_H
+#define STANDIN_ITENSOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "DlSystem/TensorShape.hpp"
+
+namespace zdl { namespace DlSystem {
+
+class ITensor {
+public:
+    using iterator       = float*;
+    using const_iterator = const float*;
+
+    explicit ITensor(const TensorShape& shape) : m_shape(shape), m_v(shape.elements()) {}
+    virtual ~ITensor() = default;
+
+    iterator begin() { return m_v.data(); }
+    iterator end()   { return m_v.data() + m_v.size(); }
+    const_iterator cbegin() const { return m_v.data(); }
+    const_iterator cend()   const { return m_v.data() + m_v.size(); }
+    const_iterator begin()  const { return cbegin(); }
+    const_iterator end()    const { return cend(); }
+
+    TensorShape getShape() const { return m_shape; }
+    size_t getSize() const { return m_v.size(); }
+    bool isQuantized() const { return false; }
+private:
+    TensorShape m_shape;
+    std::vector<float> m_v;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_ITENSOR_H
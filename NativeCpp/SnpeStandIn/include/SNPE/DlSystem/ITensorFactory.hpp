@@ -0,0 +1,22 @@
+// DlSystem/ITensorFactory.hpp – SNPE stand‑in: creates ITensors
+#ifndef STANDIN_ITENSORFACTORY_H
+#define STANDIN_ITENSORFACTORY_H
+
+#include <cstddef>
+#include <memory>
+
+#include "DlSystem/ITensor.hpp"
+#include "DlSystem/TensorShape.hpp"
+
+namespace zdl { namespace DlSystem {
+
+class ITensorFactory {
+public:
+    std::unique_ptr<ITensor> createTensor(const TensorShape& shape) noexcept;
+    // copies size bytes of float data, at most the tensor's size
+    std::unique_ptr<ITensor> createTensor(const TensorShape& shape, const unsigned char* data, size_t size) noexcept;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_ITENSORFACTORY_H
@@ -0,0 +1,75 @@
+// DlSystem/IUserBuffer.hpp – SNPE stand‑in: application memory the network reads or writes
+#ifndef STANDIN_IUSERBUFFER_H
+#define STANDIN_IUSERBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace zdl { namespace DlSystem {
+
+class UserBufferEncoding {
+public:
+    enum class ElementType_t { UNKNOWN = 0, FLOAT = 1, UNSIGNED8BIT = 2, TF8 = 10, TF16 = 11 };
+    explicit UserBufferEncoding(ElementType_t t) : m_type(t) {}
+    virtual ~UserBufferEncoding() = default;
+    ElementType_t getElementType() const { return m_type; }
+    virtual size_t getElementSize() const { return 1; }
+    virtual std::unique_ptr<UserBufferEncoding> clone() const = 0;   // stand‑in: buffers keep a copy
+protected:
+    ElementType_t m_type;
+};
+
+class UserBufferEncodingFloat : public UserBufferEncoding {
+public:
+    UserBufferEncodingFloat() : UserBufferEncoding(ElementType_t::FLOAT) {}
+    size_t getElementSize() const override { return sizeof(float); }
+    std::unique_ptr<UserBufferEncoding> clone() const override {
+        return std::unique_ptr<UserBufferEncoding>(new UserBufferEncodingFloat(*this)); }
+};
+
+// real = (q - stepExactly0) * quantizedStepSize
+class UserBufferEncodingTfN : public UserBufferEncoding {
+public:
+    UserBufferEncodingTfN(uint64_t stepFor0, float stepSize, uint8_t bitWidth = 8)
+        : UserBufferEncoding(bitWidth == 16 ? ElementType_t::TF16 : ElementType_t::TF8),
+          m_step0(stepFor0), m_stepSize(stepSize), m_bits(bitWidth) {}
+    size_t   getElementSize() const override { return m_bits/8; }
+    uint64_t getStepExactly0() const { return m_step0; }
+    void     setStepExactly0(uint64_t s){ m_step0 = s; }
+    float    getQuantizedStepSize() const { return m_stepSize; }
+    void     setQuantizedStepSize(float s){ m_stepSize = s; }
+    float    getMin() const { return -float(m_step0)*m_stepSize; }
+    float    getMax() const { return (float((1u << m_bits) - 1) - float(m_step0))*m_stepSize; }
+    std::unique_ptr<UserBufferEncoding> clone() const override {
+        return std::unique_ptr<UserBufferEncoding>(new UserBufferEncodingTfN(*this)); }
+private:
+    uint64_t m_step0; float m_stepSize; uint8_t m_bits;
+};
+
+class UserBufferSource { public: virtual ~UserBufferSource() = default; };
+class UserBufferSourceGLBuffer : public UserBufferSource {};
+
+class IUserBuffer {
+public:
+    IUserBuffer(void* addr, size_t size, std::vector<size_t> strides, const UserBufferEncoding& enc)
+        : m_addr(addr), m_size(size), m_strides(std::move(strides)), m_enc(enc.clone()) {}
+    virtual ~IUserBuffer() = default;
+
+    size_t getSize() const { return m_size; }
+    size_t getOutputSize() const { return m_size; }
+    bool   setBufferAddress(void* addr){ m_addr = addr; return true; }
+    const std::vector<size_t>& getStrides() const { return m_strides; }
+    UserBufferEncoding&       getEncoding()       { return *m_enc; }
+    const UserBufferEncoding& getEncoding() const { return *m_enc; }
+    void* address() const { return m_addr; }                         // stand‑in only
+private:
+    void* m_addr; size_t m_size;
+    std::vector<size_t> m_strides;
+    std::unique_ptr<UserBufferEncoding> m_enc;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_IUSERBUFFER_H
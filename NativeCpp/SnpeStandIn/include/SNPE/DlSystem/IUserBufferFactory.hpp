@@ -0,0 +1,24 @@
+// DlSystem/IUserBufferFactory.hpp – SNPE stand‑in: wraps application memory as IUserBuffer
+#ifndef STANDIN_IUSERBUFFERFACTORY_H
+#define STANDIN_IUSERBUFFERFACTORY_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "DlSystem/IUserBuffer.hpp"
+
+namespace zdl { namespace DlSystem {
+
+class IUserBufferFactory {
+public:
+    // null if the strides are empty or do not fit into bufSize bytes
+    std::unique_ptr<IUserBuffer> createUserBuffer(void* buffer, size_t bufSize, const std::vector<size_t>& strides,
+                                                  UserBufferEncoding* encoding) noexcept;
+    std::unique_ptr<IUserBuffer> createUserBuffer(void* buffer, size_t bufSize, const std::vector<size_t>& strides,
+                                                  UserBufferEncoding* encoding, UserBufferSource* source) noexcept;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_IUSERBUFFERFACTORY_H
@@ -0,0 +1,21 @@
+// DlSystem/PlatformConfig.hpp – SNPE stand‑in: platform options (accepted, ignored)
+#ifndef STANDIN_PLATFORMCONFIG_H
+#define STANDIN_PLATFORMCONFIG_H
+
+#include <string>
+
+namespace zdl { namespace DlSystem {
+
+class PlatformConfig {
+public:
+    void SetIsUserGLBuffer(bool b){ m_gl = b; }
+    bool GetIsUserGLBuffer() const { return m_gl; }
+    bool setPlatformOptions(const std::string& o){ m_opts = o; return true; }
+    std::string getPlatformOptions() const { return m_opts; }
+private:
+    bool m_gl = false; std::string m_opts;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_PLATFORMCONFIG_H
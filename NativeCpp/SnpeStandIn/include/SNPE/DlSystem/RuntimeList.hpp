@@ -0,0 +1,30 @@
+// DlSystem/RuntimeList.hpp – SNPE stand‑in: runtime preference order
+#ifndef STANDIN_RUNTIMELIST_H
+#define STANDIN_RUNTIMELIST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "DlSystem/DlEnums.hpp"
+
+namespace zdl { namespace DlSystem {
+
+class RuntimeList {
+public:
+    bool add(Runtime_t rt){
+        for(Runtime_t r : m_rt) if(r == rt) return false;
+        m_rt.push_back(rt); return true;
+    }
+    void clear(){ m_rt.clear(); }
+    bool empty() const { return m_rt.empty(); }
+    size_t size() const { return m_rt.size(); }
+    Runtime_t operator[](size_t i) const { return m_rt[i]; }
+    static Runtime_t stringToRuntime(const char* s);
+    static const char* runtimeToString(Runtime_t rt);
+private:
+    std::vector<Runtime_t> m_rt;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_RUNTIMELIST_H
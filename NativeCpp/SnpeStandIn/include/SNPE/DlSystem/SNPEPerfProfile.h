@@ -0,0 +1,7 @@
+// DlSystem/SNPEPerfProfile.h – SNPE stand‑in: PerformanceProfile_t lives in DlEnums.hpp
+#ifndef STANDIN_SNPEPERFPROFILE_H
+#define STANDIN_SNPEPERFPROFILE_H
+
+#include "DlSystem/DlEnums.hpp"
+
+#endif // STANDIN_SNPEPERFPROFILE_H
@@ -0,0 +1,20 @@
+// DlSystem/String.hpp – SNPE stand‑in: owned C string
+#ifndef STANDIN_STRING_H
+#define STANDIN_STRING_H
+
+#include <string>
+
+namespace zdl { namespace DlSystem {
+
+class String {
+public:
+    explicit String(const char* s) : m_s(s ? s : "") {}
+    explicit String(const std::string& s) : m_s(s) {}
+    const char* c_str() const { return m_s.c_str(); }
+private:
+    std::string m_s;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_STRING_H
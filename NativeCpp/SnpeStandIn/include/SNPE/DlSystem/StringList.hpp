@@ -0,0 +1,30 @@
+// DlSystem/StringList.hpp – SNPE stand‑in: list of names, iterated as const char*
+#ifndef STANDIN_STRINGLIST_H
+#define STANDIN_STRINGLIST_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace zdl { namespace DlSystem {
+
+class StringList {
+public:
+    StringList() = default;
+    StringList(const StringList& o) : m_s(o.m_s) { index(); }
+    StringList& operator=(const StringList& o){ m_s = o.m_s; index(); return *this; }
+
+    void append(const char* s){ m_s.push_back(s); index(); }
+    size_t size() const { return m_s.size(); }
+    const char* at(size_t i) const { return m_p.at(i); }
+    const char* const* begin() const { return m_p.data(); }
+    const char* const* end()   const { return m_p.data() + m_p.size(); }
+private:
+    void index(){ m_p.clear(); for(const auto& s : m_s) m_p.push_back(s.c_str()); }
+    std::vector<std::string> m_s;
+    std::vector<const char*> m_p;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_STRINGLIST_H
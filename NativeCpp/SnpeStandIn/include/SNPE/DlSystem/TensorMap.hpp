@@ -0,0 +1,37 @@
+// DlSystem/TensorMap.hpp – SNPE stand‑in: tensors by name (not owned)
+#ifndef STANDIN_TENSORMAP_H
+#define STANDIN_TENSORMAP_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DlSystem/ITensor.hpp"
+#include "DlSystem/StringList.hpp"
+
+namespace zdl { namespace DlSystem {
+
+class TensorMap {
+public:
+    void add(const char* name, ITensor* t){
+        for(auto& kv : m_t) if(kv.first == name){ kv.second = t; return; }
+        m_t.emplace_back(name, t);
+    }
+    void remove(const char* name){
+        for(auto it = m_t.begin(); it != m_t.end(); ++it) if(it->first == name){ m_t.erase(it); return; }
+    }
+    ITensor* getTensor(const char* name) const {
+        for(const auto& kv : m_t) if(kv.first == name) return kv.second;
+        return nullptr;
+    }
+    StringList getTensorNames() const { StringList l; for(const auto& kv : m_t) l.append(kv.first.c_str()); return l; }
+    size_t size() const { return m_t.size(); }
+    void clear(){ m_t.clear(); }
+private:
+    std::vector<std::pair<std::string, ITensor*>> m_t;   // insertion (network) order
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_TENSORMAP_H
@@ -0,0 +1,33 @@
+// DlSystem/TensorShape.hpp – SNPE stand‑in: tensor dimensions
+#ifndef STANDIN_TENSORSHAPE_H
+#define STANDIN_TENSORSHAPE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace zdl { namespace DlSystem {
+
+using Dimension = size_t;
+
+class TensorShape {
+public:
+    TensorShape() = default;
+    TensorShape(std::initializer_list<Dimension> d) : m_d(d) {}
+    TensorShape(const Dimension* d, size_t rank) : m_d(d, d + rank) {}
+    explicit TensorShape(const std::vector<Dimension>& d) : m_d(d) {}
+
+    void concatenate(const Dimension* d, size_t n){ m_d.insert(m_d.end(), d, d + n); }
+    void concatenate(const Dimension& d){ m_d.push_back(d); }
+    const Dimension* getDimensions() const { return m_d.data(); }
+    size_t rank() const { return m_d.size(); }
+    const Dimension& operator[](size_t i) const { return m_d[i]; }
+    Dimension& operator[](size_t i) { return m_d[i]; }
+    size_t elements() const { size_t n = 1; for(Dimension d : m_d) n *= d; return n; }   // stand‑in only
+private:
+    std::vector<Dimension> m_d;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_TENSORSHAPE_H
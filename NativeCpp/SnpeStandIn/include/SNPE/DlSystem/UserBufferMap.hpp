@@ -0,0 +1,37 @@
+// DlSystem/UserBufferMap.hpp – SNPE stand‑in: user buffers by name (not owned)
+#ifndef STANDIN_USERBUFFERMAP_H
+#define STANDIN_USERBUFFERMAP_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DlSystem/IUserBuffer.hpp"
+#include "DlSystem/StringList.hpp"
+
+namespace zdl { namespace DlSystem {
+
+class UserBufferMap {
+public:
+    void add(const char* name, IUserBuffer* b){
+        for(auto& kv : m_b) if(kv.first == name){ kv.second = b; return; }
+        m_b.emplace_back(name, b);
+    }
+    void remove(const char* name){
+        for(auto it = m_b.begin(); it != m_b.end(); ++it) if(it->first == name){ m_b.erase(it); return; }
+    }
+    IUserBuffer* getUserBuffer(const char* name) const {
+        for(const auto& kv : m_b) if(kv.first == name) return kv.second;
+        return nullptr;
+    }
+    StringList getUserBufferNames() const { StringList l; for(const auto& kv : m_b) l.append(kv.first.c_str()); return l; }
+    size_t size() const { return m_b.size(); }
+    void clear(){ m_b.clear(); }
+private:
+    std::vector<std::pair<std::string, IUserBuffer*>> m_b;
+};
+
+}} // namespace zdl::DlSystem
+
+#endif // STANDIN_USERBUFFERMAP_H
@@ -0,0 +1,56 @@
+// SNPE/SNPE.hpp – SNPE stand‑in: a built network; execute() goes to a standin::Executor
+#ifndef STANDIN_SNPE_H
+#define STANDIN_SNPE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DiagLog/IDiagLog.hpp"
+#include "DlSystem/DlEnums.hpp"
+#include "DlSystem/DlOptional.hpp"
+#include "DlSystem/IBufferAttributes.hpp"
+#include "DlSystem/ITensor.hpp"
+#include "DlSystem/StringList.hpp"
+#include "DlSystem/TensorMap.hpp"
+#include "DlSystem/TensorShape.hpp"
+#include "DlSystem/UserBufferMap.hpp"
+#include "StandIn/Executor.hpp"
+
+namespace zdl { namespace SNPE {
+
+class SNPE {
+public:
+    ~SNPE();
+    zdl::DlSystem::Optional<zdl::DlSystem::StringList> getInputTensorNames() const noexcept;
+    zdl::DlSystem::Optional<zdl::DlSystem::StringList> getOutputTensorNames() const noexcept;
+    zdl::DlSystem::TensorShape getInputDimensions() const noexcept;            // first input
+    zdl::DlSystem::Optional<zdl::DlSystem::TensorShape> getInputDimensions(const char* name) const noexcept;
+    zdl::DlSystem::Optional<zdl::DlSystem::IBufferAttributes*> getInputOutputBufferAttributes(const char* name) const noexcept;
+    zdl::DlSystem::Optional<zdl::DiagLog::IDiagLog*> getDiagLogInterface() noexcept { return &m_diag; }
+
+    // ITensor mode: the outputs are tensors owned by this instance, valid until the next execute()
+    bool execute(const zdl::DlSystem::ITensor* input, zdl::DlSystem::TensorMap& output) noexcept;
+    bool execute(const zdl::DlSystem::TensorMap& input, zdl::DlSystem::TensorMap& output) noexcept;
+    // user‑buffer mode (setUseUserSuppliedBuffers): every input and output must be mapped
+    bool execute(const zdl::DlSystem::UserBufferMap& input, const zdl::DlSystem::UserBufferMap& output) noexcept;
+
+private:
+    friend class SNPEBuilder;
+    SNPE(std::string model, zdl::DlSystem::Runtime_t rt, bool userBuffers,
+         standin::NetworkShape shape, std::shared_ptr<standin::Executor> exec);
+    bool run(standin::Call& call);
+
+    std::string m_model;
+    zdl::DlSystem::Runtime_t m_rt;
+    bool m_userBuffers;
+    standin::NetworkShape m_shape;
+    std::shared_ptr<standin::Executor> m_exec;
+    std::vector<std::unique_ptr<zdl::DlSystem::IBufferAttributes>> m_attr;   // inputs, then outputs
+    std::vector<std::unique_ptr<zdl::DlSystem::ITensor>> m_out;
+    zdl::DiagLog::IDiagLog m_diag;
+};
+
+}} // namespace zdl::SNPE
+
+#endif // STANDIN_SNPE_H
@@ -0,0 +1,42 @@
+// SNPE/SNPEBuilder.hpp – SNPE stand‑in: builds a network on the first available runtime
+#ifndef STANDIN_SNPEBUILDER_H
+#define STANDIN_SNPEBUILDER_H
+
+#include <memory>
+
+#include "DlContainer/IDlContainer.hpp"
+#include "DlSystem/DlEnums.hpp"
+#include "DlSystem/PlatformConfig.hpp"
+#include "DlSystem/RuntimeList.hpp"
+#include "DlSystem/StringList.hpp"
+#include "SNPE/SNPE.hpp"
+
+namespace zdl { namespace SNPE {
+
+class SNPEBuilder {
+public:
+    explicit SNPEBuilder(zdl::DlContainer::IDlContainer* container) : m_container(container) {}
+
+    SNPEBuilder& setRuntimeProcessor(zdl::DlSystem::Runtime_t rt){ m_rts.clear(); m_rts.add(rt); return *this; }
+    SNPEBuilder& setRuntimeProcessorOrder(const zdl::DlSystem::RuntimeList& l){ m_rts = l; return *this; }
+    SNPEBuilder& setUseUserSuppliedBuffers(bool b){ m_userBuffers = b; return *this; }
+    // accepted and ignored
+    SNPEBuilder& setOutputLayers(const zdl::DlSystem::StringList&){ return *this; }
+    SNPEBuilder& setPlatformConfig(const zdl::DlSystem::PlatformConfig&){ return *this; }
+    SNPEBuilder& setInitCacheMode(bool){ return *this; }
+    SNPEBuilder& setCpuFixedPointMode(bool){ return *this; }
+    SNPEBuilder& setPerformanceProfile(zdl::DlSystem::PerformanceProfile_t){ return *this; }
+    SNPEBuilder& setDebugMode(bool){ return *this; }
+
+    // null if no runtime of the order is available or the executor does not know the model
+    std::unique_ptr<SNPE> build() noexcept;
+
+private:
+    zdl::DlContainer::IDlContainer* m_container;
+    zdl::DlSystem::RuntimeList m_rts;
+    bool m_userBuffers = false;
+};
+
+}} // namespace zdl::SNPE
+
+#endif // STANDIN_SNPEBUILDER_H
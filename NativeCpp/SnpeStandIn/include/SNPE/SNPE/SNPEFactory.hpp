@@ -0,0 +1,32 @@
+// SNPE/SNPEFactory.hpp – SNPE stand‑in: library entry points
+#ifndef STANDIN_SNPEFACTORY_H
+#define STANDIN_SNPEFACTORY_H
+
+#include <string>
+
+#include "DlSystem/DlEnums.hpp"
+#include "DlSystem/DlVersion.hpp"
+#include "DlSystem/ITensorFactory.hpp"
+#include "DlSystem/IUserBufferFactory.hpp"
+
+namespace zdl { namespace SNPE {
+
+class SNPEFactory {
+public:
+    // as the executor reports; the default profile offers CPU, GPU and DSP
+    static bool isRuntimeAvailable(zdl::DlSystem::Runtime_t rt);
+    static bool isRuntimeAvailable(zdl::DlSystem::Runtime_t rt, int /*checkOption*/){ return isRuntimeAvailable(rt); }
+    static zdl::DlSystem::ITensorFactory&     getTensorFactory();
+    static zdl::DlSystem::IUserBufferFactory& getUserBufferFactory();
+    static zdl::DlSystem::Version_t getLibraryVersion();
+    static bool isGLCLInteropSupported(){ return false; }
+    static bool addOpPackage(const std::string&){ return true; }    // UDOs are not simulated
+    static bool initializeLogging(const zdl::DlSystem::LogLevel_t& level);
+    static bool initializeLogging(const zdl::DlSystem::LogLevel_t& level, const std::string& logPath);
+    static bool setLogLevel(const zdl::DlSystem::LogLevel_t& level);
+    static bool terminateLogging();
+};
+
+}} // namespace zdl::SNPE
+
+#endif // STANDIN_SNPEFACTORY_H
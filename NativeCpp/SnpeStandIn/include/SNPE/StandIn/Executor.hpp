@@ -0,0 +1,57 @@
+// StandIn/Executor.hpp – what a stand‑in SNPE instance runs its networks on
+#ifndef STANDIN_EXECUTOR_H
+#define STANDIN_EXECUTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DlSystem/DlEnums.hpp"
+#include "DlSystem/TensorShape.hpp"
+
+namespace standin {
+
+using zdl::DlSystem::Runtime_t;
+using zdl::DlSystem::TensorShape;
+
+// Inputs and outputs of a network, in network order.
+struct NetworkShape {
+    std::vector<std::pair<std::string, TensorShape>> inputs, outputs;
+};
+
+// One tensor of an execute(): elements of elementSize bytes at data (float, or 8/16‑bit
+// TfN for quantized user buffers, with value = (q - step0)*stepSize).
+struct Buffer {
+    const char* name; void* data; size_t bytes; size_t elementSize;
+    uint64_t step0; float stepSize;
+};
+struct Call {
+    const std::string& model; Runtime_t runtime;
+    std::vector<Buffer> inputs, outputs;
+};
+
+// The stand‑in backend: SNPEFactory, SNPEBuilder and SNPE implement the SDK calls the
+// samples make and leave what a network is and how long it takes to the executor.
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual bool available(Runtime_t rt) = 0;
+    // Network of the model (container file name without directory and extension) on rt;
+    // false fails SNPEBuilder::build() as an unsupported network would.
+    virtual bool describe(const std::string& model, Runtime_t rt, NetworkShape& shape) = 0;
+    // Fills the outputs, taking as long as the runtime would. Called on the application's
+    // thread, possibly concurrently for different SNPE instances.
+    virtual bool execute(const Call& call) = 0;
+};
+
+// The executor of every SNPE built from now on; null restores the default, a
+// ProfileExecutor configured from $SNPE_STANDIN_PROFILE.
+void setExecutor(std::shared_ptr<Executor> e);
+std::shared_ptr<Executor> currentExecutor();
+
+}  // namespace standin
+
+#endif // STANDIN_EXECUTOR_H
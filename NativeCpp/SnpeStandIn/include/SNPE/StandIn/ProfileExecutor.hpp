@@ -0,0 +1,62 @@
+// StandIn/ProfileExecutor.hpp – default stand‑in executor: networks, latency distributions
+//                               and memory traffic from a text profile
+#ifndef STANDIN_PROFILEEXECUTOR_H
+#define STANDIN_PROFILEEXECUTOR_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "StandIn/Executor.hpp"
+
+namespace standin {
+
+// Profile lines (# starts a comment; MODEL and RUNTIME may be *, the most specific rule wins):
+//
+//   runtimes  CPU GPU DSP                        available runtimes (default all three)
+//   seed      N                                  latency sampling (default 1)
+//   network   MODEL in NAME=DxDx… [NAME=…] out NAME=DxDx… [NAME=…]
+//   latency   MODEL RUNTIME const MS | uniform LO HI | normal MEAN SD | lognormal MEAN SD | exp MEAN
+//   work      MODEL RUNTIME MIB [spin]           stream MIB MiB through memory per execute(); spin
+//                                                busy‑waits the rest of the latency instead of sleeping
+//   exclusive RUNTIME…                           one execute() at a time (default GPU DSP)
+//
+// Without a matching network line a model has one input "input" 1x224x224x3 and one output
+// "output" 1x1000; without a latency rule CPU, GPU and DSP take normal 40/4, 15/1.5, 8/0.8 ms.
+// The outputs are a cheap function of the inputs, so top‑1 results vary with the frame.
+class ProfileExecutor : public Executor {
+public:
+    ProfileExecutor();
+    bool load(std::istream& in, std::string* error = nullptr);      // adds to the rules so far
+    bool loadFile(const std::string& path, std::string* error = nullptr);
+
+    bool available(Runtime_t rt) override;
+    bool describe(const std::string& model, Runtime_t rt, NetworkShape& shape) override;
+    bool execute(const Call& call) override;
+
+private:
+    enum class Dist { CONST, UNIFORM, NORMAL, LOGNORMAL, EXP };
+    struct Latency { std::string model; int rt; Dist dist; double a, b; };   // rt < 0 = any
+    struct Work    { std::string model; int rt; double mib; bool spin; };
+    struct Network { std::string model; NetworkShape shape; };
+
+    template<class R> const R* match(const std::vector<R>& rules, const std::string& model, int rt) const;
+    double sampleMs(const Latency& l);
+
+    std::array<bool,3> m_avail{{true,true,true}};                   // 0=CPU 1=GPU 2=DSP
+    std::array<bool,3> m_exclusive{{false,true,true}};
+    std::vector<Latency> m_lat;
+    std::vector<Work>    m_work;
+    std::vector<Network> m_net;
+    std::mutex   m_rngM;
+    std::mt19937 m_rng;
+    std::array<std::mutex,3> m_accel;                               // exclusive runtimes
+};
+
+}  // namespace standin
+
+#endif // STANDIN_PROFILEEXECUTOR_H
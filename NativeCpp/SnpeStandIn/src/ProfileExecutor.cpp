@@ -0,0 +1,232 @@
+// ProfileExecutor.cpp – default stand‑in executor
+#include "StandIn/ProfileExecutor.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace standin {
+
+using Clock = std::chrono::steady_clock;
+
+/* helpers -------------------------------------------------------------------------- */
+static int rtIndex(Runtime_t rt)
+{
+    switch(rt){
+        case Runtime_t::CPU:         return 0;
+        case Runtime_t::GPU:
+        case Runtime_t::GPU_FLOAT16: return 1;
+        case Runtime_t::DSP:         return 2;
+        default:                     return -1;
+    }
+}
+static int rtIndex(const std::string& s)                  // * = -1, unknown = -2
+{
+    if(s == "*") return -1;
+    std::string u(s); for(auto& c : u) c = char(std::toupper(static_cast<unsigned char>(c)));
+    return u == "CPU" ? 0 : u == "GPU" ? 1 : u == "DSP" ? 2 : -2;
+}
+static bool parseDims(const std::string& s, TensorShape& shape)   // 1x224x224x3
+{
+    std::vector<size_t> d;
+    std::stringstream ss(s);
+    for(std::string x; std::getline(ss, x, 'x'); ){
+        char* end = nullptr;
+        const unsigned long v = std::strtoul(x.c_str(), &end, 10);
+        if(x.empty() || *end || v == 0) return false;
+        d.push_back(v);
+    }
+    if(d.empty()) return false;
+    shape = TensorShape(d);
+    return true;
+}
+
+// element i of a buffer as a real value, and back
+static float readElem(const Buffer& b, size_t i)
+{
+    if(b.elementSize == sizeof(float)) return static_cast<const float*>(b.data)[i];
+    const double q = b.elementSize == 2 ? static_cast<const uint16_t*>(b.data)[i] : static_cast<const uint8_t*>(b.data)[i];
+    return float((q - double(b.step0))*b.stepSize);
+}
+static void writeElem(const Buffer& b, size_t i, float v)
+{
+    if(b.elementSize == sizeof(float)){ static_cast<float*>(b.data)[i] = v; return; }
+    const double top = b.elementSize == 2 ? 65535.0 : 255.0;
+    const double q = std::min(top, std::max(0.0, std::round(v/(b.stepSize > 0.0f ? b.stepSize : 1.0f) + double(b.step0))));
+    if(b.elementSize == 2) static_cast<uint16_t*>(b.data)[i] = uint16_t(q);
+    else                   static_cast<uint8_t*>(b.data)[i]  = uint8_t(q);
+}
+
+/* ProfileExecutor ------------------------------------------------------------------ */
+ProfileExecutor::ProfileExecutor() : m_rng(1)
+{
+    m_lat.push_back({ "*", 0, Dist::NORMAL, 40.0, 4.0 });
+    m_lat.push_back({ "*", 1, Dist::NORMAL, 15.0, 1.5 });
+    m_lat.push_back({ "*", 2, Dist::NORMAL,  8.0, 0.8 });
+}
+
+bool ProfileExecutor::loadFile(const std::string& path, std::string* error)
+{
+    std::ifstream f(path);
+    if(!f){ if(error) *error = "cannot open "+path; return false; }
+    return load(f, error);
+}
+
+bool ProfileExecutor::load(std::istream& in, std::string* error)
+{
+    int no = 0;
+    auto fail = [&](const std::string& why){ if(error) *error = "line "+std::to_string(no)+": "+why; return false; };
+    for(std::string line; std::getline(in, line); ){
+        ++no;
+        line = line.substr(0, line.find('#'));
+        std::stringstream ss(line);
+        std::vector<std::string> f;
+        for(std::string w; ss >> w; ) f.push_back(w);
+        if(f.empty()) continue;
+
+        if(f[0] == "runtimes" || f[0] == "exclusive"){
+            std::array<bool,3> on{{false,false,false}};
+            for(size_t i = 1; i < f.size(); ++i){
+                const int r = rtIndex(f[i]);
+                if(r < 0) return fail("unknown runtime "+f[i]);
+                on[r] = true;
+            }
+            (f[0] == "runtimes" ? m_avail : m_exclusive) = on;
+        }
+        else if(f[0] == "seed" && f.size() == 2){
+            std::lock_guard<std::mutex> lk(m_rngM);
+            m_rng.seed(uint32_t(std::strtoul(f[1].c_str(), nullptr, 0)));
+        }
+        else if(f[0] == "network" && f.size() >= 2){
+            Network n; n.model = f[1];
+            std::vector<std::pair<std::string, TensorShape>>* to = nullptr;
+            for(size_t i = 2; i < f.size(); ++i){
+                if(f[i] == "in"){ to = &n.shape.inputs; continue; }
+                if(f[i] == "out"){ to = &n.shape.outputs; continue; }
+                const size_t eq = f[i].find('=');
+                TensorShape d;
+                if(!to || eq == std::string::npos || eq == 0 || !parseDims(f[i].substr(eq+1), d))
+                    return fail("expected in|out NAME=DxDx…, got "+f[i]);
+                to->emplace_back(f[i].substr(0, eq), d);
+            }
+            if(n.shape.inputs.empty() || n.shape.outputs.empty()) return fail("network needs inputs and outputs");
+            m_net.push_back(n);
+        }
+        else if(f[0] == "latency" && f.size() >= 5){
+            Latency l{ f[1], rtIndex(f[2]), Dist::CONST, std::atof(f[4].c_str()), 0.0 };
+            if(l.rt < -1) return fail("unknown runtime "+f[2]);
+            const std::string& d = f[3];
+            const size_t args = d == "const" || d == "exp" ? 1 : 2;
+            if(f.size() != 4 + args) return fail("wrong number of arguments for "+d);
+            if(args == 2) l.b = std::atof(f[5].c_str());
+            if     (d == "const")     l.dist = Dist::CONST;
+            else if(d == "uniform")   l.dist = Dist::UNIFORM;
+            else if(d == "normal")    l.dist = Dist::NORMAL;
+            else if(d == "lognormal") l.dist = Dist::LOGNORMAL;
+            else if(d == "exp")       l.dist = Dist::EXP;
+            else return fail("unknown distribution "+d);
+            if(l.a < 0.0 || l.b < 0.0 || (l.dist == Dist::LOGNORMAL && l.a <= 0.0)) return fail("negative latency");
+            m_lat.push_back(l);
+        }
+        else if(f[0] == "work" && (f.size() == 4 || (f.size() == 5 && f[4] == "spin"))){
+            Work w{ f[1], rtIndex(f[2]), std::atof(f[3].c_str()), f.size() == 5 };
+            if(w.rt < -1) return fail("unknown runtime "+f[2]);
+            if(w.mib < 0.0) return fail("negative working set");
+            m_work.push_back(w);
+        }
+        else return fail("cannot parse \""+line+"\"");
+    }
+    return true;
+}
+
+// most specific rule: exact model before *, exact runtime before *, later lines first
+template<class R> const R* ProfileExecutor::match(const std::vector<R>& rules, const std::string& model, int rt) const
+{
+    const R* best = nullptr; int bestScore = -1;
+    for(const R& r : rules){
+        const bool mOk = r.model == "*" || r.model == model, rOk = r.rt < 0 || r.rt == rt;
+        if(!mOk || !rOk) continue;
+        const int score = (r.model != "*")*2 + (r.rt >= 0);
+        if(score >= bestScore){ best = &r; bestScore = score; }
+    }
+    return best;
+}
+
+double ProfileExecutor::sampleMs(const Latency& l)
+{
+    std::lock_guard<std::mutex> lk(m_rngM);
+    switch(l.dist){
+        case Dist::CONST:   return l.a;
+        case Dist::UNIFORM: return std::uniform_real_distribution<double>(std::min(l.a,l.b), std::max(l.a,l.b))(m_rng);
+        case Dist::NORMAL:  return std::max(0.0, std::normal_distribution<double>(l.a, l.b)(m_rng));
+        case Dist::EXP:     return l.a > 0.0 ? std::exponential_distribution<double>(1.0/l.a)(m_rng) : 0.0;
+        case Dist::LOGNORMAL:{                                // parameters are the mean and sd of the result
+            const double s2 = std::log1p((l.b*l.b)/(l.a*l.a));
+            return std::lognormal_distribution<double>(std::log(l.a) - 0.5*s2, std::sqrt(s2))(m_rng);
+        }
+    }
+    return l.a;
+}
+
+bool ProfileExecutor::available(Runtime_t rt)
+{
+    const int r = rtIndex(rt);
+    return r >= 0 && m_avail[r];
+}
+
+bool ProfileExecutor::describe(const std::string& model, Runtime_t rt, NetworkShape& shape)
+{
+    if(!available(rt)) return false;
+    for(auto it = m_net.rbegin(); it != m_net.rend(); ++it)
+        if(it->model == model){ shape = it->shape; return true; }
+    for(auto it = m_net.rbegin(); it != m_net.rend(); ++it)
+        if(it->model == "*"){ shape = it->shape; return true; }
+    shape = NetworkShape();
+    shape.inputs.emplace_back("input", TensorShape{ 1, 224, 224, 3 });
+    shape.outputs.emplace_back("output", TensorShape{ 1, 1000 });
+    return true;
+}
+
+bool ProfileExecutor::execute(const Call& call)
+{
+    const int r = rtIndex(call.runtime);
+    if(r < 0) return false;
+    const Latency* lat = match(m_lat, call.model, r);
+    const Work*    wk  = match(m_work, call.model, r);
+
+    // an exclusive runtime serves one call at a time: its latency starts once it is ours
+    std::unique_lock<std::mutex> accel(m_accel[r], std::defer_lock);
+    if(m_exclusive[r]) accel.lock();
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                              std::chrono::duration<double, std::milli>(lat ? sampleMs(*lat) : 0.0));
+
+    // memory traffic: read one half of a private working set and write it to the other
+    if(wk && wk->mib > 0.0){
+        thread_local std::vector<char> ws;
+        const size_t n = size_t(wk->mib*1048576.0) & ~size_t(63);
+        if(ws.size() != n) ws.assign(n, 1);
+        std::memcpy(ws.data() + n/2, ws.data(), n/2);
+        std::memcpy(ws.data(), ws.data() + n/2, n/2);
+    }
+
+    // outputs: a scrambled gather of the first input, so they depend on the frame
+    const Buffer* src = call.inputs.empty() ? nullptr : &call.inputs[0];
+    const size_t nIn = src && src->elementSize ? src->bytes/src->elementSize : 0;
+    for(const Buffer& o : call.outputs){
+        const size_t nOut = o.elementSize ? o.bytes/o.elementSize : 0;
+        for(size_t i = 0; i < nOut; ++i)
+            writeElem(o, i, nIn ? readElem(*src, (i*2654435761u) % nIn) : 0.0f);
+    }
+
+    if(wk && wk->spin) while(Clock::now() < deadline) {}
+    else std::this_thread::sleep_until(deadline);
+    return true;
+}
+
+}  // namespace standin
@@ -0,0 +1,266 @@
+// StandIn.cpp – SNPE stand‑in: factories, builder and the SNPE instance
+#include "DlContainer/IDlContainer.hpp"
+#include "DlSystem/DlError.hpp"
+#include "DlSystem/ITensorFactory.hpp"
+#include "DlSystem/IUserBufferFactory.hpp"
+#include "DlSystem/RuntimeList.hpp"
+#include "SNPE/SNPE.hpp"
+#include "SNPE/SNPEBuilder.hpp"
+#include "SNPE/SNPEFactory.hpp"
+#include "StandIn/ProfileExecutor.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+#include <unistd.h>
+
+/* executor registry ---------------------------------------------------------------- */
+namespace standin {
+
+static std::mutex gExecM;
+static std::shared_ptr<Executor> gExec;
+
+static std::shared_ptr<Executor> defaultExecutor()
+{
+    std::shared_ptr<ProfileExecutor> p(new ProfileExecutor);
+    if(const char* path = std::getenv("SNPE_STANDIN_PROFILE")){
+        std::string err;
+        if(!p->loadFile(path, &err)) std::cerr<<"SNPE stand‑in: "<<path<<": "<<err<<"\n";
+    }
+    return p;
+}
+
+void setExecutor(std::shared_ptr<Executor> e)
+{
+    std::lock_guard<std::mutex> lk(gExecM);
+    gExec = e ? e : defaultExecutor();
+}
+std::shared_ptr<Executor> currentExecutor()
+{
+    std::lock_guard<std::mutex> lk(gExecM);
+    if(!gExec) gExec = defaultExecutor();
+    return gExec;
+}
+
+}  // namespace standin
+
+namespace zdl {
+
+namespace DlSystem {
+
+static thread_local std::string gLastError;
+static void setError(const std::string& e){ gLastError = e; }
+const char* getLastErrorString(){ return gLastError.c_str(); }
+
+/* tensors and user buffers --------------------------------------------------------- */
+std::unique_ptr<ITensor> ITensorFactory::createTensor(const TensorShape& shape) noexcept
+{
+    return std::unique_ptr<ITensor>(new ITensor(shape));
+}
+std::unique_ptr<ITensor> ITensorFactory::createTensor(const TensorShape& shape, const unsigned char* data, size_t size) noexcept
+{
+    std::unique_ptr<ITensor> t(new ITensor(shape));
+    if(data) std::memcpy(&*t->begin(), data, std::min(size, t->getSize()*sizeof(float)));
+    return t;
+}
+
+std::unique_ptr<IUserBuffer> IUserBufferFactory::createUserBuffer(void* buffer, size_t bufSize, const std::vector<size_t>& strides,
+                                                                  UserBufferEncoding* encoding) noexcept
+{
+    if(!encoding || strides.empty() || strides.back() != encoding->getElementSize() || strides.front() > bufSize){
+        setError("createUserBuffer: strides do not match the encoding or the buffer size");
+        return nullptr;
+    }
+    return std::unique_ptr<IUserBuffer>(new IUserBuffer(buffer, bufSize, strides, *encoding));
+}
+std::unique_ptr<IUserBuffer> IUserBufferFactory::createUserBuffer(void* buffer, size_t bufSize, const std::vector<size_t>& strides,
+                                                                  UserBufferEncoding* encoding, UserBufferSource*) noexcept
+{
+    return createUserBuffer(buffer, bufSize, strides, encoding);
+}
+
+Runtime_t RuntimeList::stringToRuntime(const char* s)
+{
+    std::string u(s ? s : "");
+    for(auto& c : u) c = char(std::tolower(static_cast<unsigned char>(c)));
+    if(u == "cpu" || u == "cpu_float32")  return Runtime_t::CPU;
+    if(u == "gpu" || u == "gpu_float32_16_hybrid") return Runtime_t::GPU;
+    if(u == "gpu_float16")                return Runtime_t::GPU_FLOAT16;
+    if(u == "dsp" || u == "dsp_fixed8_tf") return Runtime_t::DSP;
+    if(u == "aip" || u == "aip_fixed8_tf") return Runtime_t::AIP_FIXED8_TF;
+    return Runtime_t::UNSET;
+}
+const char* RuntimeList::runtimeToString(Runtime_t rt)
+{
+    switch(rt){
+        case Runtime_t::CPU:           return "cpu_float32";
+        case Runtime_t::GPU:           return "gpu_float32_16_hybrid";
+        case Runtime_t::GPU_FLOAT16:   return "gpu_float16";
+        case Runtime_t::DSP:           return "dsp_fixed8_tf";
+        case Runtime_t::AIP_FIXED8_TF: return "aip_fixed8_tf";
+        default:                       return "unset";
+    }
+}
+
+}  // namespace DlSystem
+
+/* container ------------------------------------------------------------------------ */
+namespace DlContainer {
+
+IDlContainer::IDlContainer(const std::string& path) : m_path(path)
+{
+    const size_t slash = path.find_last_of("/\\");
+    m_model = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    m_model = m_model.substr(0, m_model.rfind('.'));
+}
+std::unique_ptr<IDlContainer> IDlContainer::open(const std::string& path) noexcept
+{
+    if(::access(path.c_str(), R_OK) != 0){ DlSystem::setError("cannot read container "+path); return nullptr; }
+    return std::unique_ptr<IDlContainer>(new IDlContainer(path));
+}
+std::unique_ptr<IDlContainer> IDlContainer::open(const zdl::DlSystem::String& path) noexcept
+{
+    return open(std::string(path.c_str()));
+}
+
+}  // namespace DlContainer
+
+namespace SNPE {
+
+/* factory -------------------------------------------------------------------------- */
+bool SNPEFactory::isRuntimeAvailable(zdl::DlSystem::Runtime_t rt){ return standin::currentExecutor()->available(rt); }
+zdl::DlSystem::ITensorFactory& SNPEFactory::getTensorFactory(){ static zdl::DlSystem::ITensorFactory f; return f; }
+zdl::DlSystem::IUserBufferFactory& SNPEFactory::getUserBufferFactory(){ static zdl::DlSystem::IUserBufferFactory f; return f; }
+zdl::DlSystem::Version_t SNPEFactory::getLibraryVersion(){ return zdl::DlSystem::Version_t(); }
+bool SNPEFactory::initializeLogging(const zdl::DlSystem::LogLevel_t&){ return true; }
+bool SNPEFactory::initializeLogging(const zdl::DlSystem::LogLevel_t&, const std::string&){ return true; }
+bool SNPEFactory::setLogLevel(const zdl::DlSystem::LogLevel_t&){ return true; }
+bool SNPEFactory::terminateLogging(){ return true; }
+
+/* builder -------------------------------------------------------------------------- */
+std::unique_ptr<SNPE> SNPEBuilder::build() noexcept
+{
+    if(!m_container){ zdl::DlSystem::setError("no container"); return nullptr; }
+    zdl::DlSystem::RuntimeList order = m_rts;
+    if(order.empty()) order.add(zdl::DlSystem::Runtime_t::CPU);
+    auto exec = standin::currentExecutor();
+    for(size_t i = 0; i < order.size(); ++i){
+        standin::NetworkShape shape;
+        if(exec->available(order[i]) && exec->describe(m_container->model(), order[i], shape))
+            return std::unique_ptr<SNPE>(new SNPE(m_container->model(), order[i], m_userBuffers, shape, exec));
+    }
+    zdl::DlSystem::setError("no runtime of the order can run "+m_container->model());
+    return nullptr;
+}
+
+/* SNPE ----------------------------------------------------------------------------- */
+SNPE::SNPE(std::string model, zdl::DlSystem::Runtime_t rt, bool userBuffers,
+           standin::NetworkShape shape, std::shared_ptr<standin::Executor> exec)
+    : m_model(std::move(model)), m_rt(rt), m_userBuffers(userBuffers), m_shape(std::move(shape)), m_exec(std::move(exec))
+{
+    for(const auto& t : m_shape.inputs)  m_attr.emplace_back(new zdl::DlSystem::IBufferAttributes(t.second));
+    for(const auto& t : m_shape.outputs){
+        m_attr.emplace_back(new zdl::DlSystem::IBufferAttributes(t.second));
+        m_out.emplace_back(new zdl::DlSystem::ITensor(t.second));
+    }
+}
+SNPE::~SNPE() = default;
+
+zdl::DlSystem::Optional<zdl::DlSystem::StringList> SNPE::getInputTensorNames() const noexcept
+{
+    zdl::DlSystem::StringList l;
+    for(const auto& t : m_shape.inputs) l.append(t.first.c_str());
+    return l;
+}
+zdl::DlSystem::Optional<zdl::DlSystem::StringList> SNPE::getOutputTensorNames() const noexcept
+{
+    zdl::DlSystem::StringList l;
+    for(const auto& t : m_shape.outputs) l.append(t.first.c_str());
+    return l;
+}
+zdl::DlSystem::TensorShape SNPE::getInputDimensions() const noexcept
+{
+    return m_shape.inputs.front().second;
+}
+zdl::DlSystem::Optional<zdl::DlSystem::TensorShape> SNPE::getInputDimensions(const char* name) const noexcept
+{
+    for(const auto& t : m_shape.inputs) if(name && t.first == name) return t.second;
+    return zdl::DlSystem::Optional<zdl::DlSystem::TensorShape>();
+}
+zdl::DlSystem::Optional<zdl::DlSystem::IBufferAttributes*> SNPE::getInputOutputBufferAttributes(const char* name) const noexcept
+{
+    const size_t nIn = m_shape.inputs.size();
+    for(size_t i = 0; i < nIn; ++i)                   if(name && m_shape.inputs[i].first  == name) return m_attr[i].get();
+    for(size_t i = 0; i < m_shape.outputs.size(); ++i) if(name && m_shape.outputs[i].first == name) return m_attr[nIn + i].get();
+    return zdl::DlSystem::Optional<zdl::DlSystem::IBufferAttributes*>();
+}
+
+bool SNPE::run(standin::Call& call)
+{
+    if(!m_exec->execute(call)){ zdl::DlSystem::setError("execute failed on "+m_model); return false; }
+    return true;
+}
+
+static standin::Buffer floatBuffer(const char* name, const zdl::DlSystem::ITensor& t)
+{
+    return { name, const_cast<float*>(&*t.cbegin()), t.getSize()*sizeof(float), sizeof(float), 0, 1.0f };
+}
+
+bool SNPE::execute(const zdl::DlSystem::ITensor* input, zdl::DlSystem::TensorMap& output) noexcept
+{
+    if(m_userBuffers || !input || m_shape.inputs.size() != 1 || input->getSize() != m_shape.inputs[0].second.elements()){
+        zdl::DlSystem::setError("execute: expected one input tensor of the network's size");
+        return false;
+    }
+    standin::Call call{ m_model, m_rt, {}, {} };
+    call.inputs.push_back(floatBuffer(m_shape.inputs[0].first.c_str(), *input));
+    for(size_t i = 0; i < m_out.size(); ++i) call.outputs.push_back(floatBuffer(m_shape.outputs[i].first.c_str(), *m_out[i]));
+    if(!run(call)) return false;
+    for(size_t i = 0; i < m_out.size(); ++i) output.add(m_shape.outputs[i].first.c_str(), m_out[i].get());
+    return true;
+}
+
+bool SNPE::execute(const zdl::DlSystem::TensorMap& input, zdl::DlSystem::TensorMap& output) noexcept
+{
+    if(m_userBuffers){ zdl::DlSystem::setError("execute: built for user buffers"); return false; }
+    standin::Call call{ m_model, m_rt, {}, {} };
+    for(const auto& t : m_shape.inputs){
+        const zdl::DlSystem::ITensor* in = input.getTensor(t.first.c_str());
+        if(!in || in->getSize() != t.second.elements()){ zdl::DlSystem::setError("execute: input "+t.first+" missing or of the wrong size"); return false; }
+        call.inputs.push_back(floatBuffer(t.first.c_str(), *in));
+    }
+    for(size_t i = 0; i < m_out.size(); ++i) call.outputs.push_back(floatBuffer(m_shape.outputs[i].first.c_str(), *m_out[i]));
+    if(!run(call)) return false;
+    for(size_t i = 0; i < m_out.size(); ++i) output.add(m_shape.outputs[i].first.c_str(), m_out[i].get());
+    return true;
+}
+
+bool SNPE::execute(const zdl::DlSystem::UserBufferMap& input, const zdl::DlSystem::UserBufferMap& output) noexcept
+{
+    if(!m_userBuffers){ zdl::DlSystem::setError("execute: not built for user buffers"); return false; }
+    standin::Call call{ m_model, m_rt, {}, {} };
+    auto add = [&](const std::pair<std::string, zdl::DlSystem::TensorShape>& t, const zdl::DlSystem::UserBufferMap& m,
+                   std::vector<standin::Buffer>& to){
+        zdl::DlSystem::IUserBuffer* b = m.getUserBuffer(t.first.c_str());
+        if(!b || !b->address()) return false;
+        const zdl::DlSystem::UserBufferEncoding& e = b->getEncoding();
+        const size_t es = e.getElementSize();
+        if(b->getSize() < t.second.elements()*es) return false;
+        standin::Buffer sb{ t.first.c_str(), b->address(), t.second.elements()*es, es, 0, 1.0f };
+        if(auto tfn = dynamic_cast<const zdl::DlSystem::UserBufferEncodingTfN*>(&e)){
+            sb.step0 = tfn->getStepExactly0(); sb.stepSize = tfn->getQuantizedStepSize(); }
+        to.push_back(sb);
+        return true;
+    };
+    for(const auto& t : m_shape.inputs)
+        if(!add(t, input, call.inputs)){ zdl::DlSystem::setError("execute: user buffer "+t.first+" missing or too small"); return false; }
+    for(const auto& t : m_shape.outputs)
+        if(!add(t, output, call.outputs)){ zdl::DlSystem::setError("execute: user buffer "+t.first+" missing or too small"); return false; }
+    return run(call);
+}
+
+}  // namespace SNPE
+}  // namespace zdl